@@ -40,6 +40,12 @@
  * Requires `LV_COLOR_DEPTH = 32` colors and the screen's style should be modified: `style.body.opa = ...`*/
 #define LV_COLOR_SCREEN_TRANSP    0
 
+/* 1: Use premultiplied alpha with `LV_COLOR_SCREEN_TRANSP 1`.
+ * The display buffer and the `LV_IMG_CF_TRUE_COLOR_ALPHA` images store the colors multiplied by their alpha,
+ * so blending needs no division and the buffer can be passed to a compositor as premultiplied ARGB8888.
+ * The alpha byte of `LV_IMG_CF_TRUE_COLOR` images should be 0xFF. */
+#define LV_COLOR_PREMULT    0
+
 /*Images pixels with this color will not be drawn (with chroma keying)*/
 #define LV_COLOR_TRANSP    LV_COLOR_LIME         /*LV_COLOR_LIME: pure green*/
 
@@ -53,6 +59,20 @@
  * Can be changed in the display driver (`lv_disp_drv_t`).*/
 #define LV_DISP_DEF_REFR_PERIOD      30      /*[ms]*/
 
+/* 1: Refresh the displays in sync with their vertical blanking (vsync).
+ * The animations are evaluated and the screen is rendered once per vsync, only if something changed.
+ * If rendering is slow the frames are made every 2nd, 3rd... vsync to keep a steady frame rate.
+ * The display driver calls `lv_disp_vsync()` on vsync or it's simulated with `disp_drv.vsync_period`.*/
+#define LV_USE_VSYNC     0
+#if LV_USE_VSYNC
+/* Max. number of vsyncs a frame can take when the frame rate is reduced*/
+#  define LV_VSYNC_MAX_INTERVAL   4
+#endif
+
+/* Maximal number of display buffers (`buf1`, `buf2` and the ones added with `lv_disp_buf_add()`).
+ * With more buffers the rendering can go ahead while the previous parts are being flushed.*/
+#define LV_DISP_BUF_MAX_NUM      2
+
 /* Dot Per Inch: used to initialize default sizes.
  * E.g. a button with width = LV_DPI / 2 -> half inch wide
  * (Not so important, you can adjust it to modify default sizes and spaces)*/
@@ -145,6 +165,28 @@ typedef void * lv_anim_user_data_t;
 /* 1: Enable shadow drawing*/
 #define LV_USE_SHADOW           1
 
+/* 1: Cache the blurred corners of the shadows. The shadows with the same width, radius and
+ * similar size are drawn from the cache instead of blurring the corner again.*/
+#define LV_USE_SHADOW_CACHE     1
+#if LV_USE_SHADOW_CACHE
+/*Memory for the corners in bytes (~(width + radius)^2 bytes/corner, allocated with `lv_mem_alloc`).
+ * The least recently used corners are freed if it's not enough.*/
+#  define LV_SHADOW_CACHE_SIZE      (4 * 1024U)
+#endif  /*LV_USE_SHADOW_CACHE*/
+
+/* 1: Cache the color lines of the gradients by their colors, stops and length.
+ * The rectangles with the same gradient don't compute the colors again.*/
+#define LV_USE_GRAD_CACHE       1
+#if LV_USE_GRAD_CACHE
+/*Memory for the lines in bytes (`length * sizeof(lv_color_t)` bytes/line, allocated with `lv_mem_alloc`).
+ * The least recently used lines are freed if it's not enough.*/
+#  define LV_GRAD_CACHE_SIZE        (2 * 1024U)
+#endif  /*LV_USE_GRAD_CACHE*/
+
+/* 1: Dither the gradients with `LV_COLOR_DEPTH 16` to hide the color bands.
+ * It's applied when the color line of the gradient is created with an ordered pattern along the gradient.*/
+#define LV_GRAD_DITHER          0
+
 /* 1: Enable object groups (for keyboard/encoder navigation) */
 #define LV_USE_GROUP            1
 #if LV_USE_GROUP
@@ -154,6 +196,41 @@ typedef void * lv_group_user_data_t;
 /* 1: Enable GPU interface*/
 #define LV_USE_GPU              1
 
+/* 1: Blend the pixels with SIMD instructions if the compiler supports them
+ * (SSE2 or AVX2 on x86, NEON on ARM). AVX2 is used only if the CPU supports it.
+ * Works with 16 and 32 bit color depth.*/
+#define LV_USE_BLEND_SIMD       1
+
+/* 1: Cache the anti-aliased corners of the rounded rectangles by radius.
+ * Rounded corners are masked with a table lookup instead of computing the circle in every row.*/
+#define LV_USE_RADIUS_CACHE     1
+#if LV_USE_RADIUS_CACHE
+/*Memory for the corner tables in bytes (~radius^2 bytes/radius, allocated with `lv_mem_alloc`).
+ * The least recently used radii are freed if it's not enough.*/
+#  define LV_RADIUS_CACHE_SIZE      (2 * 1024U)
+#endif  /*LV_USE_RADIUS_CACHE*/
+
+/* 1: Record the drawing of rectangles, images, labels, lines and arcs into a queue
+ * and execute it band by band with the display driver's `draw_backend` (e.g. a GPU).
+ * The commands not supported by the backend are drawn by the CPU. See `lv_draw_backend.h`*/
+#define LV_USE_DRAW_BACKEND     0
+#if LV_USE_DRAW_BACKEND
+/*Max. number of recorded commands and size of their texts (in bytes) before executing them*/
+#  define LV_DRAW_BACKEND_CMD_NUM       32
+#  define LV_DRAW_BACKEND_TXT_SIZE      512
+#endif  /*LV_USE_DRAW_BACKEND*/
+
+/* 1: Render horizontal slices of the display buffer in parallel.
+ * The threads are managed by the display driver's `parallel_cb`.
+ * Requires a thread-safe memory allocator (`LV_MEM_CUSTOM 1`) and `LV_THREAD_LOCAL`.
+ * The lock is held only shortly and never taken again while held, so a plain (non-recursive) mutex is enough. */
+#define LV_USE_PARALLEL_DRAW    0
+#if LV_USE_PARALLEL_DRAW
+#define LV_PARALLEL_DRAW_INCLUDE    <pthread.h>     /*Header for the lock functions*/
+#define LV_PARALLEL_DRAW_LOCK()                     /*Lock a mutex. E.g. `pthread_mutex_lock(&lv_mutex)`*/
+#define LV_PARALLEL_DRAW_UNLOCK()                   /*Unlock the mutex. E.g. `pthread_mutex_unlock(&lv_mutex)`*/
+#endif  /*LV_USE_PARALLEL_DRAW*/
+
 /* 1: Enable file system (might be required for images */
 #define LV_USE_FILESYSTEM       1
 #if LV_USE_FILESYSTEM
@@ -174,6 +251,10 @@ typedef void * lv_fs_drv_user_data_t;
 /* 1: Enable alpha indexed images */
 #define LV_IMG_CF_ALPHA         1
 
+/* 1: Enable RLE compressed true color images (`LV_IMG_CF_RLE_TRUE_COLOR...`).
+ * Only the rows being drawn are decompressed. Convert the images with `scripts/img_rle_conv.py`*/
+#define LV_IMG_CF_RLE           1
+
 /* Default image cache size. Image caching keeps the images opened.
  * If only the built-in image formats are used there is no real advantage of caching.
  * (I.e. no new image decoder is added)
@@ -182,6 +263,33 @@ typedef void * lv_fs_drv_user_data_t;
  * LV_IMG_CACHE_DEF_SIZE must be >= 1 */
 #define LV_IMG_CACHE_DEF_SIZE       1
 
+/* Max. size of the decoded images in the image cache in bytes (`width * height * pixel size`).
+ * The images which use the data of an `lv_img_dsc_t` variable directly or are read line by line don't count.
+ * The least recently used images are closed if it's not enough.
+ * 0: no limit, only the number of images (`LV_IMG_CACHE_DEF_SIZE`) is limited*/
+#define LV_IMG_CACHE_MEM_SIZE       0
+
+/* 1: Don't wait for slow images (files, indexed, compressed and custom formats) while rendering.
+ * They are opened on a worker thread of the application which calls `lv_img_cache_async_work()`
+ * and nothing is drawn in their place until then.
+ * Requires `LV_USE_PARALLEL_DRAW` (for its lock and thread-safe allocator), and thread-safe decoders and file system drivers.
+ * `LV_IMG_CACHE_DEF_SIZE` should be large enough to keep the visible images opened.*/
+#define LV_IMG_CACHE_ASYNC          0
+#if LV_IMG_CACHE_ASYNC
+/* Let the worker thread run while `lv_img_cache_invalidate_src()` waits for it to open an `lv_img_dsc_t` variable.
+ * Called without the lock. E.g. `sched_yield()` (visible with `<pthread.h>`) or a short sleep*/
+#define LV_IMG_CACHE_ASYNC_WAIT()   sched_yield()
+#endif  /*LV_IMG_CACHE_ASYNC*/
+
+/* 1: The built-in decoder converts the images to the native color format when they are opened,
+ * and the image cache keeps them in this form:
+ * - the files are read into the memory once
+ * - the indexed images are converted to `LV_IMG_CF_TRUE_COLOR_ALPHA` (`w * h * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes)
+ * - the RLE compressed images are decompressed
+ * - the alpha only images stay in their format because their color is set in the style
+ * Requires more memory but the images are not read and decoded line by line on every draw.*/
+#define LV_IMG_DECODE_TO_NATIVE     0
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_img_decoder_user_data_t;
 
@@ -203,6 +311,18 @@ typedef void * lv_img_decoder_user_data_t;
  * font's bitmaps */
 #define LV_ATTRIBUTE_LARGE_CONST
 
+/* Storage class of the drawing state which has to be separate for every thread
+ * with `LV_USE_PARALLEL_DRAW`. E.g. `__thread` or `_Thread_local` */
+#define LV_THREAD_LOCAL
+
+/* Atomically set an `uint8_t` (`*p = v`) and return its old value.
+ * The refresher and `lv_disp_flush_ready()` (called from an interrupt or an other thread)
+ * use it to start the next flush only once.
+ * Can be left undefined if `lv_disp_flush_ready()` is called only from `flush_cb` or `lv_task_handler()`'s thread.*/
+#if defined(__GNUC__)
+#define LV_ATOMIC_XCHG_U8(p, v)     __atomic_exchange_n((p), (v), __ATOMIC_SEQ_CST)
+#endif
+
 /* Export integer constant to binding.
  * This macro is used with constants in the form of LV_<CONST> that
  * should also appear on lvgl binding API such as Micropython
@@ -247,6 +367,26 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
 #  define LV_LOG_PRINTF   0
 #endif  /*LV_USE_LOG*/
 
+/*=====================
+ * Profiler settings
+ *====================*/
+
+/* 1: Measure the phases of refreshing (area joining, drawing the objects by type, flush waiting)
+ * and count the blended pixels and mask evaluations of every frame.
+ * The events are stored in a ring buffer and can be printed as Chrome trace JSON with `lv_profiler_dump`*/
+#define LV_USE_PROFILER     0
+#if LV_USE_PROFILER
+#  define LV_PROFILER_BUF_SIZE    1024    /*Number of events in the ring buffer of a thread*/
+
+/* Number of threads with an own ring buffer when `LV_USE_PARALLEL_DRAW` is enabled.
+ * The events of further threads are dropped.*/
+#  define LV_PROFILER_THREAD_MAX  4
+
+/* Expression evaluating to the current time in microseconds.
+ * A header for it can be included with `LV_PROFILER_INCLUDE`*/
+#  define LV_PROFILER_TIME_EXPR   (lv_tick_get() * 1000)
+#endif  /*LV_USE_PROFILER*/
+
 /*=================
  * Debug settings
  *================*/
@@ -414,6 +554,26 @@ typedef void * lv_obj_user_data_t;
  */
 #define LV_USE_EXT_CLICK_AREA  LV_EXT_CLICK_AREA_OFF
 
+/* 1: Keep a spatial index about the children of the objects which have many children.
+ * It makes refreshing and finding the clicked object faster with hundreds of children
+ * (e.g. long lists) but needs some extra memory (~16 bytes/child) */
+#define LV_USE_OBJ_INDEX        0
+#if LV_USE_OBJ_INDEX
+/*Create an index only for objects with at least this many children*/
+#  define LV_OBJ_INDEX_MIN_CHILD    32
+#endif
+
+/* 1: Objects can be marked with `lv_obj_set_layer_cache` to render them (with their children) only once
+ * into a buffer and redraw them from there until they or their children change.
+ * The buffers have alpha channel with `LV_COLOR_DEPTH 32` and `LV_COLOR_SCREEN_TRANSP 1`.
+ * Else only objects which fully cover their area (no radius, shadow or transparency) are cached.*/
+#define LV_USE_LAYER_CACHE      0
+#if LV_USE_LAYER_CACHE
+/*Memory for the cached layers in bytes (allocated with `lv_mem_alloc`, so keep `LV_MEM_SIZE` large enough).
+ * The least recently used layers are freed if it's not enough.*/
+#  define LV_LAYER_CACHE_SIZE       (64 * 1024U)
+#endif
+
 /*==================
  *  LV OBJ X USAGE
  *================*/
@@ -18,6 +18,7 @@ extern "C" {
 #include "src/lv_misc/lv_task.h"
 #include "src/lv_misc/lv_math.h"
 #include "src/lv_misc/lv_async.h"
+#include "src/lv_misc/lv_profiler.h"
 
 #include "src/lv_hal/lv_hal.h"
 
@@ -72,6 +73,7 @@ extern "C" {
 #include "src/lv_objx/lv_spinbox.h"
 
 #include "src/lv_draw/lv_img_cache.h"
+#include "src/lv_draw/lv_draw_backend.h"
 
 #include "src/lv_api_map.h"
 
@@ -25,6 +25,11 @@
 static void disp_init(void);
 
 static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void disp_wait(lv_disp_drv_t * disp_drv);
+#if LV_USE_PARALLEL_DRAW
+static void disp_parallel(lv_disp_drv_t * disp_drv, void (*job_cb)(const lv_area_t * slice),
+                          const lv_area_t * slices, uint16_t slice_cnt);
+#endif
 #if LV_USE_GPU
 static void gpu_blend(lv_disp_drv_t * disp_drv, lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
 static void gpu_fill(lv_disp_drv_t * disp_drv, lv_color_t * dest_buf, lv_coord_t dest_width,
@@ -70,6 +75,13 @@ void lv_port_disp_init(void)
      *      Similar to 2) but the buffer have to be screen sized. When LittlevGL is ready it will give the
      *      whole frame to display. This way you only need to change the frame buffer's address instead of
      *      copying the pixels.
+     *
+     * With 2) more buffers can be added with `lv_disp_buf_add()` (see `LV_DISP_BUF_MAX_NUM` in lv_conf.h).
+     * Then more rendered parts can wait for flushing while LittlevGL is drawing the next one.
+     *
+     * With 3) more screen sized buffers can be added too (e.g. triple buffering). LittlevGL redraws
+     * the areas changed since a buffer was last rendered so the buffers need no copying.
+     * If the buffers are managed by the display (e.g. EGL) tell their age in `disp_drv.buf_age_cb`.
      * */
 
     /* Example for 1) */
@@ -109,6 +121,15 @@ void lv_port_disp_init(void)
     /*Set a display buffer*/
     disp_drv.buffer = &disp_buf_2;
 
+    /*Optionally sleep or yield while waiting for the flushing instead of busy waiting*/
+    disp_drv.wait_cb = disp_wait;
+
+#if LV_USE_VSYNC
+    /*Call `lv_disp_vsync()` on vertical blanking, or leave `vsync_ext = 0` to simulate vsync*/
+    disp_drv.vsync_ext = 1;
+    disp_drv.vsync_period = 16;     /*Refresh period of the display [ms]*/
+#endif
+
 #if LV_USE_GPU
     /*Optionally add functions to access the GPU. (Only in buffered mode, LV_VDB_SIZE != 0)*/
 
@@ -119,6 +140,12 @@ void lv_port_disp_init(void)
     disp_drv.gpu_fill_cb = gpu_fill;
 #endif
 
+#if LV_USE_PARALLEL_DRAW
+    /*Optionally render horizontal slices of the buffer on more threads*/
+    disp_drv.parallel_cb = disp_parallel;
+    disp_drv.slice_cnt = 4;
+#endif
+
     /*Finally register the driver*/
     lv_disp_drv_register(&disp_drv);
 }
@@ -155,6 +182,27 @@ static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_colo
     lv_disp_flush_ready(disp_drv);
 }
 
+/* Called while LittlevGL waits for 'lv_disp_flush_ready()'.
+ * E.g. wait for the DMA's interrupt or yield the task to not keep the CPU busy. */
+static void disp_wait(lv_disp_drv_t * disp_drv)
+{
+    /*You code here*/
+}
+
+#if LV_USE_PARALLEL_DRAW
+/* Call 'job_cb' for every slice on different threads (e.g. with a thread pool)
+ * and return only when all of them are ready. */
+static void disp_parallel(lv_disp_drv_t * disp_drv, void (*job_cb)(const lv_area_t * slice),
+                          const lv_area_t * slices, uint16_t slice_cnt)
+{
+    /*It's an example code which should be done by your threads*/
+    uint16_t i;
+    for(i = 0; i < slice_cnt; i++) {
+        job_cb(&slices[i]);
+    }
+}
+#endif
+
 
 /*OPTIONAL: GPU INTERFACE*/
 #if LV_USE_GPU
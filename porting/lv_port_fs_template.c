@@ -48,6 +48,7 @@ static lv_fs_res_t fs_read (lv_fs_drv_t * drv, void * file_p, void * buf, uint32
 static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
 static lv_fs_res_t fs_seek (lv_fs_drv_t * drv, void * file_p, uint32_t pos);
 static lv_fs_res_t fs_size (lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+static lv_fs_res_t fs_map (lv_fs_drv_t * drv, void * file_p, const void ** buf_p, uint32_t * size_p);
 static lv_fs_res_t fs_tell (lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
 static lv_fs_res_t fs_remove (lv_fs_drv_t * drv, const char *path);
 static lv_fs_res_t fs_trunc (lv_fs_drv_t * drv, void * file_p);
@@ -99,6 +100,7 @@ void lv_port_fs_init(void)
     fs_drv.tell_cb = fs_tell;
     fs_drv.free_space_cb = fs_free;
     fs_drv.size_cb = fs_size;
+    fs_drv.map_cb = fs_map;
     fs_drv.remove_cb = fs_remove;
     fs_drv.rename_cb = fs_rename;
     fs_drv.trunc_cb = fs_trunc;
@@ -243,6 +245,25 @@ static lv_fs_res_t fs_size (lv_fs_drv_t * drv, void * file_p, uint32_t * size_p)
 
     return res;
 }
+
+/**
+ * Give the content of a file in the memory without copying it.
+ * Optional: the images are read with `fs_read` if not implemented.
+ * E.g. `mmap()` the file in `fs_open` or here and `munmap()` it in `fs_close`.
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a file_t variable
+ * @param buf_p pointer to store the address of the content
+ * @param size_p pointer to store the size of the content
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_map (lv_fs_drv_t * drv, void * file_p, const void ** buf_p, uint32_t * size_p)
+{
+    lv_fs_res_t res = LV_FS_RES_NOT_IMP;
+
+    /* Add your code here*/
+
+    return res;
+}
 /**
  * Give the position of the read write pointer
  * @param drv pointer to a driver where this function belongs
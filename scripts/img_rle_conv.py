@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+
+'''
+Compress a true color LittlevGL image (.bin file) to the RLE compressed color formats
+(LV_IMG_CF_RLE_TRUE_COLOR, LV_IMG_CF_RLE_TRUE_COLOR_ALPHA, LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED).
+
+The input is a binary image created by the image converter with a true color format
+and the same color depth as LV_COLOR_DEPTH.
+The output is a .bin file or a C file with an `lv_img_dsc_t` variable.
+
+Layout of the compressed data (after the 4 byte header):
+  - row index: (height + 1) little endian uint32 offsets of the rows, relative to the end of the index.
+    The last item is the size of all the rows.
+  - rows: every row is a series of packets. The first byte of a packet is:
+      0x80 | (n - 1): a run, followed by 1 pixel repeated n times
+      n - 1:          literals, followed by n pixels
+    (1 <= n <= 128)
+
+Usage:
+  ./img_rle_conv.py --color-depth 16 img.bin img_rle.bin
+  ./img_rle_conv.py --color-depth 16 --c-name my_img img.bin my_img.c
+'''
+
+import argparse
+import os
+import struct
+import sys
+
+CF_TRUE_COLOR = 4
+CF_TRUE_COLOR_ALPHA = 5
+CF_TRUE_COLOR_CHROMA_KEYED = 6
+CF_RLE_TRUE_COLOR = 15
+
+CF_NAMES = {
+  CF_RLE_TRUE_COLOR + 0: 'LV_IMG_CF_RLE_TRUE_COLOR',
+  CF_RLE_TRUE_COLOR + 1: 'LV_IMG_CF_RLE_TRUE_COLOR_ALPHA',
+  CF_RLE_TRUE_COLOR + 2: 'LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED',
+}
+
+MIN_RUN = 3     # Shorter runs are stored as literals
+MAX_PACKET = 128
+
+
+def get_px_size(cf, color_depth):
+  px_size = 1 if color_depth == 1 else color_depth // 8
+  # The 32 bit colors already have an alpha byte (LV_IMG_PX_SIZE_ALPHA_BYTE)
+  if cf == CF_TRUE_COLOR_ALPHA and color_depth != 32:
+    px_size += 1
+  return px_size
+
+
+def compress_row(px):
+  out = bytearray()
+  lit = []
+
+  def flush_literals():
+    while lit:
+      chunk = lit[:MAX_PACKET]
+      del lit[:MAX_PACKET]
+      out.append(len(chunk) - 1)
+      for p in chunk:
+        out.extend(p)
+
+  i = 0
+  while i < len(px):
+    run = 1
+    while i + run < len(px) and run < MAX_PACKET and px[i + run] == px[i]:
+      run += 1
+
+    if run >= MIN_RUN:
+      flush_literals()
+      out.append(0x80 | (run - 1))
+      out.extend(px[i])
+      i += run
+    else:
+      lit.append(px[i])
+      i += 1
+
+  flush_literals()
+  return out
+
+
+def compress(header, data, color_depth):
+  cf = header & 0x1F
+  w = (header >> 10) & 0x7FF
+  h = (header >> 21) & 0x7FF
+
+  if cf not in (CF_TRUE_COLOR, CF_TRUE_COLOR_ALPHA, CF_TRUE_COLOR_CHROMA_KEYED):
+    sys.exit('Only the true color formats can be compressed (cf = %d)' % cf)
+
+  px_size = get_px_size(cf, color_depth)
+  if len(data) < w * h * px_size:
+    sys.exit('The image data is too short. Is the color depth correct?')
+
+  rows = []
+  for y in range(h):
+    line = data[y * w * px_size:(y + 1) * w * px_size]
+    px = [bytes(line[x * px_size:(x + 1) * px_size]) for x in range(w)]
+    rows.append(compress_row(px))
+
+  index = bytearray()
+  ofs = 0
+  for r in rows:
+    index += struct.pack('<I', ofs)
+    ofs += len(r)
+  index += struct.pack('<I', ofs)
+
+  rle_cf = cf - CF_TRUE_COLOR + CF_RLE_TRUE_COLOR
+  header = (header & ~0x1F) | rle_cf
+  return header, rle_cf, w, h, bytes(index + b''.join(rows))
+
+
+def write_c(path, name, rle_cf, w, h, data):
+  with open(path, 'w') as fout:
+    fout.write('#include "lvgl/lvgl.h"\n\n')
+    fout.write('const uint8_t %s_map[] = {\n' % name)
+    for i in range(0, len(data), 16):
+      fout.write('  ' + ', '.join('0x%02x' % b for b in data[i:i + 16]) + ',\n')
+    fout.write('};\n\n')
+    fout.write('const lv_img_dsc_t %s = {\n' % name)
+    fout.write('  .header.always_zero = 0,\n')
+    fout.write('  .header.w = %d,\n' % w)
+    fout.write('  .header.h = %d,\n' % h)
+    fout.write('  .data_size = %d,\n' % len(data))
+    fout.write('  .header.cf = %s,\n' % CF_NAMES[rle_cf])
+    fout.write('  .data = %s_map,\n' % name)
+    fout.write('};\n')
+
+
+def main():
+  parser = argparse.ArgumentParser(description='Compress a true color LittlevGL image with RLE')
+  parser.add_argument('--color-depth', type=int, choices=[1, 8, 16, 32], required=True,
+                      help='LV_COLOR_DEPTH the image was converted with')
+  parser.add_argument('--c-name', help='write a C file with an lv_img_dsc_t variable with this name')
+  parser.add_argument('input', help='true color .bin image')
+  parser.add_argument('output', help='compressed .bin or .c file')
+  args = parser.parse_args()
+
+  with open(args.input, 'rb') as fin:
+    raw = fin.read()
+
+  header, = struct.unpack('<I', raw[:4])
+  header, rle_cf, w, h, data = compress(header, raw[4:], args.color_depth)
+
+  if args.c_name:
+    write_c(args.output, args.c_name, rle_cf, w, h, data)
+  else:
+    with open(args.output, 'wb') as fout:
+      fout.write(struct.pack('<I', header))
+      fout.write(data)
+
+  print('%s: %dx%d, %d -> %d bytes (%.1fx)' % (os.path.basename(args.input), w, h, len(raw) - 4, len(data),
+                                             (len(raw) - 4) / max(len(data), 1)))
+
+
+if __name__ == '__main__':
+  main()
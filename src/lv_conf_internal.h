@@ -57,6 +57,14 @@
 #define LV_COLOR_SCREEN_TRANSP    0
 #endif
 
+/* 1: Use premultiplied alpha with `LV_COLOR_SCREEN_TRANSP 1`.
+ * The display buffer and the `LV_IMG_CF_TRUE_COLOR_ALPHA` images store the colors multiplied by their alpha,
+ * so blending needs no division and the buffer can be passed to a compositor as premultiplied ARGB8888.
+ * The alpha byte of `LV_IMG_CF_TRUE_COLOR` images should be 0xFF. */
+#ifndef LV_COLOR_PREMULT
+#define LV_COLOR_PREMULT    0
+#endif
+
 /*Images pixels with this color will not be drawn (with chroma keying)*/
 #ifndef LV_COLOR_TRANSP
 #define LV_COLOR_TRANSP    LV_COLOR_LIME         /*LV_COLOR_LIME: pure green*/
@@ -78,6 +86,26 @@
 #define LV_DISP_DEF_REFR_PERIOD      30      /*[ms]*/
 #endif
 
+/* 1: Refresh the displays in sync with their vertical blanking (vsync).
+ * The animations are evaluated and the screen is rendered once per vsync, only if something changed.
+ * If rendering is slow the frames are made every 2nd, 3rd... vsync to keep a steady frame rate.
+ * The display driver calls `lv_disp_vsync()` on vsync or it's simulated with `disp_drv.vsync_period`.*/
+#ifndef LV_USE_VSYNC
+#define LV_USE_VSYNC     0
+#endif
+#if LV_USE_VSYNC
+/* Max. number of vsyncs a frame can take when the frame rate is reduced*/
+#ifndef LV_VSYNC_MAX_INTERVAL
+#define LV_VSYNC_MAX_INTERVAL   4
+#endif
+#endif  /*LV_USE_VSYNC*/
+
+/* Maximal number of display buffers (`buf1`, `buf2` and the ones added with `lv_disp_buf_add()`).
+ * With more buffers the rendering can go ahead while the previous parts are being flushed.*/
+#ifndef LV_DISP_BUF_MAX_NUM
+#define LV_DISP_BUF_MAX_NUM      2
+#endif
+
 /* Dot Per Inch: used to initialize default sizes.
  * E.g. a button with width = LV_DPI / 2 -> half inch wide
  * (Not so important, you can adjust it to modify default sizes and spaces)*/
@@ -212,6 +240,38 @@
 #define LV_USE_SHADOW           1
 #endif
 
+/* 1: Cache the blurred corners of the shadows. The shadows with the same width, radius and
+ * similar size are drawn from the cache instead of blurring the corner again.*/
+#ifndef LV_USE_SHADOW_CACHE
+#define LV_USE_SHADOW_CACHE     1
+#endif
+#if LV_USE_SHADOW_CACHE
+/*Memory for the corners in bytes (~(width + radius)^2 bytes/corner, allocated with `lv_mem_alloc`).
+ * The least recently used corners are freed if it's not enough.*/
+#ifndef LV_SHADOW_CACHE_SIZE
+#  define LV_SHADOW_CACHE_SIZE      (4 * 1024U)
+#endif
+#endif  /*LV_USE_SHADOW_CACHE*/
+
+/* 1: Cache the color lines of the gradients by their colors, stops and length.
+ * The rectangles with the same gradient don't compute the colors again.*/
+#ifndef LV_USE_GRAD_CACHE
+#define LV_USE_GRAD_CACHE       1
+#endif
+#if LV_USE_GRAD_CACHE
+/*Memory for the lines in bytes (`length * sizeof(lv_color_t)` bytes/line, allocated with `lv_mem_alloc`).
+ * The least recently used lines are freed if it's not enough.*/
+#ifndef LV_GRAD_CACHE_SIZE
+#  define LV_GRAD_CACHE_SIZE        (2 * 1024U)
+#endif
+#endif  /*LV_USE_GRAD_CACHE*/
+
+/* 1: Dither the gradients with `LV_COLOR_DEPTH 16` to hide the color bands.
+ * It's applied when the color line of the gradient is created with an ordered pattern along the gradient.*/
+#ifndef LV_GRAD_DITHER
+#define LV_GRAD_DITHER          0
+#endif
+
 /* 1: Enable object groups (for keyboard/encoder navigation) */
 #ifndef LV_USE_GROUP
 #define LV_USE_GROUP            1
@@ -224,6 +284,61 @@
 #define LV_USE_GPU              1
 #endif
 
+/* 1: Blend the pixels with SIMD instructions if the compiler supports them
+ * (SSE2 or AVX2 on x86, NEON on ARM). AVX2 is used only if the CPU supports it.
+ * Works with 16 and 32 bit color depth.*/
+#ifndef LV_USE_BLEND_SIMD
+#define LV_USE_BLEND_SIMD       1
+#endif
+
+/* 1: Cache the anti-aliased corners of the rounded rectangles by radius.
+ * Rounded corners are masked with a table lookup instead of computing the circle in every row.*/
+#ifndef LV_USE_RADIUS_CACHE
+#define LV_USE_RADIUS_CACHE     1
+#endif
+#if LV_USE_RADIUS_CACHE
+/*Memory for the corner tables in bytes (~radius^2 bytes/radius, allocated with `lv_mem_alloc`).
+ * The least recently used radii are freed if it's not enough.*/
+#ifndef LV_RADIUS_CACHE_SIZE
+#  define LV_RADIUS_CACHE_SIZE      (2 * 1024U)
+#endif
+#endif  /*LV_USE_RADIUS_CACHE*/
+
+/* 1: Record the drawing of rectangles, images, labels, lines and arcs into a queue
+ * and execute it band by band with the display driver's `draw_backend` (e.g. a GPU).
+ * The commands not supported by the backend are drawn by the CPU. See `lv_draw_backend.h`*/
+#ifndef LV_USE_DRAW_BACKEND
+#define LV_USE_DRAW_BACKEND     0
+#endif
+#if LV_USE_DRAW_BACKEND
+/*Max. number of recorded commands and size of their texts (in bytes) before executing them*/
+#ifndef LV_DRAW_BACKEND_CMD_NUM
+#  define LV_DRAW_BACKEND_CMD_NUM       32
+#endif
+#ifndef LV_DRAW_BACKEND_TXT_SIZE
+#  define LV_DRAW_BACKEND_TXT_SIZE      512
+#endif
+#endif  /*LV_USE_DRAW_BACKEND*/
+
+/* 1: Render horizontal slices of the display buffer in parallel.
+ * The threads are managed by the display driver's `parallel_cb`.
+ * Requires a thread-safe memory allocator (`LV_MEM_CUSTOM 1`) and `LV_THREAD_LOCAL`.
+ * The lock is held only shortly and never taken again while held, so a plain (non-recursive) mutex is enough. */
+#ifndef LV_USE_PARALLEL_DRAW
+#define LV_USE_PARALLEL_DRAW    0
+#endif
+#if LV_USE_PARALLEL_DRAW
+#ifndef LV_PARALLEL_DRAW_INCLUDE
+#define LV_PARALLEL_DRAW_INCLUDE    <pthread.h>     /*Header for the lock functions*/
+#endif
+#ifndef LV_PARALLEL_DRAW_LOCK
+#define LV_PARALLEL_DRAW_LOCK()                     /*Lock a mutex. E.g. `pthread_mutex_lock(&lv_mutex)`*/
+#endif
+#ifndef LV_PARALLEL_DRAW_UNLOCK
+#define LV_PARALLEL_DRAW_UNLOCK()                   /*Unlock the mutex. E.g. `pthread_mutex_unlock(&lv_mutex)`*/
+#endif
+#endif  /*LV_USE_PARALLEL_DRAW*/
+
 /* 1: Enable file system (might be required for images */
 #ifndef LV_USE_FILESYSTEM
 #define LV_USE_FILESYSTEM       1
@@ -241,6 +356,12 @@
  * Image decoder and cache
  *========================*/
 
+/* 1: Enable RLE compressed true color images (`LV_IMG_CF_RLE_TRUE_COLOR...`).
+ * Only the rows being drawn are decompressed. Convert the images with `scripts/img_rle_conv.py`*/
+#ifndef LV_IMG_CF_RLE
+#define LV_IMG_CF_RLE           1
+#endif
+
 /* Default image cache size. Image caching keeps the images opened.
  * If only the built-in image formats are used there is no real advantage of caching.
  * (I.e. no new image decoder is added)
@@ -251,6 +372,41 @@
 #define LV_IMG_CACHE_DEF_SIZE       1
 #endif
 
+/* Max. size of the decoded images in the image cache in bytes (`width * height * pixel size`).
+ * The images which use the data of an `lv_img_dsc_t` variable directly or are read line by line don't count.
+ * The least recently used images are closed if it's not enough.
+ * 0: no limit, only the number of images (`LV_IMG_CACHE_DEF_SIZE`) is limited*/
+#ifndef LV_IMG_CACHE_MEM_SIZE
+#define LV_IMG_CACHE_MEM_SIZE       0
+#endif
+
+/* 1: Don't wait for slow images (files, indexed, compressed and custom formats) while rendering.
+ * They are opened on a worker thread of the application which calls `lv_img_cache_async_work()`
+ * and nothing is drawn in their place until then.
+ * Requires `LV_USE_PARALLEL_DRAW` (for its lock and thread-safe allocator), and thread-safe decoders and file system drivers.
+ * `LV_IMG_CACHE_DEF_SIZE` should be large enough to keep the visible images opened.*/
+#ifndef LV_IMG_CACHE_ASYNC
+#define LV_IMG_CACHE_ASYNC          0
+#endif
+#if LV_IMG_CACHE_ASYNC
+/* Let the worker thread run while `lv_img_cache_invalidate_src()` waits for it to open an `lv_img_dsc_t` variable.
+ * Called without the lock. E.g. `sched_yield()` (visible with `<pthread.h>`) or a short sleep*/
+#ifndef LV_IMG_CACHE_ASYNC_WAIT
+#define LV_IMG_CACHE_ASYNC_WAIT()   sched_yield()
+#endif
+#endif  /*LV_IMG_CACHE_ASYNC*/
+
+/* 1: The built-in decoder converts the images to the native color format when they are opened,
+ * and the image cache keeps them in this form:
+ * - the files are read into the memory once
+ * - the indexed images are converted to `LV_IMG_CF_TRUE_COLOR_ALPHA` (`w * h * LV_IMG_PX_SIZE_ALPHA_BYTE` bytes)
+ * - the RLE compressed images are decompressed
+ * - the alpha only images stay in their format because their color is set in the style
+ * Requires more memory but the images are not read and decoded line by line on every draw.*/
+#ifndef LV_IMG_DECODE_TO_NATIVE
+#define LV_IMG_DECODE_TO_NATIVE     0
+#endif
+
 /*Declare the type of the user data of image decoder (can be e.g. `void *`, `int`, `struct`)*/
 
 /*=====================
@@ -279,6 +435,22 @@
 #define LV_ATTRIBUTE_LARGE_CONST
 #endif
 
+/* Storage class of the drawing state which has to be separate for every thread
+ * with `LV_USE_PARALLEL_DRAW`. E.g. `__thread` or `_Thread_local` */
+#ifndef LV_THREAD_LOCAL
+#define LV_THREAD_LOCAL
+#endif
+
+/* Atomically set an `uint8_t` (`*p = v`) and return its old value.
+ * The refresher and `lv_disp_flush_ready()` (called from an interrupt or an other thread)
+ * use it to start the next flush only once.
+ * Can be left undefined if `lv_disp_flush_ready()` is called only from `flush_cb` or `lv_task_handler()`'s thread.*/
+#ifndef LV_ATOMIC_XCHG_U8
+#if defined(__GNUC__)
+#define LV_ATOMIC_XCHG_U8(p, v)     __atomic_exchange_n((p), (v), __ATOMIC_SEQ_CST)
+#endif
+#endif
+
 /* Export integer constant to binding.
  * This macro is used with constants in the form of LV_<CONST> that
  * should also appear on lvgl binding API such as Micropython
@@ -335,6 +507,34 @@
 #endif
 #endif  /*LV_USE_LOG*/
 
+/*=====================
+ * Profiler settings
+ *====================*/
+
+/* 1: Measure the phases of refreshing (area joining, drawing the objects by type, flush waiting)
+ * and count the blended pixels and mask evaluations of every frame.
+ * The events are stored in a ring buffer and can be printed as Chrome trace JSON with `lv_profiler_dump`*/
+#ifndef LV_USE_PROFILER
+#define LV_USE_PROFILER     0
+#endif
+#if LV_USE_PROFILER
+#ifndef LV_PROFILER_BUF_SIZE
+#  define LV_PROFILER_BUF_SIZE    1024    /*Number of events in the ring buffer of a thread*/
+#endif
+
+/* Number of threads with an own ring buffer when `LV_USE_PARALLEL_DRAW` is enabled.
+ * The events of further threads are dropped.*/
+#ifndef LV_PROFILER_THREAD_MAX
+#  define LV_PROFILER_THREAD_MAX  4
+#endif
+
+/* Expression evaluating to the current time in microseconds.
+ * A header for it can be included with `LV_PROFILER_INCLUDE`*/
+#ifndef LV_PROFILER_TIME_EXPR
+#  define LV_PROFILER_TIME_EXPR   (lv_tick_get() * 1000)
+#endif
+#endif  /*LV_USE_PROFILER*/
+
 /*=================
  * Debug settings
  *================*/
@@ -580,6 +780,34 @@
 #define LV_USE_EXT_CLICK_AREA  LV_EXT_CLICK_AREA_OFF
 #endif
 
+/* 1: Keep a spatial index about the children of the objects which have many children.
+ * It makes refreshing and finding the clicked object faster with hundreds of children
+ * (e.g. long lists) but needs some extra memory (~16 bytes/child) */
+#ifndef LV_USE_OBJ_INDEX
+#define LV_USE_OBJ_INDEX        0
+#endif
+#if LV_USE_OBJ_INDEX
+/*Create an index only for objects with at least this many children*/
+#ifndef LV_OBJ_INDEX_MIN_CHILD
+#  define LV_OBJ_INDEX_MIN_CHILD    32
+#endif
+#endif
+
+/* 1: Objects can be marked with `lv_obj_set_layer_cache` to render them (with their children) only once
+ * into a buffer and redraw them from there until they or their children change.
+ * The buffers have alpha channel with `LV_COLOR_DEPTH 32` and `LV_COLOR_SCREEN_TRANSP 1`.
+ * Else only objects which fully cover their area (no radius, shadow or transparency) are cached.*/
+#ifndef LV_USE_LAYER_CACHE
+#define LV_USE_LAYER_CACHE      0
+#endif
+#if LV_USE_LAYER_CACHE
+/*Memory for the cached layers in bytes (allocated with `lv_mem_alloc`, so keep `LV_MEM_SIZE` large enough).
+ * The least recently used layers are freed if it's not enough.*/
+#ifndef LV_LAYER_CACHE_SIZE
+#  define LV_LAYER_CACHE_SIZE       (64 * 1024U)
+#endif
+#endif
+
 /*==================
  *  LV OBJ X USAGE
  *================*/
@@ -2,6 +2,8 @@ CSRCS += lv_group.c
 CSRCS += lv_indev.c
 CSRCS += lv_disp.c
 CSRCS += lv_obj.c
+CSRCS += lv_obj_index.c
+CSRCS += lv_layer_cache.c
 CSRCS += lv_refr.c
 CSRCS += lv_style.c
 CSRCS += lv_debug.c
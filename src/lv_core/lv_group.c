@@ -395,19 +395,28 @@ void lv_group_set_wrap(lv_group_t * group, bool en)
  * Modify a style with the set 'style_mod' function. The input style remains unchanged.
  * @param group pointer to group
  * @param style pointer to a style to modify
- * @return a copy of the input style but modified with the 'style_mod' function
+ * @return a copy of the input style but modified with the 'style_mod' function.
+ *         It's overwritten by the next call (in the same thread with `LV_USE_PARALLEL_DRAW`)
  */
 lv_style_t * lv_group_mod_style(lv_group_t * group, const lv_style_t * style)
 {
+#if LV_USE_PARALLEL_DRAW
+    /*The drawing threads modify their own copy*/
+    static LV_THREAD_LOCAL lv_style_t style_tmp;
+    lv_style_t * style_mod = &style_tmp;
+#else
+    lv_style_t * style_mod = &group->style_tmp;
+#endif
+
     /*Load the current style. It will be modified by the callback*/
-    lv_style_copy(&group->style_tmp, style);
+    if(style != style_mod) lv_style_copy(style_mod, style);
 
     if(group->editing) {
-        if(group->style_mod_edit_cb) group->style_mod_edit_cb(group, &group->style_tmp);
+        if(group->style_mod_edit_cb) group->style_mod_edit_cb(group, style_mod);
     } else {
-        if(group->style_mod_cb) group->style_mod_cb(group, &group->style_tmp);
+        if(group->style_mod_cb) group->style_mod_cb(group, style_mod);
     }
-    return &group->style_tmp;
+    return style_mod;
 }
 
 /**
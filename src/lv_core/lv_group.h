@@ -59,7 +59,8 @@ typedef struct _lv_group_t
     lv_group_style_mod_cb_t style_mod_cb;      /**< A function to modifies the style of the focused object*/
     lv_group_style_mod_cb_t style_mod_edit_cb; /**< A function which modifies the style of the edited object*/
     lv_group_focus_cb_t focus_cb;              /**< A function to call when a new object is focused (optional)*/
-    lv_style_t style_tmp;                      /**< Stores the modified style of the focused object */
+    lv_style_t style_tmp;                      /**< Stores the modified style of the focused object
+                                                    (a thread local style is used instead with `LV_USE_PARALLEL_DRAW`)*/
 #if LV_USE_USER_DATA
     lv_group_user_data_t user_data;
 #endif
@@ -205,7 +206,8 @@ void lv_group_set_wrap(lv_group_t * group, bool en);
  * Modify a style with the set 'style_mod' function. The input style remains unchanged.
  * @param group pointer to group
  * @param style pointer to a style to modify
- * @return a copy of the input style but modified with the 'style_mod' function
+ * @return a copy of the input style but modified with the 'style_mod' function.
+ *         It's overwritten by the next call (in the same thread with `LV_USE_PARALLEL_DRAW`)
  */
 lv_style_t * lv_group_mod_style(lv_group_t * group, const lv_style_t * style);
 
@@ -15,6 +15,8 @@
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_mem.h"
+#include "lv_obj_index.h"
 
 /*********************
  *      DEFINES
@@ -1054,13 +1056,33 @@ lv_obj_t * lv_indev_search_obj(lv_obj_t * obj, lv_point_t *point)
     if(lv_obj_hittest(obj, point)) {
         lv_obj_t * i;
 
-        LV_LL_READ(obj->child_ll, i)
+#if LV_USE_OBJ_INDEX
+        /*With many children check only the ones around the point*/
+        lv_obj_index_t * index = lv_obj_index_get(obj);
+        const lv_obj_index_item_t ** found = NULL;
+        if(index) found = lv_mem_buf_get(index->cnt * sizeof(lv_obj_index_item_t *));
+        if(found) {
+            lv_area_t point_area;
+            lv_area_set(&point_area, point->x, point->y, point->x, point->y);
+            uint16_t found_cnt = lv_obj_index_search(index, obj, &point_area, found);
+
+            /*Check the top children first*/
+            while(found_cnt > 0 && found_p == NULL) {
+                found_cnt--;
+                found_p = lv_indev_search_obj(found[found_cnt]->obj, point);
+            }
+            lv_mem_buf_release(found);
+        } else
+#endif
         {
-            found_p = lv_indev_search_obj(i, point);
+            LV_LL_READ(obj->child_ll, i)
+            {
+                found_p = lv_indev_search_obj(i, point);
 
-            /*If a child was found then break*/
-            if(found_p != NULL) {
-                break;
+                /*If a child was found then break*/
+                if(found_p != NULL) {
+                    break;
+                }
             }
         }
 
@@ -1215,8 +1237,11 @@ static void indev_drag(lv_indev_proc_t * proc)
                 lv_coord_t act_par_w = lv_obj_get_width(lv_obj_get_parent(drag_obj));
                 lv_coord_t act_par_h = lv_obj_get_height(lv_obj_get_parent(drag_obj));
                 if(act_par_w == prev_par_w && act_par_h == prev_par_h) {
+                    /*The areas might be merged if the buffer was full. Remove the new areas only if they were just added.*/
                     uint16_t new_inv_buf_size = lv_disp_get_inv_buf_size(indev_act->driver.disp);
-                    lv_disp_pop_from_inv_buf(indev_act->driver.disp, new_inv_buf_size - inv_buf_size);
+                    if(new_inv_buf_size > inv_buf_size) {
+                        lv_disp_pop_from_inv_buf(indev_act->driver.disp, new_inv_buf_size - inv_buf_size);
+                    }
                 }
             }
         }
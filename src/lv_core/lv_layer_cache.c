@@ -0,0 +1,240 @@
+/**
+ * @file lv_layer_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_layer_cache.h"
+
+#if LV_USE_LAYER_CACHE != 0
+
+#include <string.h>
+#include "../lv_core/lv_debug.h"
+#include "../lv_hal/lv_hal_disp.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_ll.h"
+#include "../lv_misc/lv_gc.h"
+
+#if defined(LV_GC_INCLUDE)
+#include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void buf_free(lv_layer_cache_t * cache);
+static bool evict_lru(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t mem_used;   /*Total size of the layer buffers*/
+static uint32_t frame_act;  /*Counts the frames to find the least recently used layers*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the layer cache
+ */
+void lv_layer_cache_init(void)
+{
+    lv_ll_init(&LV_GC_ROOT(_lv_layer_cache_ll), sizeof(lv_layer_cache_t));
+    mem_used  = 0;
+    frame_act = 1;
+}
+
+/**
+ * Create a layer cache for an object. Nothing happens if it already has one.
+ * @param obj pointer to an object
+ * @return the layer cache of the object or NULL if out of memory
+ */
+lv_layer_cache_t * lv_layer_cache_create(lv_obj_t * obj)
+{
+    if(obj->layer_cache) return obj->layer_cache;
+
+    lv_layer_cache_t * cache = lv_ll_ins_head(&LV_GC_ROOT(_lv_layer_cache_ll));
+    LV_ASSERT_MEM(cache);
+    if(cache == NULL) return NULL;
+
+    memset(cache, 0, sizeof(lv_layer_cache_t));
+    cache->obj = obj;
+    obj->layer_cache = cache;
+
+    return cache;
+}
+
+/**
+ * Delete the layer cache of an object and free its buffer
+ * @param obj pointer to an object
+ */
+void lv_layer_cache_del(lv_obj_t * obj)
+{
+    lv_layer_cache_t * cache = obj->layer_cache;
+    if(cache == NULL) return;
+
+    buf_free(cache);
+    lv_ll_remove(&LV_GC_ROOT(_lv_layer_cache_ll), cache);
+    lv_mem_free(cache);
+    obj->layer_cache = NULL;
+}
+
+/**
+ * Mark the layer cache of an object and its parents as invalid.
+ * Should be called when the object or any of its children changed.
+ * @param obj pointer to an object
+ */
+void lv_layer_cache_invalidate(const lv_obj_t * obj)
+{
+    while(obj) {
+        if(obj->layer_cache) obj->layer_cache->valid = 0;
+        obj = lv_obj_get_parent(obj);
+    }
+}
+
+/**
+ * Get the area a layer cache should cover: the object's extended draw area on the display
+ * @param obj pointer to an object
+ * @param area_p store the area here
+ * @return false: the object is out of the display
+ */
+bool lv_layer_cache_get_area(const lv_obj_t * obj, lv_area_t * area_p)
+{
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    lv_area_t disp_area;
+    disp_area.x1 = 0;
+    disp_area.y1 = 0;
+    disp_area.x2 = lv_disp_get_hor_res(disp) - 1;
+    disp_area.y2 = lv_disp_get_ver_res(disp) - 1;
+
+    lv_area_copy(area_p, &obj->coords);
+    area_p->x1 -= obj->ext_draw_pad;
+    area_p->y1 -= obj->ext_draw_pad;
+    area_p->x2 += obj->ext_draw_pad;
+    area_p->y2 += obj->ext_draw_pad;
+
+    return lv_area_intersect(area_p, area_p, &disp_area);
+}
+
+/**
+ * Check if the layer cache of an object can be used to draw the object
+ * @param cache pointer to a layer cache
+ * @return true: the layer is rendered and the object hasn't changed since then
+ */
+bool lv_layer_cache_is_valid(const lv_layer_cache_t * cache)
+{
+    if(cache->valid == 0 || cache->buf == NULL) return false;
+
+    /*The object or a parent might be moved or faded without invalidating the object itself*/
+    lv_area_t area;
+    if(lv_layer_cache_get_area(cache->obj, &area) == false) return false;
+    if(memcmp(&area, &cache->area, sizeof(lv_area_t))) return false;
+    if(lv_obj_get_opa_scale(cache->obj) != cache->opa_scale) return false;
+
+    return true;
+}
+
+/**
+ * Allocate a buffer for a layer cache to render the object into.
+ * The least recently used layers are freed if `LV_LAYER_CACHE_SIZE` is exceeded.
+ * @param cache pointer to a layer cache
+ * @param area_p the area to cover (returned by `lv_layer_cache_get_area`)
+ * @return true: the buffer is ready; false: not enough memory, the object should be drawn directly
+ */
+bool lv_layer_cache_alloc(lv_layer_cache_t * cache, const lv_area_t * area_p)
+{
+    uint32_t size = lv_area_get_size(area_p) * sizeof(lv_color_t);
+    cache->valid = 0;
+
+    /*Reuse the buffer if it has the same size*/
+    if(cache->buf == NULL || cache->buf_size != size) {
+        buf_free(cache);
+        if(size > LV_LAYER_CACHE_SIZE) return false;
+
+        while(mem_used + size > LV_LAYER_CACHE_SIZE) {
+            if(evict_lru() == false) return false;
+        }
+
+        cache->buf = lv_mem_alloc(size);
+        if(cache->buf == NULL) return false;
+        cache->buf_size = size;
+        mem_used += size;
+    }
+
+    lv_area_copy(&cache->area, area_p);
+    cache->opa_scale = lv_obj_get_opa_scale(cache->obj);
+
+    return true;
+}
+
+/**
+ * Mark a layer cache as used in the current frame. Such layers are not freed until the next frame.
+ * @param cache pointer to a layer cache
+ */
+void lv_layer_cache_touch(lv_layer_cache_t * cache)
+{
+    cache->last_frame = frame_act;
+}
+
+/**
+ * Start a new frame. Call it before refreshing a display.
+ */
+void lv_layer_cache_new_frame(void)
+{
+    frame_act++;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Free the buffer of a layer cache
+ * @param cache pointer to a layer cache
+ */
+static void buf_free(lv_layer_cache_t * cache)
+{
+    if(cache->buf == NULL) return;
+
+    lv_mem_free(cache->buf);
+    mem_used -= cache->buf_size;
+    cache->buf      = NULL;
+    cache->buf_size = 0;
+    cache->valid    = 0;
+}
+
+/**
+ * Free the buffer of the least recently used layer which wasn't used in the current frame
+ * @return false: there was no such layer
+ */
+static bool evict_lru(void)
+{
+    lv_layer_cache_t * lru = NULL;
+    lv_layer_cache_t * cache;
+    LV_LL_READ(LV_GC_ROOT(_lv_layer_cache_ll), cache) {
+        if(cache->buf == NULL || cache->last_frame == frame_act) continue;
+        if(lru == NULL || cache->last_frame < lru->last_frame) lru = cache;
+    }
+
+    if(lru == NULL) return false;
+
+    buf_free(lru);
+    return true;
+}
+
+#endif /*LV_USE_LAYER_CACHE*/
@@ -0,0 +1,120 @@
+/**
+ * @file lv_layer_cache.h
+ * Keep the rendered image of objects (with their children) to redraw them without drawing again
+ */
+
+#ifndef LV_LAYER_CACHE_H
+#define LV_LAYER_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_LAYER_CACHE != 0
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*With alpha channel any object can be cached. Else only the ones which cover their area.*/
+#define LV_LAYER_CACHE_ALPHA    (LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP != 0)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** The cached image of an object*/
+typedef struct _lv_layer_cache_t
+{
+    lv_obj_t * obj;         /**< The cached object*/
+    lv_color_t * buf;       /**< The rendered object or NULL if it's not rendered yet (or freed)*/
+    uint32_t buf_size;      /**< Size of `buf` in bytes*/
+    lv_area_t area;         /**< Absolute coordinates of `buf`*/
+    uint32_t last_frame;    /**< The frame when the layer was last used*/
+    lv_opa_t opa_scale;     /**< Opacity scale of the object when it was rendered*/
+    uint8_t valid : 1;      /**< 1: `buf` shows the current state of the object*/
+} lv_layer_cache_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the layer cache
+ */
+void lv_layer_cache_init(void);
+
+/**
+ * Create a layer cache for an object. Nothing happens if it already has one.
+ * @param obj pointer to an object
+ * @return the layer cache of the object or NULL if out of memory
+ */
+lv_layer_cache_t * lv_layer_cache_create(lv_obj_t * obj);
+
+/**
+ * Delete the layer cache of an object and free its buffer
+ * @param obj pointer to an object
+ */
+void lv_layer_cache_del(lv_obj_t * obj);
+
+/**
+ * Mark the layer cache of an object and its parents as invalid.
+ * Should be called when the object or any of its children changed.
+ * @param obj pointer to an object
+ */
+void lv_layer_cache_invalidate(const lv_obj_t * obj);
+
+/**
+ * Get the area a layer cache should cover: the object's extended draw area on the display
+ * @param obj pointer to an object
+ * @param area_p store the area here
+ * @return false: the object is out of the display
+ */
+bool lv_layer_cache_get_area(const lv_obj_t * obj, lv_area_t * area_p);
+
+/**
+ * Check if the layer cache of an object can be used to draw the object
+ * @param cache pointer to a layer cache
+ * @return true: the layer is rendered and the object hasn't changed since then
+ */
+bool lv_layer_cache_is_valid(const lv_layer_cache_t * cache);
+
+/**
+ * Allocate a buffer for a layer cache to render the object into.
+ * The least recently used layers are freed if `LV_LAYER_CACHE_SIZE` is exceeded.
+ * @param cache pointer to a layer cache
+ * @param area_p the area to cover (returned by `lv_layer_cache_get_area`)
+ * @return true: the buffer is ready; false: not enough memory, the object should be drawn directly
+ */
+bool lv_layer_cache_alloc(lv_layer_cache_t * cache, const lv_area_t * area_p);
+
+/**
+ * Mark a layer cache as used in the current frame. Such layers are not freed until the next frame.
+ * @param cache pointer to a layer cache
+ */
+void lv_layer_cache_touch(lv_layer_cache_t * cache);
+
+/**
+ * Start a new frame. Call it before refreshing a display.
+ */
+void lv_layer_cache_new_frame(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_LAYER_CACHE*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_LAYER_CACHE_H*/
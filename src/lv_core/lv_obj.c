@@ -11,9 +11,12 @@
 #include "lv_refr.h"
 #include "lv_group.h"
 #include "lv_disp.h"
+#include "lv_obj_index.h"
+#include "lv_layer_cache.h"
 #include "../lv_core/lv_debug.h"
 #include "../lv_themes/lv_theme.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_draw/lv_draw_blend_simd.h"
 #include "../lv_misc/lv_anim.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_async.h"
@@ -67,6 +70,11 @@ static lv_res_t lv_obj_signal(lv_obj_t * obj, lv_signal_t sign, void * param);
 static bool lv_initialized = false;
 static lv_event_temp_data_t * event_temp_data_head;
 static const void * event_act_data;
+#if LV_USE_GROUP && LV_USE_PARALLEL_DRAW
+/*Style used instead of the object's style by the current drawing thread. See `lv_obj_set_draw_style`*/
+static LV_THREAD_LOCAL const lv_obj_t * draw_style_obj;
+static LV_THREAD_LOCAL const lv_style_t * draw_style;
+#endif
 
 /**********************
  *      MACROS
@@ -118,8 +126,31 @@ void lv_init(void)
     lv_indev_init();
 
     lv_img_decoder_init();
+#if LV_IMG_CACHE_ASYNC
+    lv_img_cache_async_init();
+#endif
     lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
 
+#if LV_BLEND_SIMD
+    lv_blend_simd_init();
+#endif
+
+#if LV_USE_LAYER_CACHE
+    lv_layer_cache_init();
+#endif
+
+#if LV_USE_RADIUS_CACHE
+    lv_draw_mask_radius_cache_init();
+#endif
+
+#if LV_USE_SHADOW_CACHE
+    lv_draw_shadow_cache_init();
+#endif
+
+#if LV_USE_GRAD_CACHE
+    lv_draw_grad_cache_init();
+#endif
+
     lv_initialized = true;
     LV_LOG_INFO("lv_init ready");
 }
@@ -184,6 +215,14 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         new_obj->coords.y2    = lv_disp_get_ver_res(NULL) - 1;
         new_obj->ext_draw_pad = 0;
 
+#if LV_USE_OBJ_INDEX
+        new_obj->child_index = NULL;
+#endif
+
+#if LV_USE_LAYER_CACHE
+        new_obj->layer_cache = NULL;
+#endif
+
 #if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
         memset(&new_obj->ext_click_pad, 0, sizeof(new_obj->ext_click_pad));
 #endif
@@ -279,6 +318,14 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         }
         new_obj->ext_draw_pad = 0;
 
+#if LV_USE_OBJ_INDEX
+        new_obj->child_index = NULL;
+#endif
+
+#if LV_USE_LAYER_CACHE
+        new_obj->layer_cache = NULL;
+#endif
+
 #if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
         memset(&new_obj->ext_click_pad, 0, sizeof(new_obj->ext_click_pad));
 #endif
@@ -492,6 +539,12 @@ lv_res_t lv_obj_del(lv_obj_t * obj)
     }
 
     /*Delete the base objects*/
+#if LV_USE_OBJ_INDEX
+    lv_obj_index_invalidate(obj);
+#endif
+#if LV_USE_LAYER_CACHE
+    lv_layer_cache_del(obj);
+#endif
     if(obj->ext_attr != NULL) lv_mem_free(obj->ext_attr);
     lv_mem_free(obj); /*Free the object itself*/
 
@@ -543,6 +596,11 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
+#if LV_USE_LAYER_CACHE
+    /*Something has changed on the object so its cached image (and its parents') is outdated*/
+    lv_layer_cache_invalidate(obj);
+#endif
+
     if(lv_obj_get_hidden(obj)) return;
 
     /*Invalidate the object only if it belongs to the 'LV_GC_ROOT(_lv_act_scr)'*/
@@ -1243,6 +1301,11 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, lv_coord_t left, lv_coord_t right
     (void)top;    /*Unused*/
     (void)bottom; /*Unused*/
 #endif
+
+#if LV_USE_OBJ_INDEX && LV_USE_EXT_CLICK_AREA != LV_EXT_CLICK_AREA_OFF
+    /*The clickable area is in the parent's index*/
+    lv_obj_index_invalidate(lv_obj_get_parent(obj));
+#endif
 }
 
 /*---------------------
@@ -1283,6 +1346,21 @@ void lv_obj_refresh_style(lv_obj_t * obj)
     lv_obj_invalidate(obj);
 }
 
+#if LV_USE_GROUP && LV_USE_PARALLEL_DRAW
+/**
+ * Temporarily use an other style for an object while the calling thread draws it.
+ * Unlike `lv_obj_set_style` it doesn't modify the object so the other drawing threads still see its own style.
+ * Only for design functions. Only one object can have a draw style at a time.
+ * @param obj pointer to an object. NULL to remove the draw style
+ * @param style pointer to a style which is valid until the draw style is removed
+ */
+void lv_obj_set_draw_style(const lv_obj_t * obj, const lv_style_t * style)
+{
+    draw_style_obj = obj;
+    draw_style     = style;
+}
+#endif
+
 /**
  * Notify all object if a style is modified
  * @param style pointer to a style. Only the objects with this style will be notified
@@ -1487,6 +1565,23 @@ void lv_obj_set_opa_scale(lv_obj_t * obj, lv_opa_t opa_scale)
     lv_obj_invalidate(obj);
 }
 
+#if LV_USE_LAYER_CACHE
+/**
+ * Enable caching the rendered image of an object and its children.
+ * They will be redrawn from the cache until any of them changes.
+ * Useful for complex but rarely changing objects, e.g. a panel with many labels.
+ * @param obj pointer to an object
+ * @param en true: enable the layer cache; false: disable it and free the cached image
+ */
+void lv_obj_set_layer_cache(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
+
+    if(en) lv_layer_cache_create(obj);
+    else lv_layer_cache_del(obj);
+}
+#endif
+
 /**
  * Set a bit or bits in the protect filed
  * @param obj pointer to an object
@@ -1685,6 +1780,11 @@ void lv_obj_refresh_ext_draw_pad(lv_obj_t * obj)
     obj->ext_draw_pad = 0;
     obj->signal_cb(obj, LV_SIGNAL_REFR_EXT_DRAW_PAD, NULL);
 
+#if LV_USE_OBJ_INDEX
+    /*The drawing area is in the parent's index*/
+    lv_obj_index_invalidate(lv_obj_get_parent(obj));
+#endif
+
     lv_obj_invalidate(obj);
 }
 
@@ -2082,6 +2182,10 @@ const lv_style_t * lv_obj_get_style(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
+#if LV_USE_GROUP && LV_USE_PARALLEL_DRAW
+    if(draw_style_obj != NULL && obj == draw_style_obj) return draw_style;
+#endif
+
     const lv_style_t * style_act = obj->style_p;
     if(style_act == NULL) {
         lv_obj_t * par = obj->par;
@@ -2290,6 +2394,20 @@ lv_opa_t lv_obj_get_opa_scale(const lv_obj_t * obj)
     return LV_OPA_COVER;
 }
 
+#if LV_USE_LAYER_CACHE
+/**
+ * Get whether the rendered image of an object is cached
+ * @param obj pointer to an object
+ * @return true: the layer cache is enabled
+ */
+bool lv_obj_get_layer_cache(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
+
+    return obj->layer_cache ? true : false;
+}
+#endif
+
 /**
  * Get the protect field of an object
  * @param obj pointer to an object
@@ -2632,9 +2750,23 @@ static lv_res_t lv_obj_signal(lv_obj_t * obj, lv_signal_t sign, void * param)
     lv_res_t res = LV_RES_OK;
 
     if(sign == LV_SIGNAL_CHILD_CHG) {
+#if LV_USE_OBJ_INDEX
+        /*A child is added, removed or changed its coordinates*/
+        lv_obj_index_invalidate(obj);
+#endif
+#if LV_USE_LAYER_CACHE
+        lv_layer_cache_invalidate(obj);
+#endif
         /*Return 'invalid' if the child change signal is not enabled*/
         if(lv_obj_is_protected(obj, LV_PROTECT_CHILD_CHG) != false) res = LV_RES_INV;
     }
+#if LV_USE_OBJ_INDEX
+    else if(sign == LV_SIGNAL_CORD_CHG) {
+        /*The position among the siblings has changed.
+         *The children's index remains valid as it stores relative coordinates.*/
+        lv_obj_index_invalidate(lv_obj_get_parent(obj));
+    }
+#endif
 #if LV_USE_OBJ_REALIGN
     else if(sign == LV_SIGNAL_PARENT_SIZE_CHG) {
         if(obj->realign.auto_realign) {
@@ -2780,6 +2912,12 @@ static void delete_children(lv_obj_t * obj)
     lv_ll_remove(&(par->child_ll), obj);
 
     /*Delete the base objects*/
+#if LV_USE_OBJ_INDEX
+    lv_obj_index_invalidate(obj);
+#endif
+#if LV_USE_LAYER_CACHE
+    lv_layer_cache_del(obj);
+#endif
     if(obj->ext_attr != NULL) lv_mem_free(obj->ext_attr);
     lv_mem_free(obj); /*Free the object itself*/
 }
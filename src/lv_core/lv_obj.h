@@ -232,6 +232,14 @@ typedef struct _lv_obj_t
 
     lv_coord_t ext_draw_pad; /**< EXTtend the size in every direction for drawing. */
 
+#if LV_USE_OBJ_INDEX
+    struct _lv_obj_index_t * child_index; /**< Spatial index about the children. Created when required.*/
+#endif
+
+#if LV_USE_LAYER_CACHE
+    struct _lv_layer_cache_t * layer_cache; /**< The cached image of the object if it's enabled*/
+#endif
+
 #if LV_USE_OBJ_REALIGN
     lv_reailgn_t realign;       /**< Information about the last call to ::lv_obj_align. */
 #endif
@@ -472,6 +480,17 @@ void lv_obj_set_style(lv_obj_t * obj, const lv_style_t * style);
  */
 void lv_obj_refresh_style(lv_obj_t * obj);
 
+#if LV_USE_GROUP && LV_USE_PARALLEL_DRAW
+/**
+ * Temporarily use an other style for an object while the calling thread draws it.
+ * Unlike `lv_obj_set_style` it doesn't modify the object so the other drawing threads still see its own style.
+ * Only for design functions. Only one object can have a draw style at a time.
+ * @param obj pointer to an object. NULL to remove the draw style
+ * @param style pointer to a style which is valid until the draw style is removed
+ */
+void lv_obj_set_draw_style(const lv_obj_t * obj, const lv_style_t * style);
+#endif
+
 /**
  * Notify all object if a style is modified
  * @param style pointer to a style. Only the objects with this style will be notified
@@ -576,6 +595,17 @@ void lv_obj_set_opa_scale_enable(lv_obj_t * obj, bool en);
  */
 void lv_obj_set_opa_scale(lv_obj_t * obj, lv_opa_t opa_scale);
 
+#if LV_USE_LAYER_CACHE
+/**
+ * Enable caching the rendered image of an object and its children.
+ * They will be redrawn from the cache until any of them changes.
+ * Useful for complex but rarely changing objects, e.g. a panel with many labels.
+ * @param obj pointer to an object
+ * @param en true: enable the layer cache; false: disable it and free the cached image
+ */
+void lv_obj_set_layer_cache(lv_obj_t * obj, bool en);
+#endif
+
 /**
  * Set a bit or bits in the protect filed
  * @param obj pointer to an object
@@ -928,6 +958,15 @@ lv_opa_t lv_obj_get_opa_scale_enable(const lv_obj_t * obj);
  */
 lv_opa_t lv_obj_get_opa_scale(const lv_obj_t * obj);
 
+#if LV_USE_LAYER_CACHE
+/**
+ * Get whether the rendered image of an object is cached
+ * @param obj pointer to an object
+ * @return true: the layer cache is enabled
+ */
+bool lv_obj_get_layer_cache(const lv_obj_t * obj);
+#endif
+
 /**
  * Get the protect field of an object
  * @param obj pointer to an object
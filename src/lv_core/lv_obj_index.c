@@ -0,0 +1,226 @@
+/**
+ * @file lv_obj_index.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_index.h"
+
+#if LV_USE_OBJ_INDEX != 0
+
+#include "../lv_core/lv_debug.h"
+#include "../lv_draw/lv_draw.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_math.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_obj_index_t * index_create(lv_obj_t * obj, uint16_t cnt);
+static void get_item_area(const lv_obj_t * obj, lv_area_t * area_p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the index of an object's children. Create it if it's not created yet.
+ * @param obj pointer to an object
+ * @return the index or NULL if `obj` has only a few children (or out of memory)
+ */
+lv_obj_index_t * lv_obj_index_get(lv_obj_t * obj)
+{
+    /*Count the children but stop early if there are only a few*/
+    uint32_t cnt = 0;
+    lv_obj_t * child;
+    LV_LL_READ(obj->child_ll, child) {
+        cnt++;
+        if(cnt >= LV_OBJ_INDEX_MIN_CHILD) break;
+    }
+    if(cnt < LV_OBJ_INDEX_MIN_CHILD) return NULL;
+
+    /*The index might be created while drawing in parallel*/
+    LV_DRAW_LOCK();
+    if(obj->child_index == NULL) {
+        cnt = lv_ll_get_len(&obj->child_ll);
+        if(cnt <= UINT16_MAX) obj->child_index = index_create(obj, cnt);
+    }
+    lv_obj_index_t * index = obj->child_index;
+    LV_DRAW_UNLOCK();
+
+    return index;
+}
+
+/**
+ * Delete the index of an object's children. It will be created again when required.
+ * Should be called when a child is added, removed or its coordinates changed.
+ * @param obj pointer to an object
+ */
+void lv_obj_index_invalidate(lv_obj_t * obj)
+{
+    if(obj == NULL || obj->child_index == NULL) return;
+
+    lv_mem_free(obj->child_index);
+    obj->child_index = NULL;
+}
+
+/**
+ * Find the children which might be on an area
+ * @param index pointer to the index of `obj`
+ * @param obj pointer to the object whose children are in the index
+ * @param area_p pointer to an area (absolute coordinates)
+ * @param res store the found items here in drawing order. Should have space for `index->cnt` items.
+ * @return number of items in `res`
+ */
+uint16_t lv_obj_index_search(const lv_obj_index_t * index, const lv_obj_t * obj, const lv_area_t * area_p,
+                             const lv_obj_index_item_t ** res)
+{
+    /*The items are stored relative to the parent*/
+    lv_area_t a;
+    a.x1 = area_p->x1 - obj->coords.x1;
+    a.y1 = area_p->y1 - obj->coords.y1;
+    a.x2 = area_p->x2 - obj->coords.x1;
+    a.y2 = area_p->y2 - obj->coords.y1;
+
+    /*An item can be on the area only if its `y1` is in [a.y1 - max_h + 1 ; a.y2].
+     *Find the first such item with binary search.*/
+    int32_t y_min = (int32_t)a.y1 - index->max_h + 1;
+    uint16_t first = 0;
+    uint16_t last = index->cnt;
+    while(first < last) {
+        uint16_t mid = first + ((last - first) >> 1);
+        if(index->items[mid].area.y1 < y_min) first = mid + 1;
+        else last = mid;
+    }
+
+    uint16_t res_cnt = 0;
+    uint16_t i;
+    for(i = first; i < index->cnt && index->items[i].area.y1 <= a.y2; i++) {
+        if(lv_area_is_on(&index->items[i].area, &a)) {
+            res[res_cnt] = &index->items[i];
+            res_cnt++;
+        }
+    }
+
+    /*Sort the found items to drawing order with shell sort. Usually only a few items are found.*/
+    uint16_t gap;
+    for(gap = res_cnt >> 1; gap > 0; gap >>= 1) {
+        for(i = gap; i < res_cnt; i++) {
+            const lv_obj_index_item_t * tmp = res[i];
+            uint16_t j = i;
+            while(j >= gap && res[j - gap]->order > tmp->order) {
+                res[j] = res[j - gap];
+                j -= gap;
+            }
+            res[j] = tmp;
+        }
+    }
+
+    return res_cnt;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Create an index about the children of an object
+ * @param obj pointer to an object
+ * @param cnt number of children of `obj`
+ * @return the new index or NULL on error
+ */
+static lv_obj_index_t * index_create(lv_obj_t * obj, uint16_t cnt)
+{
+    /*Allocate the items together with the descriptor*/
+    lv_obj_index_t * index = lv_mem_alloc(sizeof(lv_obj_index_t) + cnt * sizeof(lv_obj_index_item_t));
+    LV_ASSERT_MEM(index);
+    if(index == NULL) return NULL;
+
+    index->items = (lv_obj_index_item_t *)(index + 1);
+    index->cnt   = cnt;
+    index->max_h = 0;
+
+    /*Save the children in drawing order*/
+    uint16_t i = 0;
+    lv_obj_t * child;
+    LV_LL_READ_BACK(obj->child_ll, child) {
+        lv_obj_index_item_t * item = &index->items[i];
+        item->obj   = child;
+        item->order = i;
+        get_item_area(child, &item->area);
+        item->area.x1 -= obj->coords.x1;
+        item->area.y1 -= obj->coords.y1;
+        item->area.x2 -= obj->coords.x1;
+        item->area.y2 -= obj->coords.y1;
+
+        lv_coord_t h = lv_area_get_height(&item->area);
+        if(h > index->max_h) index->max_h = h;
+        i++;
+    }
+
+    /*Sort by `y1` with shell sort*/
+    uint16_t gap;
+    for(gap = cnt >> 1; gap > 0; gap >>= 1) {
+        for(i = gap; i < cnt; i++) {
+            lv_obj_index_item_t tmp = index->items[i];
+            uint16_t j = i;
+            while(j >= gap && index->items[j - gap].area.y1 > tmp.area.y1) {
+                index->items[j] = index->items[j - gap];
+                j -= gap;
+            }
+            index->items[j] = tmp;
+        }
+    }
+
+    return index;
+}
+
+/**
+ * Get the area where an object can be drawn or clicked
+ * @param obj pointer to an object
+ * @param area_p store the area here
+ */
+static void get_item_area(const lv_obj_t * obj, lv_area_t * area_p)
+{
+    lv_coord_t pad_left   = obj->ext_draw_pad;
+    lv_coord_t pad_right  = obj->ext_draw_pad;
+    lv_coord_t pad_top    = obj->ext_draw_pad;
+    lv_coord_t pad_bottom = obj->ext_draw_pad;
+
+#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
+    pad_left   = LV_MATH_MAX(pad_left, obj->ext_click_pad_hor);
+    pad_right  = LV_MATH_MAX(pad_right, obj->ext_click_pad_hor);
+    pad_top    = LV_MATH_MAX(pad_top, obj->ext_click_pad_ver);
+    pad_bottom = LV_MATH_MAX(pad_bottom, obj->ext_click_pad_ver);
+#elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
+    pad_left   = LV_MATH_MAX(pad_left, obj->ext_click_pad.x1);
+    pad_right  = LV_MATH_MAX(pad_right, obj->ext_click_pad.x2);
+    pad_top    = LV_MATH_MAX(pad_top, obj->ext_click_pad.y1);
+    pad_bottom = LV_MATH_MAX(pad_bottom, obj->ext_click_pad.y2);
+#endif
+
+    area_p->x1 = obj->coords.x1 - pad_left;
+    area_p->y1 = obj->coords.y1 - pad_top;
+    area_p->x2 = obj->coords.x2 + pad_right;
+    area_p->y2 = obj->coords.y2 + pad_bottom;
+}
+
+#endif /*LV_USE_OBJ_INDEX*/
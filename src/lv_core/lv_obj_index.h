@@ -0,0 +1,86 @@
+/**
+ * @file lv_obj_index.h
+ * Spatial index about the children of an object
+ */
+
+#ifndef LV_OBJ_INDEX_H
+#define LV_OBJ_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_OBJ_INDEX != 0
+
+#include <stdint.h>
+#include "lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** A child in the index*/
+typedef struct
+{
+    lv_obj_t * obj;     /**< The child*/
+    lv_area_t area;     /**< Coordinates relative to the parent with the draw and click paddings*/
+    uint16_t order;     /**< Position in the drawing order (0: drawn first)*/
+} lv_obj_index_item_t;
+
+/** The children of an object sorted by their `y1` coordinate*/
+typedef struct _lv_obj_index_t
+{
+    lv_obj_index_item_t * items;
+    uint16_t cnt;
+    lv_coord_t max_h;   /**< Height of the highest item*/
+} lv_obj_index_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the index of an object's children. Create it if it's not created yet.
+ * @param obj pointer to an object
+ * @return the index or NULL if `obj` has only a few children (or out of memory)
+ */
+lv_obj_index_t * lv_obj_index_get(lv_obj_t * obj);
+
+/**
+ * Delete the index of an object's children. It will be created again when required.
+ * Should be called when a child is added, removed or its coordinates changed.
+ * @param obj pointer to an object
+ */
+void lv_obj_index_invalidate(lv_obj_t * obj);
+
+/**
+ * Find the children which might be on an area
+ * @param index pointer to the index of `obj`
+ * @param obj pointer to the object whose children are in the index
+ * @param area_p pointer to an area (absolute coordinates)
+ * @param res store the found items here in drawing order. Should have space for `index->cnt` items.
+ * @return number of items in `res`
+ */
+uint16_t lv_obj_index_search(const lv_obj_index_t * index, const lv_obj_t * obj, const lv_area_t * area_p,
+                             const lv_obj_index_item_t ** res);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_OBJ_INDEX*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_OBJ_INDEX_H*/
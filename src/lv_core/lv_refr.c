@@ -9,12 +9,18 @@
 #include <stddef.h>
 #include "lv_refr.h"
 #include "lv_disp.h"
+#include "lv_obj_index.h"
+#include "lv_layer_cache.h"
 #include "../lv_hal/lv_hal_tick.h"
 #include "../lv_hal/lv_hal_disp.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_region.h"
+#include "../lv_misc/lv_profiler.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_draw/lv_draw_backend.h"
 
 #if defined(LV_GC_INCLUDE)
 #include LV_GC_INCLUDE
@@ -26,6 +32,18 @@
 /* Draw translucent random colored areas on the invalidated (redrawn) areas*/
 #define MASK_AREA_DEBUG 0
 
+#define OCCLUSION_AREA_MAX      8   /*Max. number of visible parts an object is refreshed in*/
+#define OCCLUSION_SIBLING_MAX   8   /*Max. number of younger siblings checked whether they cover an object*/
+
+#if LV_USE_VSYNC
+#define VSYNC_FAST_FRAME_CNT    8   /*Render frames more often after this many fast frames in a row*/
+#endif
+
+#if LV_USE_PARALLEL_DRAW
+#define PARALLEL_SLICE_MAX      16  /*Max. number of slices rendered in parallel*/
+#define PARALLEL_SLICE_MIN_H    8   /*Don't create slices smaller than this height*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,20 +51,51 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static void lv_refr_join_area(void);
+static bool lv_refr_disp(lv_disp_t * disp);
+#if LV_USE_VSYNC
+static void lv_refr_vsync_update(lv_disp_t * disp);
+static bool lv_refr_vsync_check(lv_disp_t * disp);
+static void lv_refr_vsync_adapt(lv_disp_t * disp, uint32_t render_time);
+#endif
+static void lv_refr_add_area(lv_disp_t * disp, const lv_area_t * area_p);
+static void lv_refr_join_area(lv_disp_t * disp, uint16_t max_cnt);
+static void lv_refr_merge_overlap(lv_disp_t * disp);
+static void lv_refr_add_history(lv_disp_t * disp);
+static void lv_refr_update_age(lv_disp_t * disp);
+static uint32_t lv_refr_area_cost(const lv_area_t * area_p, void * user_data);
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
 static void lv_refr_area_part(const lv_area_t * area_p);
+static void lv_refr_slice(lv_obj_t * top_p, const lv_area_t * mask_p);
+#if LV_USE_PARALLEL_DRAW
+static bool lv_refr_parallel(lv_obj_t * top_p, const lv_area_t * area_p);
+static void lv_refr_parallel_job(const lv_area_t * slice);
+#endif
+#if LV_USE_LAYER_CACHE
+static void lv_refr_layer_cache_prepare(const lv_area_t * area_p);
+static void lv_refr_layer_cache_render(lv_layer_cache_t * cache);
+static void lv_refr_layer_cache_blend(const lv_layer_cache_t * cache, const lv_area_t * mask_p);
+#endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p);
+static void lv_refr_obj_visible(lv_obj_t * obj, const lv_area_t * mask_p);
+static uint8_t lv_refr_get_cover_areas(lv_obj_t * obj, const lv_area_t * mask_p, lv_area_t cover[]);
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p);
+static void lv_refr_child(lv_obj_t * child_p, const lv_area_t * mask_p);
 static void lv_refr_vdb_flush(void);
+static void lv_refr_wait_slot(uint8_t id);
+#if LV_USE_PROFILER
+static const char * lv_refr_get_type_name(lv_obj_t * obj);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t px_num;
 static lv_disp_t * disp_refr; /*Display being refreshed*/
+#if LV_USE_PARALLEL_DRAW
+static lv_obj_t * parallel_top_p; /*The top object of the slices being rendered in parallel*/
+#endif
 
 /**********************
  *      MACROS
@@ -78,12 +127,12 @@ void lv_refr_now(lv_disp_t * disp)
 #endif
 
     if(disp) {
-        lv_disp_refr_task(disp->refr_task);
+        lv_refr_disp(disp);
     } else {
         lv_disp_t * d;
         d = lv_disp_get_next(NULL);
         while(d) {
-            lv_disp_refr_task(d->refr_task);
+            lv_refr_disp(d);
             d = lv_disp_get_next(d);
         }
     }
@@ -121,20 +170,7 @@ void lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     if(suc != false) {
         if(disp->driver.rounder_cb) disp->driver.rounder_cb(&disp->driver, &com_area);
 
-        /*Save only if this area is not in one of the saved areas*/
-        uint16_t i;
-        for(i = 0; i < disp->inv_p; i++) {
-            if(lv_area_is_in(&com_area, &disp->inv_areas[i]) != false) return;
-        }
-
-        /*Save the area*/
-        if(disp->inv_p < LV_INV_BUF_SIZE) {
-            lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
-        } else { /*If no place for the area add the screen*/
-            disp->inv_p = 0;
-            lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
-        }
-        disp->inv_p++;
+        lv_refr_add_area(disp, &com_area);
 		lv_task_set_prio(disp->refr_task, LV_REFR_TASK_PRIO);
     }
 }
@@ -164,113 +200,416 @@ void lv_refr_set_disp_refreshing(lv_disp_t * disp)
  * @param task pointer to the task itself
  */
 void lv_disp_refr_task(lv_task_t * task)
+{
+    lv_disp_t * disp = task->user_data;
+
+#if LV_USE_VSYNC
+    /*Render only on the vsync when the next frame is due*/
+    if(lv_refr_vsync_check(disp) == false) return;
+
+#if LV_USE_ANIMATION
+    /*Evaluate the animations once per frame. They invalidate what they change.*/
+    lv_anim_refr_now();
+#endif
+
+    uint32_t start = lv_tick_get();
+    if(lv_refr_disp(disp)) lv_refr_vsync_adapt(disp, lv_tick_elaps(start));
+
+    /*The task is the frame clock: keep checking the vsyncs even if nothing has changed*/
+    lv_task_set_prio(task, LV_REFR_TASK_PRIO);
+#else
+    lv_refr_disp(disp);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Refresh the invalidated areas of a display
+ * @param disp pointer to a display
+ * @return true: something was refreshed; false: there was nothing to refresh
+ */
+static bool lv_refr_disp(lv_disp_t * disp)
 {
     LV_LOG_TRACE("lv_refr_task: started");
 
     uint32_t start = lv_tick_get();
+    bool refreshed = false;
+    LV_PROFILER_BEGIN(prof_start);
 
 	/* Ensure the task does not run again automatically.
      * This is done before refreshing in case refreshing invalidates something else.
      */
-	lv_task_set_prio(task, LV_TASK_PRIO_OFF);
+	lv_task_set_prio(disp->refr_task, LV_TASK_PRIO_OFF);
+
+    disp_refr = disp;
 
-    disp_refr = task->user_data;
+#if LV_USE_LAYER_CACHE
+    lv_layer_cache_new_frame();
+#endif
+
+#if LV_USE_RADIUS_CACHE
+    lv_draw_mask_radius_cache_new_frame();
+#endif
 
-    lv_refr_join_area();
+    lv_img_cache_new_frame();
 
+    lv_refr_join_area(disp_refr, LV_INV_BUF_SIZE);
+
+    /*With screen sized buffers also redraw what changed since the buffer was rendered*/
+    if(disp_refr->inv_p != 0 && lv_disp_is_true_double_buf(disp_refr)) {
+        lv_refr_add_history(disp_refr);
+        lv_refr_join_area(disp_refr, LV_INV_BUF_SIZE);
+    }
+
+    LV_PROFILER_BEGIN(prof_render);
     lv_refr_areas();
+    LV_PROFILER_END("render", prof_render);
 
     /*If refresh happened ...*/
     if(disp_refr->inv_p != 0) {
-        /*In true double buffered mode copy the refreshed areas to the new VDB to keep it up to
-         * date*/
+        /* In true double buffered mode flush the whole frame now.
+         * The flushing should be only the address change of the frame buffer and
+         * the buffer is rendered again only when an other one is displayed.*/
         if(lv_disp_is_true_double_buf(disp_refr)) {
-            lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
-
-            /*Flush the content of the VDB*/
+            lv_refr_update_age(disp_refr);
             lv_refr_vdb_flush();
-
-            /* With true double buffering the flushing should be only the address change of the
-             * current frame buffer. Wait until the address change is ready and copy the changed
-             * content to the other frame buffer (new active VDB) to keep the buffers synchronized*/
-            while(vdb->flushing)
-                ;
-
-            uint8_t * buf_act = (uint8_t *)vdb->buf_act;
-            uint8_t * buf_ina = (uint8_t *)vdb->buf_act == vdb->buf1 ? vdb->buf2 : vdb->buf1;
-
-            lv_coord_t hres = lv_disp_get_hor_res(disp_refr);
-            uint16_t a;
-            for(a = 0; a < disp_refr->inv_p; a++) {
-                if(disp_refr->inv_area_joined[a] == 0) {
-                    lv_coord_t y;
-                    uint32_t start_offs =
-                        (hres * disp_refr->inv_areas[a].y1 + disp_refr->inv_areas[a].x1) * sizeof(lv_color_t);
-                    uint32_t line_length = lv_area_get_width(&disp_refr->inv_areas[a]) * sizeof(lv_color_t);
-
-                    for(y = disp_refr->inv_areas[a].y1; y <= disp_refr->inv_areas[a].y2; y++) {
-                        memcpy(buf_act + start_offs, buf_ina + start_offs, line_length);
-                        start_offs += hres * sizeof(lv_color_t);
-                    }
-                }
-            }
-        } /*End of true double buffer handling*/
+        }
 
         /*Clean up*/
         memset(disp_refr->inv_areas, 0, sizeof(disp_refr->inv_areas));
-        memset(disp_refr->inv_area_joined, 0, sizeof(disp_refr->inv_area_joined));
         disp_refr->inv_p = 0;
 
         /*Call monitor cb if present*/
         if(disp_refr->driver.monitor_cb) {
             disp_refr->driver.monitor_cb(&disp_refr->driver, lv_tick_elaps(start), px_num);
         }
+
+        LV_PROFILER_END("refr", prof_start);
+        LV_PROFILER_FRAME();
+
+        refreshed = true;
     }
 
     lv_mem_buf_free_all();
 
     LV_LOG_TRACE("lv_refr_task: ready");
+
+    return refreshed;
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
+#if LV_USE_VSYNC
+/**
+ * Count the simulated vsyncs elapsed since the last check
+ * @param disp pointer to a display
+ */
+static void lv_refr_vsync_update(lv_disp_t * disp)
+{
+    if(disp->driver.vsync_ext) return;
+
+    uint32_t period = disp->driver.vsync_period ? disp->driver.vsync_period : 1;
+    uint32_t elaps  = lv_tick_elaps(disp->vsync_time);
+    if(elaps >= period) {
+        uint32_t n = elaps / period;
+        disp->vsync_cnt += n;
+        disp->vsync_time += n * period;
+    }
+}
+
+/**
+ * Check if a new vsync has arrived and the next frame is due
+ * @param disp pointer to a display
+ * @return true: a frame can be rendered now
+ */
+static bool lv_refr_vsync_check(lv_disp_t * disp)
+{
+    lv_refr_vsync_update(disp);
+
+    uint32_t vsync = disp->vsync_cnt;
+    if(vsync == disp->vsync_last) return false;
+    disp->vsync_last = vsync;
+
+    /*Keep the frame interval to have a steady frame rate*/
+    if(vsync - disp->vsync_frame < disp->frame_stat.interval) return false;
+
+    disp->vsync_frame = vsync;
+    return true;
+}
+
+/**
+ * Adapt the frame interval to the render time after rendering a frame.
+ * If the frame missed its deadline (the vsync of the next frame) render frames less often.
+ * If the frames are rendered fast for a while render them more often again.
+ * @param disp pointer to a display
+ * @param render_time time of rendering the last frame [ms]
+ */
+static void lv_refr_vsync_adapt(lv_disp_t * disp, uint32_t render_time)
+{
+    lv_disp_frame_stat_t * stat = &disp->frame_stat;
+    stat->frame_cnt++;
+    stat->render_time = render_time;
+
+    /*Missed if the vsync of the next frame has already arrived*/
+    lv_refr_vsync_update(disp);
+    if(disp->vsync_cnt - disp->vsync_frame >= stat->interval) {
+        stat->miss_cnt++;
+        disp->fast_cnt = 0;
+        if(stat->interval < LV_VSYNC_MAX_INTERVAL) stat->interval++;
+        LV_LOG_TRACE("lv_refr_task: frame deadline missed");
+        return;
+    }
+
+    /*Fast: it would fit into a shorter interval with some margin*/
+    uint32_t period = disp->driver.vsync_period;
+    if(stat->interval > 1 && render_time * 4 < (stat->interval - 1) * period * 3) {
+        disp->fast_cnt++;
+        if(disp->fast_cnt >= VSYNC_FAST_FRAME_CNT) {
+            stat->interval--;
+            disp->fast_cnt = 0;
+        }
+    } else {
+        disp->fast_cnt = 0;
+    }
+}
+#endif
+
+/**
+ * Save an area to the invalidated areas of a display if it's not saved yet
+ * @param disp pointer to a display
+ * @param area_p pointer to an area already truncated to the screen and rounded
+ */
+static void lv_refr_add_area(lv_disp_t * disp, const lv_area_t * area_p)
+{
+    /*Save only if this area is not in one of the saved areas*/
+    uint16_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(lv_area_is_in(area_p, &disp->inv_areas[i]) != false) return;
+    }
+
+    /*If there is no place for the area enlarge the saved area where it's the cheapest.
+     *The areas are made disjoint and optimized only once per frame in `lv_refr_join_area`.*/
+    if(disp->inv_p >= LV_INV_BUF_SIZE) {
+        uint16_t best_i = 0;
+        uint32_t best_cost = UINT32_MAX;
+        lv_area_t best_area;
+        for(i = 0; i < disp->inv_p; i++) {
+            const lv_area_t * a = &disp->inv_areas[i];
+            lv_area_t merged;
+            merged.x1 = LV_MATH_MIN(a->x1, area_p->x1);
+            merged.y1 = LV_MATH_MIN(a->y1, area_p->y1);
+            merged.x2 = LV_MATH_MAX(a->x2, area_p->x2);
+            merged.y2 = LV_MATH_MAX(a->y2, area_p->y2);
+
+            uint32_t cost = lv_refr_area_cost(&merged, disp) - lv_refr_area_cost(a, disp);
+            if(cost < best_cost) {
+                best_cost = cost;
+                best_i    = i;
+                lv_area_copy(&best_area, &merged);
+            }
+        }
+
+        lv_area_copy(&disp->inv_areas[best_i], &best_area);
+        return;
+    }
+
+    /*Save the area*/
+    lv_area_copy(&disp->inv_areas[disp->inv_p], area_p);
+    disp->inv_p++;
+}
 
 /**
- * Join the areas which has got common parts
+ * Make the invalidated areas of a display disjoint and merge them where rendering
+ * the extra pixels is cheaper than refreshing one more area.
+ * @param disp pointer to a display
+ * @param max_cnt merge the areas anyway until there are not more areas than this
  */
-static void lv_refr_join_area(void)
+static void lv_refr_join_area(lv_disp_t * disp, uint16_t max_cnt)
 {
-    uint32_t join_from;
-    uint32_t join_in;
-    lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
+    if(disp->inv_p <= 1) return;
+
+    lv_area_t * buf = lv_mem_buf_get(sizeof(lv_area_t) * LV_INV_BUF_SIZE);
+    if(buf == NULL) {
+        /*The areas might overlap, so refresh the whole screen instead*/
+        disp->inv_areas[0].x1 = 0;
+        disp->inv_areas[0].y1 = 0;
+        disp->inv_areas[0].x2 = lv_disp_get_hor_res(disp) - 1;
+        disp->inv_areas[0].y2 = lv_disp_get_ver_res(disp) - 1;
+        disp->inv_p = 1;
+        return;
+    }
 
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
+    LV_PROFILER_BEGIN(prof_start);
+
+    /*Cutting many overlapping areas would give a lot of pieces to merge again*/
+    lv_refr_merge_overlap(disp);
+
+    lv_region_t reg;
+    lv_region_init(&reg, buf, LV_INV_BUF_SIZE);
+
+    /*The areas are already rounded and cutting them with each other keeps them aligned*/
+    uint16_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(lv_region_union(&reg, &disp->inv_areas[i]) == false) {
+            /*No room for the parts of the area: add it together with the area where it's the cheapest.
+             *The bounding box covers that area so there is room for it.*/
+            uint16_t k;
+            uint32_t best_cost = UINT32_MAX;
+            lv_area_t best_area;
+            for(k = 0; k < reg.cnt; k++) {
+                lv_area_t joined;
+                lv_area_join(&joined, &reg.areas[k], &disp->inv_areas[i]);
+                uint32_t cost = lv_refr_area_cost(&joined, disp) - lv_refr_area_cost(&reg.areas[k], disp);
+                if(cost < best_cost) {
+                    best_cost = cost;
+                    lv_area_copy(&best_area, &joined);
+                }
             }
+            lv_region_union(&reg, &best_area);
+        }
+    }
+
+    lv_region_optimize(&reg, max_cnt, lv_refr_area_cost, disp);
+
+    memcpy(disp->inv_areas, reg.areas, reg.cnt * sizeof(lv_area_t));
+    disp->inv_p = reg.cnt;
+
+    lv_mem_buf_release(buf);
+
+    LV_PROFILER_END("join", prof_start);
+}
+
+/**
+ * Merge the overlapping invalidated areas of a display where refreshing their bounding box is not
+ * more expensive than refreshing both of them. Quick compared to `lv_region_optimize`.
+ * @param disp pointer to a display
+ */
+static void lv_refr_merge_overlap(lv_disp_t * disp)
+{
+    bool merged;
+    do {
+        merged = false;
+        uint16_t i;
+        for(i = 0; i < disp->inv_p; i++) {
+            uint16_t j = i + 1;
+            while(j < disp->inv_p) {
+                lv_area_t * a = &disp->inv_areas[i];
+                lv_area_t * b = &disp->inv_areas[j];
+                lv_area_t joined;
+                lv_area_join(&joined, a, b);
+                if(lv_area_is_on(a, b) == false ||
+                   lv_refr_area_cost(&joined, disp) > lv_refr_area_cost(a, disp) + lv_refr_area_cost(b, disp)) {
+                    j++;
+                    continue;
+                }
 
-            /*Check if the areas are on each other*/
-            if(lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
+                /*Replace `a` with the bounding box and `b` with the last area*/
+                lv_area_copy(a, &joined);
+                disp->inv_p--;
+                lv_area_copy(b, &disp->inv_areas[disp->inv_p]);
+                merged = true;
             }
+        }
+    } while(merged);
+}
+
+/**
+ * With screen sized buffers add the areas changed since the buffer to render was last rendered
+ * (or the whole screen if it's unknown), and save the current areas to the history.
+ * @param disp pointer to a display
+ */
+static void lv_refr_add_history(lv_disp_t * disp)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+
+    lv_area_t scr_area;
+    scr_area.x1 = 0;
+    scr_area.y1 = 0;
+    scr_area.x2 = lv_disp_get_hor_res(disp) - 1;
+    scr_area.y2 = lv_disp_get_ver_res(disp) - 1;
 
-            lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+    /*Save the areas of this frame in a compact form (or the whole screen if there is no memory)*/
+    lv_area_t * buf = lv_mem_buf_get(sizeof(lv_area_t) * LV_INV_BUF_SIZE);
+    lv_region_t reg;
+    uint16_t i;
+    if(buf) {
+        lv_region_init(&reg, buf, LV_INV_BUF_SIZE);
+        for(i = 0; i < disp->inv_p; i++) {
+            lv_region_union(&reg, &disp->inv_areas[i]);
+        }
+        lv_region_optimize(&reg, LV_INV_HISTORY_SIZE, lv_refr_area_cost, disp);
+    } else {
+        lv_region_init(&reg, &scr_area, 1);
+        reg.cnt = 1;
+    }
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+    /*Get how many frames ago the buffer was rendered*/
+    uint8_t age;
+    if(disp->driver.buf_age_cb) age = disp->driver.buf_age_cb(&disp->driver, vdb->buf_act);
+    else age = vdb->slot[vdb->buf_act_id].age;
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
+    /*The buffer misses the areas of the last `age - 1` frames*/
+    if(age == 0 || age > LV_DISP_BUF_MAX_NUM || buf == NULL) {
+        lv_refr_add_area(disp, &scr_area);
+    } else {
+        uint8_t f;
+        for(f = 0; f < age - 1; f++) {
+            for(i = 0; i < disp->inv_history_cnt[f]; i++) {
+                lv_refr_add_area(disp, &disp->inv_history[f][i]);
             }
         }
     }
+
+    /*Shift the history and save the current frame*/
+    uint8_t f;
+    for(f = LV_DISP_BUF_MAX_NUM - 2; f > 0; f--) {
+        memcpy(disp->inv_history[f], disp->inv_history[f - 1], sizeof(disp->inv_history[0]));
+        disp->inv_history_cnt[f] = disp->inv_history_cnt[f - 1];
+    }
+    memcpy(disp->inv_history[0], reg.areas, reg.cnt * sizeof(lv_area_t));
+    disp->inv_history_cnt[0] = reg.cnt;
+
+    if(buf) lv_mem_buf_release(buf);
+}
+
+/**
+ * With screen sized buffers make the buffer being rendered the newest, and the others one frame older
+ * @param disp pointer to a display
+ */
+static void lv_refr_update_age(lv_disp_t * disp)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+
+    uint8_t i;
+    for(i = 0; i < vdb->buf_cnt; i++) {
+        if(i == vdb->buf_act_id) vdb->slot[i].age = 1;
+        else if(vdb->slot[i].age != 0 && vdb->slot[i].age < UINT8_MAX) vdb->slot[i].age++;
+    }
+}
+
+/**
+ * Tell the cost of refreshing an area: the number of pixels and an overhead for every band
+ * (searching the objects to draw, flushing) in which the area is refreshed
+ * @param area_p pointer to an area
+ * @param user_data pointer to the display
+ * @return the cost of the area in pixels
+ */
+static uint32_t lv_refr_area_cost(const lv_area_t * area_p, void * user_data)
+{
+    lv_disp_t * disp = user_data;
+    uint32_t w = lv_area_get_width(area_p);
+    uint32_t h = lv_area_get_height(area_p);
+    uint32_t band_cnt = 1;
+
+    if(lv_disp_is_true_double_buf(disp) == false) {
+        lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+        uint32_t max_row = vdb->size / w;
+        if(max_row == 0) max_row = 1;
+        band_cnt = (h + max_row - 1) / max_row;
+    }
+
+    return w * h + band_cnt * LV_REFR_BAND_COST;
 }
 
 /**
@@ -282,13 +621,9 @@ static void lv_refr_areas(void)
     uint32_t i;
 
     for(i = 0; i < disp_refr->inv_p; i++) {
-        /*Refresh the unjoined areas*/
-        if(disp_refr->inv_area_joined[i] == 0) {
-
-            lv_refr_area(&disp_refr->inv_areas[i]);
+        lv_refr_area(&disp_refr->inv_areas[i]);
 
-            if(disp_refr->driver.monitor_cb) px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
-        }
+        if(disp_refr->driver.monitor_cb) px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
     }
 }
 
@@ -386,29 +721,27 @@ static void lv_refr_area_part(const lv_area_t * area_p)
 
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
 
-    /*In non double buffered mode, before rendering the next part wait until the previous image is
-     * flushed*/
-    if(lv_disp_is_double_buf(disp_refr) == false) {
-        while(vdb->flushing)
-            ;
-    }
-
-    lv_obj_t * top_p;
+    /*Before rendering wait until the buffer's previous content is flushed.
+     *With more buffers the other ones can be flushed meanwhile.*/
+    lv_refr_wait_slot(vdb->buf_act_id);
 
     /*Get the new mask from the original area and the act. VDB
      It will be a part of 'area_p'*/
     lv_area_t start_mask;
     lv_area_intersect(&start_mask, area_p, &vdb->area);
 
-    /*Get the most top object which is not covered by others*/
-    top_p = lv_refr_get_top_obj(&start_mask, lv_disp_get_scr_act(disp_refr));
+#if LV_USE_LAYER_CACHE
+    lv_refr_layer_cache_prepare(&start_mask);
+#endif
 
-    /*Do the refreshing from the top object*/
-    lv_refr_obj_and_children(top_p, &start_mask);
+    /*Get the most top object which is not covered by others*/
+    lv_obj_t * top_p = lv_refr_get_top_obj(&start_mask, lv_disp_get_scr_act(disp_refr));
 
-    /*Also refresh top and sys layer unconditionally*/
-    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), &start_mask);
-    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), &start_mask);
+#if LV_USE_PARALLEL_DRAW
+    if(lv_refr_parallel(top_p, &start_mask) == false) lv_refr_slice(top_p, &start_mask);
+#else
+    lv_refr_slice(top_p, &start_mask);
+#endif
 
     /* In true double buffered mode flush only once when all areas were rendered.
      * In normal mode flush after every area */
@@ -417,6 +750,80 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     }
 }
 
+/**
+ * Refresh the screen and the layers on an area of the actual Virtual Display Buffer
+ * @param top_p the most top object which fully covers `mask_p` (can be NULL)
+ * @param mask_p pointer to an area to refresh. Only this area of the VDB is modified.
+ */
+static void lv_refr_slice(lv_obj_t * top_p, const lv_area_t * mask_p)
+{
+#if LV_USE_DRAW_BACKEND
+    /*Record the drawings of the slice and execute them together with the draw backend*/
+    lv_draw_backend_begin(disp_refr);
+#endif
+
+    /*Do the refreshing from the top object*/
+    lv_refr_obj_and_children(top_p, mask_p);
+
+    /*Also refresh top and sys layer unconditionally*/
+    lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), mask_p);
+    lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), mask_p);
+
+#if LV_USE_DRAW_BACKEND
+    lv_draw_backend_end();
+#endif
+}
+
+#if LV_USE_PARALLEL_DRAW
+/**
+ * Split an area into horizontal slices and render them in parallel with the driver's `parallel_cb`
+ * @param top_p the most top object which fully covers `area_p` (can be NULL)
+ * @param area_p pointer to an area to refresh
+ * @return true: the area is refreshed; false: parallel rendering is not possible, refresh it in one piece
+ */
+static bool lv_refr_parallel(lv_obj_t * top_p, const lv_area_t * area_p)
+{
+    lv_disp_drv_t * drv = &disp_refr->driver;
+    if(drv->parallel_cb == NULL) return false;
+
+    /*Don't make too thin slices because every slice has to redraw the objects on it*/
+    lv_coord_t h = lv_area_get_height(area_p);
+    uint16_t slice_cnt = LV_MATH_MIN(drv->slice_cnt, PARALLEL_SLICE_MAX);
+    if(slice_cnt > h / PARALLEL_SLICE_MIN_H) slice_cnt = h / PARALLEL_SLICE_MIN_H;
+    if(slice_cnt < 2) return false;
+
+    lv_area_t slices[PARALLEL_SLICE_MAX];
+    uint16_t i;
+    for(i = 0; i < slice_cnt; i++) {
+        slices[i].x1 = area_p->x1;
+        slices[i].x2 = area_p->x2;
+        slices[i].y1 = area_p->y1 + (int32_t)h * i / slice_cnt;
+        slices[i].y2 = area_p->y1 + (int32_t)h * (i + 1) / slice_cnt - 1;
+    }
+
+    /*Search the top object only once, here. The cover check might see the temporal
+     *style modifications of the objects being drawn on the other threads.*/
+    parallel_top_p = top_p;
+    drv->parallel_cb(drv, lv_refr_parallel_job, slices, slice_cnt);
+
+    return true;
+}
+
+/**
+ * Render a slice. Called by the display driver's `parallel_cb` on any thread.
+ * @param slice pointer to the area to refresh
+ */
+static void lv_refr_parallel_job(const lv_area_t * slice)
+{
+    lv_refr_slice(parallel_top_p, slice);
+
+    LV_PROFILER_COLLECT();
+
+    /*The temporal buffers are allocated for every thread separately. Don't keep them.*/
+    lv_mem_buf_free_all();
+}
+#endif
+
 /**
  * Search the most top object which fully covers an area
  * @param area_p pointer to an area
@@ -433,6 +840,10 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
         if(design_res == LV_DESIGN_RES_MASKED) return NULL;
 
         lv_obj_t * i;
+#if LV_USE_LAYER_CACHE
+        /*The children of a cached object are drawn from the cache together with the object*/
+        if(obj->layer_cache == NULL)
+#endif
         LV_LL_READ(obj->child_ll, i)
         {
             found_p = lv_refr_get_top_obj(area_p, i);
@@ -487,7 +898,7 @@ static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p)
 
         while(i != NULL) {
             /*Refresh the objects*/
-            lv_refr_obj(i, mask_p);
+            lv_refr_obj_visible(i, mask_p);
             i = lv_ll_get_prev(&(par->child_ll), i);
         }
 
@@ -502,6 +913,101 @@ static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p)
     }
 }
 
+/**
+ * Refresh an object and its children only on those parts of an area
+ * which are not covered by the younger siblings of the object.
+ * @param obj pointer to an object to refresh
+ * @param mask_p pointer to an area, the object will be drawn only here
+ */
+static void lv_refr_obj_visible(lv_obj_t * obj, const lv_area_t * mask_p)
+{
+    /*Do not refresh hidden objects*/
+    if(obj->hidden != 0) return;
+
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    if(par == NULL) {
+        lv_refr_obj(obj, mask_p);
+        return;
+    }
+
+    lv_area_t areas[OCCLUSION_AREA_MAX];
+    lv_region_t reg;
+    lv_region_init(&reg, areas, OCCLUSION_AREA_MAX);
+    lv_region_union(&reg, mask_p);
+
+    /*The younger siblings are drawn later, i.e. on the object.
+     *Cut out the parts they cover. Check only the youngest ones to keep it fast with many children.*/
+    lv_obj_t * sib = lv_ll_get_head(&par->child_ll);
+    uint16_t sib_cnt = 0;
+    while(sib != NULL && sib != obj && sib_cnt < OCCLUSION_SIBLING_MAX) {
+        lv_area_t cover[2];
+        uint8_t cover_cnt = lv_refr_get_cover_areas(sib, mask_p, cover);
+        uint8_t i;
+        for(i = 0; i < cover_cnt; i++) {
+            lv_region_subtract(&reg, &cover[i]);
+        }
+
+        /*Fully covered, nothing to draw*/
+        if(reg.cnt == 0) return;
+
+        sib = lv_ll_get_next(&par->child_ll, sib);
+        sib_cnt++;
+    }
+
+    uint16_t i;
+    for(i = 0; i < reg.cnt; i++) {
+        lv_refr_obj(obj, &reg.areas[i]);
+    }
+}
+
+/**
+ * Get the areas of a mask which are fully covered by an object.
+ * Only large enough areas are reported to not split the objects below into too small parts.
+ * @param obj pointer to an object
+ * @param mask_p pointer to an area
+ * @param cover store the covered areas here (max. 2)
+ * @return number of covered areas in `cover`
+ */
+static uint8_t lv_refr_get_cover_areas(lv_obj_t * obj, const lv_area_t * mask_p, lv_area_t cover[])
+{
+    if(obj->hidden != 0) return 0;
+    if(lv_area_is_on(&obj->coords, mask_p) == false) return 0;
+
+    const lv_style_t * style = lv_obj_get_style(obj);
+    if(style->body.opa != LV_OPA_COVER ||
+       style->body.blend_mode != LV_BLEND_MODE_NORMAL ||
+       style->body.border.blend_mode != LV_BLEND_MODE_NORMAL ||
+       style->image.blend_mode != LV_BLEND_MODE_NORMAL) {
+        return 0;
+    }
+
+    lv_coord_t r = style->body.radius;
+    if(r == LV_RADIUS_CIRCLE) return 0;
+
+    if(lv_obj_get_opa_scale(obj) != LV_OPA_COVER) return 0;
+
+    /*Because of the radius only the horizontal and vertical bands without the corners can cover*/
+    lv_area_t band[2];
+    lv_obj_get_coords(obj, &band[0]);
+    band[0].x1 += r;
+    band[0].x2 -= r;
+    lv_obj_get_coords(obj, &band[1]);
+    band[1].y1 += r;
+    band[1].y2 -= r;
+
+    uint8_t band_cnt = r == 0 ? 1 : 2;
+    uint8_t cnt = 0;
+    uint8_t i;
+    for(i = 0; i < band_cnt; i++) {
+        if(lv_area_intersect(&cover[cnt], &band[i], mask_p) == false) continue;
+        if(lv_area_get_size(&cover[cnt]) < LV_REFR_BAND_COST) continue;
+        if(obj->design_cb(obj, &cover[cnt], LV_DESIGN_COVER_CHK) != LV_DESIGN_RES_COVER) continue;
+        cnt++;
+    }
+
+    return cnt;
+}
+
 /**
  * Refresh an object an all of its children. (Called recursively)
  * @param obj pointer to an object to refresh
@@ -512,6 +1018,14 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
     /*Do not refresh hidden objects*/
     if(obj->hidden != 0) return;
 
+#if LV_USE_LAYER_CACHE
+    /*Draw the object with its children from the cache if it's up-to-date*/
+    if(obj->layer_cache && lv_layer_cache_is_valid(obj->layer_cache)) {
+        lv_refr_layer_cache_blend(obj->layer_cache, mask_ori_p);
+        return;
+    }
+#endif
+
     bool union_ok; /* Store the return value of area_union */
     /* Truncate the original mask to the coordinates of the parent
      * because the parent and its children are visible only here */
@@ -530,7 +1044,9 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
     if(union_ok != false) {
 
         /* Redraw the object */
+        LV_PROFILER_BEGIN(prof_main);
         obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
+        LV_PROFILER_END(lv_refr_get_type_name(obj), prof_main);
 
 #if MASK_AREA_DEBUG
         static lv_color_t debug_color = LV_COLOR_RED;
@@ -547,58 +1063,257 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
         lv_obj_get_coords(obj, &obj_area);
         union_ok = lv_area_intersect(&obj_mask, mask_ori_p, &obj_area);
         if(union_ok != false) {
-            lv_area_t mask_child; /*Mask from obj and its child*/
             lv_obj_t * child_p;
-            lv_area_t child_area;
-            LV_LL_READ_BACK(obj->child_ll, child_p)
+#if LV_USE_OBJ_INDEX
+            /*With many children refresh only the ones on the mask*/
+            lv_obj_index_t * index = lv_obj_index_get(obj);
+            const lv_obj_index_item_t ** found = NULL;
+            if(index) found = lv_mem_buf_get(index->cnt * sizeof(lv_obj_index_item_t *));
+            if(found) {
+                uint16_t found_cnt = lv_obj_index_search(index, obj, &obj_mask, found);
+                uint16_t i;
+                for(i = 0; i < found_cnt; i++) {
+                    lv_refr_child(found[i]->obj, &obj_mask);
+                }
+                lv_mem_buf_release(found);
+            } else
+#endif
             {
-                lv_obj_get_coords(child_p, &child_area);
-                ext_size = child_p->ext_draw_pad;
-                child_area.x1 -= ext_size;
-                child_area.y1 -= ext_size;
-                child_area.x2 += ext_size;
-                child_area.y2 += ext_size;
-                /* Get the union (common parts) of original mask (from obj)
-                 * and its child */
-                union_ok = lv_area_intersect(&mask_child, &obj_mask, &child_area);
-
-                /*If the parent and the child has common area then refresh the child */
-                if(union_ok) {
-                    /*Refresh the next children*/
-                    lv_refr_obj(child_p, &mask_child);
+                LV_LL_READ_BACK(obj->child_ll, child_p)
+                {
+                    lv_refr_child(child_p, &obj_mask);
                 }
             }
         }
 
         /* If all the children are redrawn make 'post draw' design */
+        LV_PROFILER_BEGIN(prof_post);
         obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
+        LV_PROFILER_END(lv_refr_get_type_name(obj), prof_post);
+    }
+}
+
+/**
+ * Refresh a child of an object if it's on the parent's mask
+ * @param child_p pointer to a child object
+ * @param mask_p pointer to the mask of the parent
+ */
+static void lv_refr_child(lv_obj_t * child_p, const lv_area_t * mask_p)
+{
+    lv_area_t mask_child; /*Mask from obj and its child*/
+    lv_area_t child_area;
+    lv_obj_get_coords(child_p, &child_area);
+    lv_coord_t ext_size = child_p->ext_draw_pad;
+    child_area.x1 -= ext_size;
+    child_area.y1 -= ext_size;
+    child_area.x2 += ext_size;
+    child_area.y2 += ext_size;
+    /* Get the union (common parts) of original mask (from obj)
+     * and its child */
+    bool union_ok = lv_area_intersect(&mask_child, mask_p, &child_area);
+
+    /*If the parent and the child has common area then refresh the child */
+    if(union_ok) {
+        /*Refresh the next children*/
+        lv_refr_obj_visible(child_p, &mask_child);
     }
 }
 
 /**
- * Flush the content of the VDB
+ * Queue the content of the VDB for flushing and continue with the next buffer
  */
 static void lv_refr_vdb_flush(void)
 {
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
 
-    /*In double buffered mode wait until the other buffer is flushed before flushing the current
-     * one*/
-    if(lv_disp_is_double_buf(disp_refr)) {
-        while(vdb->flushing)
-            ;
+    lv_disp_buf_slot_t * slot = &vdb->slot[vdb->buf_act_id];
+    lv_area_copy(&slot->area, &vdb->area);
+    slot->queued = 1;
+
+    /*Flush it now if the display is free. Else `lv_disp_flush_ready` will start it*/
+    lv_disp_flush_next(&disp_refr->driver);
+
+    /*Render the next part into the next buffer (if there are more)*/
+    vdb->buf_act_id++;
+    if(vdb->buf_act_id >= vdb->buf_cnt) vdb->buf_act_id = 0;
+    vdb->buf_act = vdb->slot[vdb->buf_act_id].buf;
+}
+
+/**
+ * Wait until a buffer is flushed and can be rendered again.
+ * With screen sized buffers also wait until an other buffer is displayed instead of it.
+ * Call the driver's `wait_cb` meanwhile to not block the CPU.
+ * @param id index of the buffer in the display buffer's `slot` array
+ */
+static void lv_refr_wait_slot(uint8_t id)
+{
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
+    bool front_chk = lv_disp_is_true_double_buf(disp_refr);
+
+    if(vdb->slot[id].queued == 0 && (front_chk == false || vdb->front_id != id)) return;
+
+    LV_PROFILER_BEGIN(prof_start);
+    while(vdb->slot[id].queued || (front_chk && vdb->front_id == id)) {
+        if(disp_refr->driver.wait_cb) disp_refr->driver.wait_cb(&disp_refr->driver);
+    }
+    LV_PROFILER_END("flush_wait", prof_start);
+}
+
+#if LV_USE_LAYER_CACHE
+/**
+ * Render the outdated layer caches which are on an area.
+ * It's done before drawing the area to only read the caches while drawing (maybe in parallel).
+ * @param area_p pointer to the area being refreshed
+ */
+static void lv_refr_layer_cache_prepare(const lv_area_t * area_p)
+{
+    lv_layer_cache_t * cache;
+    LV_LL_READ(LV_GC_ROOT(_lv_layer_cache_ll), cache) {
+        lv_obj_t * obj = cache->obj;
+
+        /*Skip the objects which are not visible on the area*/
+        lv_obj_t * scr = lv_obj_get_screen(obj);
+        if(scr != lv_disp_get_scr_act(disp_refr) && scr != lv_disp_get_layer_top(disp_refr) &&
+           scr != lv_disp_get_layer_sys(disp_refr)) continue;
+
+        lv_area_t layer_area;
+        lv_area_t vis_area;
+        if(lv_layer_cache_get_area(obj, &layer_area) == false) continue;
+        if(lv_area_intersect(&vis_area, &layer_area, area_p) == false) continue;
+
+        bool visible = obj->hidden ? false : true;
+        lv_obj_t * par = lv_obj_get_parent(obj);
+        while(par && visible) {
+            if(par->hidden || lv_area_intersect(&vis_area, &vis_area, &par->coords) == false) visible = false;
+            par = lv_obj_get_parent(par);
+        }
+        if(visible == false) continue;
+
+        lv_layer_cache_touch(cache);
+        if(lv_layer_cache_is_valid(cache)) continue;
+
+#if LV_LAYER_CACHE_ALPHA == 0
+        /*Without alpha channel the object has to cover its whole layer*/
+        const lv_style_t * style = lv_obj_get_style(obj);
+        if(obj->design_cb(obj, &layer_area, LV_DESIGN_COVER_CHK) != LV_DESIGN_RES_COVER ||
+           style->body.opa != LV_OPA_COVER || lv_obj_get_opa_scale(obj) != LV_OPA_COVER ||
+           style->body.blend_mode != LV_BLEND_MODE_NORMAL ||
+           style->body.border.blend_mode != LV_BLEND_MODE_NORMAL ||
+           style->image.blend_mode != LV_BLEND_MODE_NORMAL) continue;
+#endif
+
+        /*If there is no memory for it the object is simply drawn*/
+        if(lv_layer_cache_alloc(cache, &layer_area) == false) continue;
+
+        lv_refr_layer_cache_render(cache);
     }
+}
+
+/**
+ * Render an object and its children into its layer cache
+ * @param cache pointer to a layer cache with allocated buffer
+ */
+static void lv_refr_layer_cache_render(lv_layer_cache_t * cache)
+{
+    LV_PROFILER_BEGIN(prof_start);
+
+    /*Redirect the drawing into the layer's buffer*/
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
+    lv_area_t area_ori;
+    lv_area_copy(&area_ori, &vdb->area);
+    lv_color_t * buf_ori = vdb->buf_act;
+    lv_area_copy(&vdb->area, &cache->area);
+    vdb->buf_act = cache->buf;
+
+#if LV_LAYER_CACHE_ALPHA
+    /*Draw on transparent background to keep the alpha channel*/
+    memset(cache->buf, 0x00, cache->buf_size);
+    uint32_t transp_ori = disp_refr->driver.screen_transp;
+    disp_refr->driver.screen_transp = 1;
+#endif
+
+    lv_refr_obj(cache->obj, &cache->area);
+
+#if LV_LAYER_CACHE_ALPHA
+    disp_refr->driver.screen_transp = transp_ori;
+#endif
+
+    lv_area_copy(&vdb->area, &area_ori);
+    vdb->buf_act = buf_ori;
+    cache->valid = 1;
+
+    LV_PROFILER_END("layer_cache", prof_start);
+}
 
-    vdb->flushing = 1;
+/**
+ * Draw an object and its children from its layer cache
+ * @param cache pointer to a valid layer cache
+ * @param mask_p the object should be drawn only here
+ */
+static void lv_refr_layer_cache_blend(const lv_layer_cache_t * cache, const lv_area_t * mask_p)
+{
+    lv_area_t clip;
+    if(lv_area_intersect(&clip, mask_p, &cache->area) == false) return;
+
+#if LV_LAYER_CACHE_ALPHA == 0 || LV_COLOR_PREMULT
+    /*Blend in one step if there are no masks to apply. (Premultiplied layers are blended with their alpha channel.)*/
+    if(lv_draw_mask_get_cnt() == 0) {
+        lv_blend_map(&clip, &cache->area, cache->buf, NULL, LV_DRAW_MASK_RES_FULL_COVER, LV_OPA_COVER,
+                     LV_BLEND_MODE_NORMAL);
+        return;
+    }
+#endif
 
-    /*Flush the rendered content to the display*/
-    lv_disp_t * disp = lv_refr_get_disp_refreshing();
-    if(disp->driver.flush_cb) disp->driver.flush_cb(&disp->driver, &vdb->area, vdb->buf_act);
+    lv_coord_t layer_w = lv_area_get_width(&cache->area);
+    lv_coord_t clip_w  = lv_area_get_width(&clip);
+    lv_opa_t * mask_buf = lv_mem_buf_get(clip_w);
+    if(mask_buf == NULL) return;
+
+    /*Blend line-by-line with the alpha channel and the masks*/
+    lv_area_t line_map;
+    lv_area_t line_clip;
+    line_map.x1  = cache->area.x1;
+    line_map.x2  = cache->area.x2;
+    line_clip.x1 = clip.x1;
+    line_clip.x2 = clip.x2;
+
+    lv_coord_t y;
+    for(y = clip.y1; y <= clip.y2; y++) {
+        const lv_color_t * map_line = cache->buf + (int32_t)(y - cache->area.y1) * layer_w;
+#if LV_LAYER_CACHE_ALPHA && LV_COLOR_PREMULT == 0
+        const lv_color_t * px = map_line + (clip.x1 - cache->area.x1);
+        lv_coord_t i;
+        for(i = 0; i < clip_w; i++) mask_buf[i] = px[i].ch.alpha;
+#else
+        memset(mask_buf, LV_OPA_COVER, clip_w);
+#endif
+        lv_draw_mask_res_t mask_res = lv_draw_mask_apply(mask_buf, clip.x1, y, clip_w);
+        if(mask_res == LV_DRAW_MASK_RES_FULL_TRANSP) continue;
+#if LV_LAYER_CACHE_ALPHA && LV_COLOR_PREMULT == 0
+        mask_res = LV_DRAW_MASK_RES_CHANGED;
+#endif
 
-    if(vdb->buf1 && vdb->buf2) {
-        if(vdb->buf_act == vdb->buf1)
-            vdb->buf_act = vdb->buf2;
-        else
-            vdb->buf_act = vdb->buf1;
+        line_map.y1  = y;
+        line_map.y2  = y;
+        line_clip.y1 = y;
+        line_clip.y2 = y;
+        lv_blend_map(&line_clip, &line_map, map_line, mask_buf, mask_res, LV_OPA_COVER, LV_BLEND_MODE_NORMAL);
     }
+
+    lv_mem_buf_release(mask_buf);
+}
+#endif
+
+#if LV_USE_PROFILER
+/**
+ * Get the type of an object to name its drawing events
+ * @param obj pointer to an object
+ * @return the type as a static string, e.g. "lv_btn"
+ */
+static const char * lv_refr_get_type_name(lv_obj_t * obj)
+{
+    lv_obj_type_t type;
+    lv_obj_get_type(obj, &type);
+    return type.type[0] ? type.type[0] : "lv_obj";
 }
+#endif
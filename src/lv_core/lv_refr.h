@@ -22,6 +22,12 @@ extern "C" {
 
 #define LV_REFR_TASK_PRIO LV_TASK_PRIO_MID
 
+/*The overhead of refreshing one more band of an invalidated area, in pixels.
+ *Invalidated areas are merged if refreshing the extra pixels is cheaper.*/
+#ifndef LV_REFR_BAND_COST
+#define LV_REFR_BAND_COST 512
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -28,6 +28,10 @@ extern "C" {
 #include "lv_draw_blend.h"
 #include "lv_draw_mask.h"
 
+#if LV_USE_PARALLEL_DRAW
+#include LV_PARALLEL_DRAW_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -48,6 +52,18 @@ extern "C" {
  *      MACROS
  **********************/
 
+/**
+ * Protect the shared resources (e.g. caches and decoders) from the other drawing threads.
+ * Keep the locked part short and never draw or take the lock again in it.
+ */
+#if LV_USE_PARALLEL_DRAW
+#define LV_DRAW_LOCK()      LV_PARALLEL_DRAW_LOCK()
+#define LV_DRAW_UNLOCK()    LV_PARALLEL_DRAW_UNLOCK()
+#else
+#define LV_DRAW_LOCK()
+#define LV_DRAW_UNLOCK()
+#endif
+
 /**********************
  *   POST INCLUDES
  *********************/
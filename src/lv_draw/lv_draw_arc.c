@@ -8,6 +8,7 @@
  *********************/
 #include "lv_draw_arc.h"
 #include "lv_draw_mask.h"
+#include "lv_draw_backend.h"
 #include "../lv_misc/lv_math.h"
 
 /*********************
@@ -72,6 +73,13 @@ static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t tickness,
 void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius, const lv_area_t * clip_area,
         uint16_t start_angle, uint16_t end_angle, const lv_style_t * style, lv_opa_t opa_scale)
 {
+#if LV_USE_DRAW_BACKEND
+    if(lv_draw_backend_add_arc(center_x, center_y, radius, clip_area, start_angle, end_angle, style, opa_scale) ==
+       LV_RES_OK) {
+        return;
+    }
+#endif
+
     lv_style_t circle_style;
     lv_style_copy(&circle_style, style);
     circle_style.body.radius = LV_RADIUS_CIRCLE;
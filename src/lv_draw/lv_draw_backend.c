@@ -0,0 +1,337 @@
+/**
+ * @file lv_draw_backend.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_backend.h"
+
+#if LV_USE_DRAW_BACKEND != 0
+
+#include <string.h>
+#include "lv_draw.h"
+#include "../lv_core/lv_refr.h"
+#include "../lv_misc/lv_profiler.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** The commands recorded since the last sync point*/
+typedef struct
+{
+    lv_draw_backend_t * backend;    /*NULL if not recording*/
+    lv_draw_cmd_t cmd[LV_DRAW_BACKEND_CMD_NUM];
+    char txt[LV_DRAW_BACKEND_TXT_SIZE];
+    uint16_t cmd_cnt;
+    uint16_t txt_used;
+} lv_draw_queue_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_draw_cmd_t * cmd_add(lv_draw_cmd_type_t type, const lv_area_t * clip, const lv_style_t * style,
+                               lv_opa_t opa_scale, const char * txt, const char ** txt_copy);
+static void sw_submit(lv_draw_backend_t * backend, const lv_draw_batch_t * batch);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static LV_THREAD_LOCAL lv_draw_queue_t queue;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize a CPU only reference backend. It executes the batches synchronously.
+ * Useful to test the command queue or as a base of an other backend.
+ * @param backend pointer to a backend to initialize
+ */
+void lv_draw_backend_sw_init(lv_draw_backend_t * backend)
+{
+    memset(backend, 0, sizeof(lv_draw_backend_t));
+    backend->submit_cb = sw_submit;
+}
+
+/**
+ * Execute a batch of commands. The ones not supported by the backend are drawn with the CPU.
+ * Should be called from the backend's `submit_cb` while the display is being refreshed.
+ * @param backend pointer to a draw backend
+ * @param batch pointer to a batch
+ */
+void lv_draw_backend_exec(lv_draw_backend_t * backend, const lv_draw_batch_t * batch)
+{
+    uint16_t i;
+    for(i = 0; i < batch->cmd_cnt; i++) {
+        const lv_draw_cmd_t * cmd = &batch->cmd[i];
+        lv_res_t res = LV_RES_INV;
+        switch(cmd->type) {
+            case LV_DRAW_CMD_RECT:
+                if(backend->rect_cb) res = backend->rect_cb(backend, batch, cmd);
+                if(res != LV_RES_OK) lv_draw_rect(&cmd->p.rect.coords, &cmd->clip, &cmd->style, cmd->opa_scale);
+                break;
+            case LV_DRAW_CMD_IMG:
+                if(backend->img_cb) res = backend->img_cb(backend, batch, cmd);
+                if(res != LV_RES_OK) {
+                    lv_point_t pivot = cmd->p.img.pivot;
+                    lv_draw_img(&cmd->p.img.coords, &cmd->clip, cmd->p.img.src, &cmd->style, cmd->p.img.angle,
+                                cmd->p.img.has_pivot ? &pivot : NULL, cmd->p.img.zoom, cmd->p.img.antialias,
+                                cmd->opa_scale);
+                }
+                break;
+            case LV_DRAW_CMD_LABEL:
+                if(backend->label_cb) res = backend->label_cb(backend, batch, cmd);
+                if(res != LV_RES_OK) {
+                    lv_point_t offset = cmd->p.label.offset;
+                    lv_draw_label_txt_sel_t sel = cmd->p.label.sel;
+                    lv_draw_label(&cmd->p.label.coords, &cmd->clip, &cmd->style, cmd->opa_scale, cmd->p.label.txt,
+                                  cmd->p.label.flag, cmd->p.label.has_offset ? &offset : NULL,
+                                  cmd->p.label.has_sel ? &sel : NULL, cmd->p.label.hint, cmd->p.label.bidi_dir);
+                }
+                break;
+            case LV_DRAW_CMD_LINE:
+                if(backend->line_cb) res = backend->line_cb(backend, batch, cmd);
+                if(res != LV_RES_OK) lv_draw_line(&cmd->p.line.p1, &cmd->p.line.p2, &cmd->clip, &cmd->style,
+                                                      cmd->opa_scale);
+                break;
+            case LV_DRAW_CMD_ARC:
+                if(backend->arc_cb) res = backend->arc_cb(backend, batch, cmd);
+                if(res != LV_RES_OK) lv_draw_arc(cmd->p.arc.center.x, cmd->p.arc.center.y, cmd->p.arc.radius, &cmd->clip,
+                                                     cmd->p.arc.start_angle, cmd->p.arc.end_angle, &cmd->style,
+                                                     cmd->opa_scale);
+                break;
+            default:
+                LV_LOG_WARN("lv_draw_backend_exec: unknown command type");
+                break;
+        }
+    }
+}
+
+/**
+ * Start recording the drawing into the command queue if the display has a draw backend.
+ * The refresher calls it for every band (or slice) of the display buffer.
+ * @param disp pointer to the display being refreshed
+ */
+void lv_draw_backend_begin(lv_disp_t * disp)
+{
+    queue.backend  = disp->driver.draw_backend;
+    queue.cmd_cnt  = 0;
+    queue.txt_used = 0;
+}
+
+/**
+ * Execute the recorded commands and stop recording
+ */
+void lv_draw_backend_end(void)
+{
+    lv_draw_backend_sync();
+    queue.backend = NULL;
+}
+
+/**
+ * Sync point: submit the recorded commands and wait until the backend draws them.
+ * It's called before anything is drawn directly into the buffer to keep the order of drawing.
+ */
+void lv_draw_backend_sync(void)
+{
+    lv_draw_backend_t * backend = queue.backend;
+    if(backend == NULL || queue.cmd_cnt == 0) return;
+
+    LV_PROFILER_BEGIN(prof_start);
+
+    lv_disp_buf_t * vdb = lv_disp_get_buf(lv_refr_get_disp_refreshing());
+    lv_draw_batch_t batch;
+    batch.buf     = vdb->buf_act;
+    batch.cmd     = queue.cmd;
+    batch.cmd_cnt = queue.cmd_cnt;
+    lv_area_copy(&batch.buf_area, &vdb->area);
+
+    /*Don't record the drawings of the CPU fallback*/
+    queue.backend = NULL;
+
+    if(backend->submit_cb) backend->submit_cb(backend, &batch);
+    else lv_draw_backend_exec(backend, &batch);
+
+    if(backend->sync_cb) backend->sync_cb(backend);
+
+    queue.backend  = backend;
+    queue.cmd_cnt  = 0;
+    queue.txt_used = 0;
+
+    LV_PROFILER_END("draw_backend", prof_start);
+}
+
+/**
+ * Record a rectangle drawing. Called by `lv_draw_rect` with its parameters.
+ * @return LV_RES_OK: recorded; LV_RES_INV: not recording (or masks are applied), draw it now
+ */
+lv_res_t lv_draw_backend_add_rect(const lv_area_t * coords, const lv_area_t * clip, const lv_style_t * style,
+                                  lv_opa_t opa_scale)
+{
+    lv_draw_cmd_t * cmd = cmd_add(LV_DRAW_CMD_RECT, clip, style, opa_scale, NULL, NULL);
+    if(cmd == NULL) return LV_RES_INV;
+
+    lv_area_copy(&cmd->p.rect.coords, coords);
+
+    return LV_RES_OK;
+}
+
+/**
+ * Record an image drawing. Called by `lv_draw_img` with its parameters.
+ * @return LV_RES_OK: recorded; LV_RES_INV: not recording (or masks are applied), draw it now
+ */
+lv_res_t lv_draw_backend_add_img(const lv_area_t * coords, const lv_area_t * clip, const void * src,
+                                 const lv_style_t * style, uint16_t angle, const lv_point_t * pivot, uint16_t zoom,
+                                 bool antialias, lv_opa_t opa_scale)
+{
+    /*The path and symbol sources might be temporal strings*/
+    const char * txt = lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE ? NULL : src;
+    const char * txt_copy = NULL;
+    lv_draw_cmd_t * cmd = cmd_add(LV_DRAW_CMD_IMG, clip, style, opa_scale, txt, &txt_copy);
+    if(cmd == NULL) return LV_RES_INV;
+
+    lv_area_copy(&cmd->p.img.coords, coords);
+    cmd->p.img.src       = txt ? txt_copy : src;
+    cmd->p.img.angle     = angle;
+    cmd->p.img.zoom      = zoom;
+    cmd->p.img.antialias = antialias ? 1 : 0;
+    cmd->p.img.has_pivot = pivot ? 1 : 0;
+    if(pivot) cmd->p.img.pivot = *pivot;
+
+    return LV_RES_OK;
+}
+
+/**
+ * Record a label drawing. Called by `lv_draw_label` with its parameters.
+ * @return LV_RES_OK: recorded; LV_RES_INV: not recording (or masks are applied), draw it now
+ */
+lv_res_t lv_draw_backend_add_label(const lv_area_t * coords, const lv_area_t * clip, const lv_style_t * style,
+                                   lv_opa_t opa_scale, const char * txt, lv_txt_flag_t flag,
+                                   const lv_point_t * offset, const lv_draw_label_txt_sel_t * sel,
+                                   lv_draw_label_hint_t * hint, lv_bidi_dir_t bidi_dir)
+{
+    const char * txt_copy = NULL;
+    lv_draw_cmd_t * cmd = cmd_add(LV_DRAW_CMD_LABEL, clip, style, opa_scale, txt, &txt_copy);
+    if(cmd == NULL) return LV_RES_INV;
+
+    lv_area_copy(&cmd->p.label.coords, coords);
+    cmd->p.label.txt        = txt_copy;
+    cmd->p.label.flag       = flag;
+    cmd->p.label.hint       = hint;
+    cmd->p.label.bidi_dir   = bidi_dir;
+    cmd->p.label.has_offset = offset ? 1 : 0;
+    cmd->p.label.has_sel    = sel ? 1 : 0;
+    if(offset) cmd->p.label.offset = *offset;
+    if(sel) cmd->p.label.sel = *sel;
+
+    return LV_RES_OK;
+}
+
+/**
+ * Record a line drawing. Called by `lv_draw_line` with its parameters.
+ * @return LV_RES_OK: recorded; LV_RES_INV: not recording (or masks are applied), draw it now
+ */
+lv_res_t lv_draw_backend_add_line(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * clip,
+                                  const lv_style_t * style, lv_opa_t opa_scale)
+{
+    lv_draw_cmd_t * cmd = cmd_add(LV_DRAW_CMD_LINE, clip, style, opa_scale, NULL, NULL);
+    if(cmd == NULL) return LV_RES_INV;
+
+    cmd->p.line.p1 = *point1;
+    cmd->p.line.p2 = *point2;
+
+    return LV_RES_OK;
+}
+
+/**
+ * Record an arc drawing. Called by `lv_draw_arc` with its parameters.
+ * @return LV_RES_OK: recorded; LV_RES_INV: not recording (or masks are applied), draw it now
+ */
+lv_res_t lv_draw_backend_add_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius, const lv_area_t * clip,
+                                 uint16_t start_angle, uint16_t end_angle, const lv_style_t * style,
+                                 lv_opa_t opa_scale)
+{
+    lv_draw_cmd_t * cmd = cmd_add(LV_DRAW_CMD_ARC, clip, style, opa_scale, NULL, NULL);
+    if(cmd == NULL) return LV_RES_INV;
+
+    cmd->p.arc.center.x    = center_x;
+    cmd->p.arc.center.y    = center_y;
+    cmd->p.arc.radius      = radius;
+    cmd->p.arc.start_angle = start_angle;
+    cmd->p.arc.end_angle   = end_angle;
+
+    return LV_RES_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Add a command to the queue. Sync if the queue is full.
+ * @param type type of the command
+ * @param clip the clip area of the drawing
+ * @param style the style of the drawing (will be copied)
+ * @param opa_scale the opacity scale of the drawing
+ * @param txt a text to copy to the queue or NULL
+ * @param txt_copy store the address of the copied text here (if `txt != NULL`)
+ * @return the new command to fill its parameters or NULL if the drawing should be done immediately
+ */
+static lv_draw_cmd_t * cmd_add(lv_draw_cmd_type_t type, const lv_area_t * clip, const lv_style_t * style,
+                               lv_opa_t opa_scale, const char * txt, const char ** txt_copy)
+{
+    if(queue.backend == NULL) return NULL;
+
+    /*The masks are applied while drawing so they can't be recorded*/
+    if(lv_draw_mask_get_cnt() != 0) {
+        lv_draw_backend_sync();
+        return NULL;
+    }
+
+    uint32_t txt_size = txt ? strlen(txt) + 1 : 0;
+    if(queue.cmd_cnt >= LV_DRAW_BACKEND_CMD_NUM || queue.txt_used + txt_size > LV_DRAW_BACKEND_TXT_SIZE) {
+        lv_draw_backend_sync();
+
+        /*Too long text. Draw it without the queue.*/
+        if(txt_size > LV_DRAW_BACKEND_TXT_SIZE) return NULL;
+    }
+
+    if(txt) {
+        memcpy(&queue.txt[queue.txt_used], txt, txt_size);
+        *txt_copy = &queue.txt[queue.txt_used];
+        queue.txt_used += txt_size;
+    }
+
+    lv_draw_cmd_t * cmd = &queue.cmd[queue.cmd_cnt];
+    queue.cmd_cnt++;
+
+    cmd->type      = type;
+    cmd->opa_scale = opa_scale;
+    lv_area_copy(&cmd->clip, clip);
+    lv_style_copy(&cmd->style, style);
+
+    return cmd;
+}
+
+/**
+ * Submit function of the CPU only reference backend: draw the whole batch now
+ * @param backend pointer to the backend
+ * @param batch pointer to a batch
+ */
+static void sw_submit(lv_draw_backend_t * backend, const lv_draw_batch_t * batch)
+{
+    lv_draw_backend_exec(backend, batch);
+}
+
+#endif /*LV_USE_DRAW_BACKEND*/
@@ -0,0 +1,226 @@
+/**
+ * @file lv_draw_backend.h
+ * Record the drawing into a command queue and execute it with a draw backend (e.g. a GPU)
+ */
+
+#ifndef LV_DRAW_BACKEND_H
+#define LV_DRAW_BACKEND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_DRAW_BACKEND != 0
+
+#include "../lv_core/lv_style.h"
+#include "../lv_misc/lv_area.h"
+#include "../lv_misc/lv_txt.h"
+#include "../lv_hal/lv_hal_disp.h"
+#include "lv_draw_label.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** Types of the draw commands*/
+enum {
+    LV_DRAW_CMD_RECT,   /**< Rectangle with radius, border and shadow (`lv_draw_rect`)*/
+    LV_DRAW_CMD_IMG,    /**< Image maybe rotated, zoomed, recolored or blended (`lv_draw_img`)*/
+    LV_DRAW_CMD_LABEL,  /**< Run of glyphs (`lv_draw_label`)*/
+    LV_DRAW_CMD_LINE,   /**< Line (`lv_draw_line`)*/
+    LV_DRAW_CMD_ARC,    /**< Arc (`lv_draw_arc`)*/
+};
+typedef uint8_t lv_draw_cmd_type_t;
+
+/**
+ * A recorded drawing. It has the parameters of the drawing function given in `type`.
+ * The pointers in it are valid until the command is executed.
+ */
+typedef struct
+{
+    lv_draw_cmd_type_t type;
+    lv_opa_t opa_scale;
+    lv_area_t clip;         /**< Draw only on this area (absolute coordinates)*/
+    lv_style_t style;       /**< Copy of the style to draw with*/
+
+    union
+    {
+        struct
+        {
+            lv_area_t coords;
+        } rect;
+
+        struct
+        {
+            lv_area_t coords;
+            const void * src;   /**< Image source. Path and symbol strings are copied to the queue.*/
+            lv_point_t pivot;
+            uint16_t angle;
+            uint16_t zoom;
+            uint8_t antialias : 1;
+            uint8_t has_pivot : 1;
+        } img;
+
+        struct
+        {
+            lv_area_t coords;
+            const char * txt;   /**< Copy of the text*/
+            lv_point_t offset;
+            lv_draw_label_txt_sel_t sel;
+            lv_draw_label_hint_t * hint;
+            lv_txt_flag_t flag;
+            lv_bidi_dir_t bidi_dir;
+            uint8_t has_offset : 1;
+            uint8_t has_sel : 1;
+        } label;
+
+        struct
+        {
+            lv_point_t p1;
+            lv_point_t p2;
+        } line;
+
+        struct
+        {
+            lv_point_t center;
+            uint16_t radius;
+            uint16_t start_angle;
+            uint16_t end_angle;
+        } arc;
+    } p;
+} lv_draw_cmd_t;
+
+/**
+ * Commands to execute on a buffer
+ */
+typedef struct
+{
+    lv_color_t * buf;           /**< The buffer to draw into*/
+    lv_area_t buf_area;         /**< Absolute coordinates of `buf`*/
+    const lv_draw_cmd_t * cmd;  /**< The commands in the order of drawing*/
+    uint16_t cmd_cnt;           /**< Number of commands in `cmd`*/
+} lv_draw_batch_t;
+
+/**
+ * A draw backend. All callbacks are optional.
+ * The not supported commands are drawn by the CPU, so a zero initialized backend is valid too.
+ */
+typedef struct _lv_draw_backend_t
+{
+    /** Draw a command of the given type into `batch->buf`.
+     * Return `LV_RES_INV` if it's not supported to draw it with the CPU instead.*/
+    lv_res_t (*rect_cb)(struct _lv_draw_backend_t * backend, const lv_draw_batch_t * batch, const lv_draw_cmd_t * cmd);
+    lv_res_t (*img_cb)(struct _lv_draw_backend_t * backend, const lv_draw_batch_t * batch, const lv_draw_cmd_t * cmd);
+    lv_res_t (*label_cb)(struct _lv_draw_backend_t * backend, const lv_draw_batch_t * batch, const lv_draw_cmd_t * cmd);
+    lv_res_t (*line_cb)(struct _lv_draw_backend_t * backend, const lv_draw_batch_t * batch, const lv_draw_cmd_t * cmd);
+    lv_res_t (*arc_cb)(struct _lv_draw_backend_t * backend, const lv_draw_batch_t * batch, const lv_draw_cmd_t * cmd);
+
+    /** Start executing a batch. Might return before it's ready (e.g. a GPU or an other thread executes it).
+     * Call `lv_draw_backend_exec(backend, batch)` to draw the commands with the callbacks above or with the CPU.
+     * If NULL the batch is executed immediately.*/
+    void (*submit_cb)(struct _lv_draw_backend_t * backend, const lv_draw_batch_t * batch);
+
+    /** Wait until the submitted batches are ready. Called before the buffer is used by anything else.*/
+    void (*sync_cb)(struct _lv_draw_backend_t * backend);
+
+#if LV_USE_USER_DATA
+    void * user_data;
+#endif
+} lv_draw_backend_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a CPU only reference backend. It executes the batches synchronously.
+ * Useful to test the command queue or as a base of an other backend.
+ * @param backend pointer to a backend to initialize
+ */
+void lv_draw_backend_sw_init(lv_draw_backend_t * backend);
+
+/**
+ * Execute a batch of commands. The ones not supported by the backend are drawn with the CPU.
+ * Should be called from the backend's `submit_cb` while the display is being refreshed.
+ * @param backend pointer to a draw backend
+ * @param batch pointer to a batch
+ */
+void lv_draw_backend_exec(lv_draw_backend_t * backend, const lv_draw_batch_t * batch);
+
+/**
+ * Start recording the drawing into the command queue if the display has a draw backend.
+ * The refresher calls it for every band (or slice) of the display buffer.
+ * @param disp pointer to the display being refreshed
+ */
+void lv_draw_backend_begin(lv_disp_t * disp);
+
+/**
+ * Execute the recorded commands and stop recording
+ */
+void lv_draw_backend_end(void);
+
+/**
+ * Sync point: submit the recorded commands and wait until the backend draws them.
+ * It's called before anything is drawn directly into the buffer to keep the order of drawing.
+ */
+void lv_draw_backend_sync(void);
+
+/**
+ * Record a rectangle drawing. Called by `lv_draw_rect` with its parameters.
+ * @return LV_RES_OK: recorded; LV_RES_INV: not recording (or masks are applied), draw it now
+ */
+lv_res_t lv_draw_backend_add_rect(const lv_area_t * coords, const lv_area_t * clip, const lv_style_t * style,
+                                  lv_opa_t opa_scale);
+
+/**
+ * Record an image drawing. Called by `lv_draw_img` with its parameters.
+ * @return LV_RES_OK: recorded; LV_RES_INV: not recording (or masks are applied), draw it now
+ */
+lv_res_t lv_draw_backend_add_img(const lv_area_t * coords, const lv_area_t * clip, const void * src,
+                                 const lv_style_t * style, uint16_t angle, const lv_point_t * pivot, uint16_t zoom,
+                                 bool antialias, lv_opa_t opa_scale);
+
+/**
+ * Record a label drawing. Called by `lv_draw_label` with its parameters.
+ * @return LV_RES_OK: recorded; LV_RES_INV: not recording (or masks are applied), draw it now
+ */
+lv_res_t lv_draw_backend_add_label(const lv_area_t * coords, const lv_area_t * clip, const lv_style_t * style,
+                                   lv_opa_t opa_scale, const char * txt, lv_txt_flag_t flag,
+                                   const lv_point_t * offset, const lv_draw_label_txt_sel_t * sel,
+                                   lv_draw_label_hint_t * hint, lv_bidi_dir_t bidi_dir);
+
+/**
+ * Record a line drawing. Called by `lv_draw_line` with its parameters.
+ * @return LV_RES_OK: recorded; LV_RES_INV: not recording (or masks are applied), draw it now
+ */
+lv_res_t lv_draw_backend_add_line(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * clip,
+                                  const lv_style_t * style, lv_opa_t opa_scale);
+
+/**
+ * Record an arc drawing. Called by `lv_draw_arc` with its parameters.
+ * @return LV_RES_OK: recorded; LV_RES_INV: not recording (or masks are applied), draw it now
+ */
+lv_res_t lv_draw_backend_add_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius, const lv_area_t * clip,
+                                 uint16_t start_angle, uint16_t end_angle, const lv_style_t * style,
+                                 lv_opa_t opa_scale);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_BACKEND*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_BACKEND_H*/
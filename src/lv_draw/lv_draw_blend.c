@@ -7,10 +7,13 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_blend.h"
+#include "lv_draw_blend_simd.h"
+#include "lv_draw_backend.h"
 #include "lv_img_decoder.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_hal/lv_hal_disp.h"
 #include "../lv_core/lv_refr.h"
+#include "../lv_misc/lv_profiler.h"
 
 /*********************
  *      DEFINES
@@ -43,9 +46,15 @@ static void map_set_px(const lv_area_t * disp_area, lv_color_t * disp_buf,  cons
         const lv_area_t * map_area, const lv_color_t * map_buf, lv_opa_t opa,
         const lv_opa_t * mask, lv_draw_mask_res_t mask_res);
 
+#if LV_COLOR_PREMULT
+static void map_premult(const lv_area_t * disp_area, lv_color_t * disp_buf,  const lv_area_t * draw_area,
+        const lv_area_t * map_area, const lv_color_t * map_buf, lv_opa_t opa,
+        const lv_opa_t * mask, lv_draw_mask_res_t mask_res);
+#else
 static void map_normal(const lv_area_t * disp_area, lv_color_t * disp_buf,  const lv_area_t * draw_area,
         const lv_area_t * map_area, const lv_color_t * map_buf, lv_opa_t opa,
         const lv_opa_t * mask, lv_draw_mask_res_t mask_res);
+#endif
 
 static void map_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  const lv_area_t * draw_area,
         const lv_area_t * map_area, const lv_color_t * map_buf, lv_opa_t opa,
@@ -53,6 +62,9 @@ static void map_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
 
 static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
 static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
+#if LV_COLOR_SCREEN_TRANSP
+static inline lv_color_t color_mix_transp(lv_color_t fg, lv_color_t bg, lv_opa_t opa);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -88,6 +100,11 @@ void lv_blend_fill(const lv_area_t * clip_area, const lv_area_t * fill_area,
     if(opa < LV_OPA_MIN) return;
     if(mask_res == LV_DRAW_MASK_RES_FULL_TRANSP) return;
 
+#if LV_USE_DRAW_BACKEND
+    /*Draw the recorded commands first to keep the order*/
+    lv_draw_backend_sync();
+#endif
+
     lv_disp_t * disp = lv_refr_get_disp_refreshing();
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
     const lv_area_t * disp_area = &vdb->area;
@@ -101,6 +118,8 @@ void lv_blend_fill(const lv_area_t * clip_area, const lv_area_t * fill_area,
     is_common = lv_area_intersect(&draw_area, clip_area, fill_area);
     if(!is_common) return;
 
+    LV_PROFILER_BEGIN(prof_start);
+
     /* Now `draw_area` has absolute coordinates.
      * Make it relative to `disp_area` to simplify draw to `disp_buf`*/
     draw_area.x1 -= disp_area->x1;
@@ -124,6 +143,10 @@ void lv_blend_fill(const lv_area_t * clip_area, const lv_area_t * fill_area,
     else {
         fill_blended(disp_area, disp_buf, &draw_area, color, opa, mask, mask_res, mode);
     }
+
+    /*The counters of the blend modes are in the order of `lv_blend_mode_t`*/
+    LV_PROFILER_COUNT(LV_PROFILER_CNT_PX_NORMAL + mode, lv_area_get_size(&draw_area));
+    LV_PROFILER_COUNT_TIME(LV_PROFILER_CNT_BLEND_TIME, prof_start);
 }
 
 
@@ -142,6 +165,13 @@ void lv_blend_map(const lv_area_t * clip_area, const lv_area_t * map_area, const
     is_common = lv_area_intersect(&draw_area, clip_area, map_area);
     if(!is_common) return;
 
+#if LV_USE_DRAW_BACKEND
+    /*Draw the recorded commands first to keep the order*/
+    lv_draw_backend_sync();
+#endif
+
+    LV_PROFILER_BEGIN(prof_start);
+
     lv_disp_t * disp = lv_refr_get_disp_refreshing();
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
     const lv_area_t * disp_area = &vdb->area;
@@ -164,10 +194,17 @@ void lv_blend_map(const lv_area_t * clip_area, const lv_area_t * map_area, const
         map_set_px(disp_area, disp_buf, &draw_area, map_area, map_buf, opa, mask, mask_res);
     }
     else if(mode == LV_BLEND_MODE_NORMAL) {
+#if LV_COLOR_PREMULT
+        map_premult(disp_area, disp_buf, &draw_area, map_area, map_buf, opa, mask, mask_res);
+#else
         map_normal(disp_area, disp_buf, &draw_area, map_area, map_buf, opa, mask, mask_res);
+#endif
     } else {
         map_blended(disp_area, disp_buf, &draw_area, map_area, map_buf, opa, mask, mask_res, mode);
     }
+
+    LV_PROFILER_COUNT(LV_PROFILER_CNT_PX_NORMAL + mode, lv_area_get_size(&draw_area));
+    LV_PROFILER_COUNT_TIME(LV_PROFILER_CNT_BLEND_TIME, prof_start);
 }
 
 
@@ -217,7 +254,7 @@ static void fill_normal(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
         const lv_opa_t * mask, lv_draw_mask_res_t mask_res)
 {
 
-#if LV_USE_GPU
+#if LV_USE_GPU || LV_COLOR_SCREEN_TRANSP
     lv_disp_t * disp = lv_refr_get_disp_refreshing();
 #endif
 
@@ -230,6 +267,14 @@ static void fill_normal(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
     /*Create a temp. disp_buf which always point to current line to draw*/
     lv_color_t * disp_buf_tmp = disp_buf + disp_w * draw_area->y1;
 
+#if LV_BLEND_SIMD
+    /*The SIMD functions can't mix with alpha channel*/
+    bool simd = true;
+#if LV_COLOR_SCREEN_TRANSP
+    if(disp->driver.screen_transp) simd = false;
+#endif
+#endif
+
     int32_t x;
     int32_t y;
 
@@ -267,7 +312,7 @@ static void fill_normal(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
 
 #if LV_USE_GPU
             if(disp->driver.gpu_blend_cb && draw_area_w > GPU_WIDTH_LIMIT) {
-                static lv_color_t blend_buf[LV_HOR_RES_MAX];
+                static LV_THREAD_LOCAL lv_color_t blend_buf[LV_HOR_RES_MAX]; /*Separate for the drawing threads*/
                 for(x = 0; x < draw_area_w ; x++) blend_buf[x].full = color.full;
 
                 for(y = draw_area->y1; y <= draw_area->y2; y++) {
@@ -280,13 +325,17 @@ static void fill_normal(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
             lv_color_t last_dest_color = LV_COLOR_BLACK;
             lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
             for(y = draw_area->y1; y <= draw_area->y2; y++) {
-                for(x = draw_area->x1; x <= draw_area->x2; x++) {
+                x = draw_area->x1;
+#if LV_BLEND_SIMD
+                if(simd) x += lv_blend_simd_fill(&disp_buf_tmp[x], NULL, draw_area_w, color, opa, LV_BLEND_MODE_NORMAL);
+#endif
+                for(; x <= draw_area->x2; x++) {
                     if(last_dest_color.full != disp_buf_tmp[x].full) {
                         last_dest_color = disp_buf_tmp[x];
 
 #if LV_COLOR_SCREEN_TRANSP
                         if(disp->driver.screen_transp) {
-                            lv_color_mix_with_alpha(disp_buf_tmp[x], disp_buf_tmp[x].ch.alpha, color, opa, &last_res_color, &last_res_color.ch.alpha);
+                            last_res_color = color_mix_transp(color, disp_buf_tmp[x], opa);
                         } else
 #endif
                         {
@@ -316,13 +365,17 @@ static void fill_normal(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
         /*Only the mask matters*/
         if(opa > LV_OPA_MAX) {
             for(y = draw_area->y1; y <= draw_area->y2; y++) {
-                for(x = draw_area->x1; x <= draw_area->x2; x++) {
+                x = draw_area->x1;
+#if LV_BLEND_SIMD
+                if(simd) x += lv_blend_simd_fill(&disp_buf_tmp[x], &mask_tmp[x], draw_area_w, color, opa, LV_BLEND_MODE_NORMAL);
+#endif
+                for(; x <= draw_area->x2; x++) {
                     if(mask_tmp[x] == 0) continue;
                     if(mask_tmp[x] != last_mask || last_dest_color.full != disp_buf_tmp[x].full)
                     {
 #if LV_COLOR_SCREEN_TRANSP
                         if(disp->driver.screen_transp) {
-                            lv_color_mix_with_alpha(disp_buf_tmp[x], disp_buf_tmp[x].ch.alpha, color, mask_tmp[x], &last_res_color, &last_res_color.ch.alpha);
+                            last_res_color = color_mix_transp(color, disp_buf_tmp[x], mask_tmp[x]);
                         } else
 #endif
                         {
@@ -343,13 +396,17 @@ static void fill_normal(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
         /*Handle opa and mask values too*/
         else {
             for(y = draw_area->y1; y <= draw_area->y2; y++) {
-                for(x = draw_area->x1; x <= draw_area->x2; x++) {
+                x = draw_area->x1;
+#if LV_BLEND_SIMD
+                if(simd) x += lv_blend_simd_fill(&disp_buf_tmp[x], &mask_tmp[x], draw_area_w, color, opa, LV_BLEND_MODE_NORMAL);
+#endif
+                for(; x <= draw_area->x2; x++) {
                     if(mask_tmp[x] == 0) continue;
                     if(mask_tmp[x] != last_mask || last_dest_color.full != disp_buf_tmp[x].full) {
                         lv_opa_t opa_tmp = mask_tmp[x] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)mask_tmp[x] * opa) >> 8;
 #if LV_COLOR_SCREEN_TRANSP
                         if(disp->driver.screen_transp) {
-                            lv_color_mix_with_alpha(disp_buf_tmp[x], disp_buf_tmp[x].ch.alpha, color, opa_tmp, &last_res_color, &last_res_color.ch.alpha);
+                            last_res_color = color_mix_transp(color, disp_buf_tmp[x], opa_tmp);
                         } else
 #endif
                         {
@@ -377,6 +434,9 @@ static void fill_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  co
     /*Get the width of the `disp_area` it will be used to go to the next line*/
     int32_t disp_w = lv_area_get_width(disp_area);
 
+    /*Get the width of the `draw_area` it will be used to go to the next line of the mask*/
+    int32_t draw_area_w = lv_area_get_width(draw_area);
+
     /*Create a temp. disp_buf which always point to current line to draw*/
     lv_color_t * disp_buf_tmp = disp_buf + disp_w * draw_area->y1;
 
@@ -401,9 +461,13 @@ static void fill_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  co
     /*Simple fill (maybe with opacity), no masking*/
     if(mask_res == LV_DRAW_MASK_RES_FULL_COVER) {
         lv_color_t last_dest_color = LV_COLOR_BLACK;
-        lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
+        lv_color_t last_res_color = blend_fp(color, last_dest_color, opa);
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
-            for(x = draw_area->x1; x <= draw_area->x2; x++) {
+            x = draw_area->x1;
+#if LV_BLEND_SIMD
+            x += lv_blend_simd_fill(&disp_buf_tmp[x], NULL, draw_area_w, color, opa, mode);
+#endif
+            for(; x <= draw_area->x2; x++) {
                 if(last_dest_color.full != disp_buf_tmp[x].full) {
                     last_dest_color = disp_buf_tmp[x];
                     last_res_color = blend_fp(color, disp_buf_tmp[x], opa);
@@ -415,9 +479,6 @@ static void fill_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  co
     }
     /*Masked*/
     else {
-        /*Get the width of the `draw_area` it will be used to go to the next line of the mask*/
-        int32_t draw_area_w = lv_area_get_width(draw_area);
-
         /* The mask is relative to the clipped area.
          * In the cycles below mask will be indexed from `draw_area.x1`
          * but it corresponds to zero index. So prepare `mask_tmp` accordingly. */
@@ -431,7 +492,11 @@ static void fill_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  co
         last_res_color.full = disp_buf_tmp[0].full;
 
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
-            for(x = draw_area->x1; x <= draw_area->x2; x++) {
+            x = draw_area->x1;
+#if LV_BLEND_SIMD
+            x += lv_blend_simd_fill(&disp_buf_tmp[x], &mask_tmp[x], draw_area_w, color, opa, mode);
+#endif
+            for(; x <= draw_area->x2; x++) {
                 if(mask_tmp[x] == 0) continue;
                 if(mask_tmp[x] != last_mask || last_dest_color.full != disp_buf_tmp[x].full) {
                     lv_opa_t opa_tmp = mask_tmp[x] >= LV_OPA_MAX ? opa : (uint32_t)((uint32_t)mask_tmp[x] * opa) >> 8;
@@ -496,6 +561,58 @@ static void map_set_px(const lv_area_t * disp_area, lv_color_t * disp_buf,  cons
 }
 
 
+#if LV_COLOR_PREMULT
+/**
+ * Blend premultiplied ARGB8888 pixels with "source over". Used instead of `map_normal` if `LV_COLOR_PREMULT` is enabled.
+ * The alpha channel of `map_buf` is the opacity of its pixels and `mask` and `opa` scale it further.
+ */
+static void map_premult(const lv_area_t * disp_area, lv_color_t * disp_buf,  const lv_area_t * draw_area,
+        const lv_area_t * map_area, const lv_color_t * map_buf, lv_opa_t opa,
+        const lv_opa_t * mask, lv_draw_mask_res_t mask_res)
+{
+    /*Get the width of the `disp_area` it will be used to go to the next line*/
+    int32_t disp_w = lv_area_get_width(disp_area);
+
+    /*Get the width of the `draw_area` it will be used to go to the next line of the mask*/
+    int32_t draw_area_w = lv_area_get_width(draw_area);
+
+    /*Get the width of the `mask_area` it will be used to go to the next line*/
+    int32_t map_w = lv_area_get_width(map_area);
+
+    /*Create a temp. disp_buf which always point to current line to draw*/
+    lv_color_t * disp_buf_tmp = disp_buf + disp_w * draw_area->y1;
+
+    /*Create a temp. map_buf which always point to current line to draw.
+     * It will be indexed from `draw_area->x1` so compensate it.*/
+    const lv_color_t * map_buf_tmp = map_buf + map_w * (draw_area->y1 - (map_area->y1 - disp_area->y1));
+    map_buf_tmp += (draw_area->x1 - (map_area->x1 - disp_area->x1));
+    map_buf_tmp -= draw_area->x1;
+
+    /*The mask is relative to the clipped area so compensate it too.*/
+    const lv_opa_t * mask_tmp = mask_res == LV_DRAW_MASK_RES_FULL_COVER ? NULL : mask - draw_area->x1;
+
+    int32_t x;
+    int32_t y;
+    for(y = draw_area->y1; y <= draw_area->y2; y++) {
+        for(x = draw_area->x1; x <= draw_area->x2; x++) {
+            lv_opa_t opa_tmp = opa;
+            if(mask_tmp) {
+                if(mask_tmp[x] < LV_OPA_MIN) continue;
+                if(mask_tmp[x] <= LV_OPA_MAX) opa_tmp = ((uint32_t)opa * mask_tmp[x]) >> 8;
+            }
+
+            /*Copy the opaque pixels and skip the empty ones*/
+            if(opa_tmp > LV_OPA_MAX && map_buf_tmp[x].ch.alpha == LV_OPA_COVER) disp_buf_tmp[x] = map_buf_tmp[x];
+            else if(map_buf_tmp[x].full != 0) disp_buf_tmp[x] = lv_color_mix_premult(map_buf_tmp[x], disp_buf_tmp[x], opa_tmp);
+        }
+        disp_buf_tmp += disp_w;
+        map_buf_tmp += map_w;
+        if(mask_tmp) mask_tmp += draw_area_w;
+    }
+}
+
+#else
+
 static void map_normal(const lv_area_t * disp_area, lv_color_t * disp_buf,  const lv_area_t * draw_area,
         const lv_area_t * map_area, const lv_color_t * map_buf, lv_opa_t opa,
         const lv_opa_t * mask, lv_draw_mask_res_t mask_res)
@@ -524,6 +641,14 @@ static void map_normal(const lv_area_t * disp_area, lv_color_t * disp_buf,  cons
     lv_disp_t * disp = lv_refr_get_disp_refreshing();
 #endif
 
+#if LV_BLEND_SIMD
+    /*The SIMD functions can't mix with alpha channel*/
+    bool simd = true;
+#if LV_COLOR_SCREEN_TRANSP
+    if(disp->driver.screen_transp) simd = false;
+#endif
+#endif
+
     int32_t x;
     int32_t y;
 
@@ -555,7 +680,11 @@ static void map_normal(const lv_area_t * disp_area, lv_color_t * disp_buf,  cons
             /*The map will be indexed from `draw_area->x1` so compensate it.*/
             map_buf_tmp -= draw_area->x1;
             for(y = draw_area->y1; y <= draw_area->y2; y++) {
-                for(x = draw_area->x1; x <= draw_area->x2; x++) {
+                x = draw_area->x1;
+#if LV_BLEND_SIMD
+                if(simd) x += lv_blend_simd_map(&disp_buf_tmp[x], &map_buf_tmp[x], NULL, draw_area_w, opa, LV_BLEND_MODE_NORMAL);
+#endif
+                for(; x <= draw_area->x2; x++) {
 #if LV_COLOR_SCREEN_TRANSP
                     if(disp->driver.screen_transp) {
                         lv_color_mix_with_alpha(disp_buf_tmp[x], disp_buf_tmp[x].ch.alpha, map_buf_tmp[x], opa, &disp_buf_tmp[x], &disp_buf_tmp[x].ch.alpha);
@@ -588,7 +717,11 @@ static void map_normal(const lv_area_t * disp_area, lv_color_t * disp_buf,  cons
             map_buf_tmp -= draw_area->x1;
 
             for(y = draw_area->y1; y <= draw_area->y2; y++) {
-                for(x = draw_area->x1; x <= draw_area->x2; x++) {
+                x = draw_area->x1;
+#if LV_BLEND_SIMD
+                if(simd) x += lv_blend_simd_map(&disp_buf_tmp[x], &map_buf_tmp[x], &mask_tmp[x], draw_area_w, opa, LV_BLEND_MODE_NORMAL);
+#endif
+                for(; x <= draw_area->x2; x++) {
                     if(mask_tmp[x] < LV_OPA_MIN) continue;
 #if LV_COLOR_SCREEN_TRANSP
                         if(disp->driver.screen_transp) {
@@ -611,7 +744,11 @@ static void map_normal(const lv_area_t * disp_area, lv_color_t * disp_buf,  cons
         else {
             map_buf_tmp -= draw_area->x1;
             for(y = draw_area->y1; y <= draw_area->y2; y++) {
-                for(x = draw_area->x1; x <= draw_area->x2; x++) {
+                x = draw_area->x1;
+#if LV_BLEND_SIMD
+                if(simd) x += lv_blend_simd_map(&disp_buf_tmp[x], &map_buf_tmp[x], &mask_tmp[x], draw_area_w, opa, LV_BLEND_MODE_NORMAL);
+#endif
+                for(; x <= draw_area->x2; x++) {
                     if(mask_tmp[x] == 0) continue;
                     lv_opa_t opa_tmp = mask_tmp[x] >= LV_OPA_MAX ? opa : ((opa * mask_tmp[x]) >> 8);
 #if LV_COLOR_SCREEN_TRANSP
@@ -631,6 +768,8 @@ static void map_normal(const lv_area_t * disp_area, lv_color_t * disp_buf,  cons
     }
 }
 
+#endif /*LV_COLOR_PREMULT*/
+
 static void map_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  const lv_area_t * draw_area,
         const lv_area_t * map_area, const lv_color_t * map_buf, lv_opa_t opa,
         const lv_opa_t * mask, lv_draw_mask_res_t mask_res, lv_blend_mode_t mode)
@@ -677,7 +816,11 @@ static void map_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
         map_buf_tmp -= draw_area->x1;
 
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
-            for(x = draw_area->x1; x <= draw_area->x2; x++) {
+            x = draw_area->x1;
+#if LV_BLEND_SIMD
+            x += lv_blend_simd_map(&disp_buf_tmp[x], &map_buf_tmp[x], NULL, draw_area_w, opa, mode);
+#endif
+            for(; x <= draw_area->x2; x++) {
                 disp_buf_tmp[x] = blend_fp(map_buf_tmp[x], disp_buf_tmp[x], opa);
             }
             disp_buf_tmp += disp_w;
@@ -693,7 +836,11 @@ static void map_blended(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
 
         map_buf_tmp -= draw_area->x1;
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
-            for(x = draw_area->x1; x <= draw_area->x2; x++) {
+            x = draw_area->x1;
+#if LV_BLEND_SIMD
+            x += lv_blend_simd_map(&disp_buf_tmp[x], &map_buf_tmp[x], &mask_tmp[x], draw_area_w, opa, mode);
+#endif
+            for(; x <= draw_area->x2; x++) {
                 if(mask_tmp[x] == 0) continue;
                 lv_opa_t opa_tmp = mask_tmp[x] >= LV_OPA_MAX ? opa : ((opa * mask_tmp[x]) >> 8);
                 disp_buf_tmp[x] = blend_fp(map_buf_tmp[x], disp_buf_tmp[x], opa_tmp);
@@ -725,6 +872,7 @@ static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color
 #endif
 
 #if LV_COLOR_DEPTH == 8
+    tmp = bg.ch.green + fg.ch.green;
     fg.ch.green = LV_MATH_MIN(tmp, 7);
 #elif LV_COLOR_DEPTH == 16
 #if LV_COLOR_16_SWAP == 0
@@ -738,6 +886,7 @@ static inline lv_color_t color_blend_true_color_additive(lv_color_t fg, lv_color
 #endif
 
 #elif LV_COLOR_DEPTH == 32
+    tmp = bg.ch.green + fg.ch.green;
     fg.ch.green = LV_MATH_MIN(tmp, 255);
 #endif
 
@@ -769,7 +918,7 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
     tmp = bg.ch.green - fg.ch.green;
     fg.ch.green = LV_MATH_MAX(tmp, 0);
 #else
-    tmp = (bg.ch.green_h << 3) + bg.ch.green_l + (fg.ch.green_h << 3) + fg.ch.green_l;
+    tmp = (bg.ch.green_h << 3) + bg.ch.green_l - (fg.ch.green_h << 3) - fg.ch.green_l;
     tmp = LV_MATH_MAX(tmp, 0);
     fg.ch.green_h = tmp >> 3;
     fg.ch.green_l = tmp & 0x7;
@@ -782,3 +931,24 @@ static inline lv_color_t color_blend_true_color_subtractive(lv_color_t fg, lv_co
 
     return lv_color_mix(fg, bg, opa);
 }
+
+#if LV_COLOR_SCREEN_TRANSP
+/**
+ * Mix a color on a pixel of a transparent screen
+ * @param fg the color to draw
+ * @param bg the pixel with its alpha channel
+ * @param opa opacity of `fg`
+ * @return the new value of the pixel
+ */
+static inline lv_color_t color_mix_transp(lv_color_t fg, lv_color_t bg, lv_opa_t opa)
+{
+#if LV_COLOR_PREMULT
+    /*`fg` is opaque so it's the same premultiplied*/
+    return lv_color_mix_premult(fg, bg, opa);
+#else
+    lv_color_t res;
+    lv_color_mix_with_alpha(bg, bg.ch.alpha, fg, opa, &res, &res.ch.alpha);
+    return res;
+#endif
+}
+#endif
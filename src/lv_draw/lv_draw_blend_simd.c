@@ -0,0 +1,817 @@
+/**
+ * @file lv_draw_blend_simd.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_blend_simd.h"
+
+#if LV_BLEND_SIMD
+
+#include <stdbool.h>
+
+#if LV_BLEND_SIMD_SSE2
+#include <immintrin.h>
+#endif
+
+#if LV_BLEND_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The maximal value of the channels for the additive blending*/
+#if LV_COLOR_DEPTH == 16
+#define CH_MAX_R    31
+#define CH_MAX_G    63
+#define CH_MAX_B    31
+#else
+#define CH_MAX_R    255
+#define CH_MAX_G    255
+#define CH_MAX_B    255
+#endif
+
+/*Number of registers to store the pixels of a register with 16 bit lanes*/
+#if LV_COLOR_DEPTH == 16
+#define RAW_CNT     1
+#else
+#define RAW_CNT     2
+#endif
+
+#if LV_BLEND_SIMD_AVX2
+#define AVX2_ATTR   __attribute__((target("avx2")))
+#endif
+
+/*Leave the short rows to the scalar code. The setup of the registers doesn't worth it for a few pixels.*/
+#define MIN_LEN     32
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef int32_t (*blend_row_cb_t)(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * mask, int32_t len,
+                                  lv_color_t color, lv_opa_t opa, lv_blend_mode_t mode);
+
+#if LV_BLEND_SIMD_SSE2
+/** 8 pixels as they are stored and split to channels in 16 bit lanes*/
+typedef struct {
+    __m128i raw[RAW_CNT];
+    __m128i r;
+    __m128i g;
+    __m128i b;
+} sse2_px_t;
+#endif
+
+#if LV_BLEND_SIMD_AVX2
+/** 16 pixels as they are stored and split to channels in 16 bit lanes*/
+typedef struct {
+    __m256i raw[RAW_CNT];
+    __m256i r;
+    __m256i g;
+    __m256i b;
+} avx2_px_t;
+#endif
+
+#if LV_BLEND_SIMD_NEON
+/** 8 pixels as they are stored and split to channels in 16 bit lanes*/
+typedef struct {
+#if LV_COLOR_DEPTH == 16
+    uint16x8_t raw;
+#else
+    uint8x8x4_t raw;    /*Deinterleaved to blue, green, red and alpha*/
+#endif
+    uint16x8_t r;
+    uint16x8_t g;
+    uint16x8_t b;
+} neon_px_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_BLEND_SIMD_SSE2
+static int32_t sse2_blend_row(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * mask, int32_t len,
+                              lv_color_t color, lv_opa_t opa, lv_blend_mode_t mode);
+#endif
+
+#if LV_BLEND_SIMD_AVX2
+static int32_t avx2_blend_row(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * mask, int32_t len,
+                              lv_color_t color, lv_opa_t opa, lv_blend_mode_t mode) AVX2_ATTR;
+#endif
+
+#if LV_BLEND_SIMD_NEON
+static int32_t neon_blend_row(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * mask, int32_t len,
+                              lv_color_t color, lv_opa_t opa, lv_blend_mode_t mode);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static blend_row_cb_t blend_row;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Select the fastest instruction set supported by the CPU
+ */
+void lv_blend_simd_init(void)
+{
+#if LV_BLEND_SIMD_AVX2
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")) {
+        blend_row = avx2_blend_row;
+        return;
+    }
+#endif
+
+#if LV_BLEND_SIMD_SSE2
+    blend_row = sse2_blend_row;
+#elif LV_BLEND_SIMD_NEON
+    blend_row = neon_blend_row;
+#endif
+}
+
+/**
+ * Blend a color on a row of pixels.
+ * The result is the same as `lv_blend_fill`'s with the same parameters.
+ * @param dest pointer to the first pixel to blend
+ * @param mask opacity of each pixel or NULL if there is no mask (`LV_DRAW_MASK_RES_FULL_COVER`)
+ * @param len number of pixels in the row
+ * @param color the color to blend
+ * @param opa opacity of the color. If `mode` is `LV_BLEND_MODE_NORMAL` and `mask` is NULL should be <= `LV_OPA_MAX`
+ * @param mode the blend mode
+ * @return number of blended pixels from the beginning of the row. The rest should be blended by the caller.
+ */
+int32_t lv_blend_simd_fill(lv_color_t * dest, const lv_opa_t * mask, int32_t len, lv_color_t color, lv_opa_t opa,
+                           lv_blend_mode_t mode)
+{
+    if(blend_row == NULL || len < MIN_LEN) return 0;
+
+    return blend_row(dest, NULL, mask, len, color, opa, mode);
+}
+
+/**
+ * Blend a row of pixels on an other row of pixels.
+ * The result is the same as `lv_blend_map`'s with the same parameters.
+ * @param dest pointer to the first pixel to blend
+ * @param src pointer to the first pixel to blend on `dest`
+ * @param mask opacity of each pixel or NULL if there is no mask (`LV_DRAW_MASK_RES_FULL_COVER`)
+ * @param len number of pixels in the row
+ * @param opa opacity of `src`. If `mode` is `LV_BLEND_MODE_NORMAL` and `mask` is NULL should be <= `LV_OPA_MAX`
+ * @param mode the blend mode
+ * @return number of blended pixels from the beginning of the row. The rest should be blended by the caller.
+ */
+int32_t lv_blend_simd_map(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * mask, int32_t len, lv_opa_t opa,
+                          lv_blend_mode_t mode)
+{
+    if(blend_row == NULL || len < MIN_LEN) return 0;
+
+    return blend_row(dest, src, mask, len, LV_COLOR_BLACK, opa, mode);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/* All instruction sets calculate the same for every pixel as the scalar code in `lv_draw_blend.c`:
+ * - `o`: the mix ratio of the foreground
+ * - `keep`: the pixel remains unchanged
+ * - `take`: the foreground is copied
+ * - else: `(fg * o + bg * (255 - o)) >> 8` for every channel (like `lv_color_mix`)
+ * With additive and subtractive blending the foreground is first saturated with the background.*/
+
+#if LV_BLEND_SIMD_SSE2
+
+/**
+ * Split the raw pixels to channels
+ * @param px pointer to pixels with `raw` set
+ */
+static inline void sse2_split(sse2_px_t * px)
+{
+#if LV_COLOR_DEPTH == 16
+    __m128i v = px->raw[0];
+#if LV_COLOR_16_SWAP
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+#endif
+    px->r = _mm_srli_epi16(v, 11);
+    px->g = _mm_and_si128(_mm_srli_epi16(v, 5), _mm_set1_epi16(0x3F));
+    px->b = _mm_and_si128(v, _mm_set1_epi16(0x1F));
+#else
+    const __m128i m = _mm_set1_epi32(0xFF);
+    px->b = _mm_packs_epi32(_mm_and_si128(px->raw[0], m), _mm_and_si128(px->raw[1], m));
+    px->g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(px->raw[0], 8), m),
+                            _mm_and_si128(_mm_srli_epi32(px->raw[1], 8), m));
+    px->r = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(px->raw[0], 16), m),
+                            _mm_and_si128(_mm_srli_epi32(px->raw[1], 16), m));
+#endif
+}
+
+/**
+ * Join the channels to raw pixels
+ * @param px pointer to pixels with the channels set
+ * @param alpha the alpha bits of the raw pixels (used only with 32 bit color depth)
+ */
+static inline void sse2_join(sse2_px_t * px, const __m128i * alpha)
+{
+#if LV_COLOR_DEPTH == 16
+    (void)alpha;    /*Unused*/
+    __m128i v = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(px->r, 11), _mm_slli_epi16(px->g, 5)), px->b);
+#if LV_COLOR_16_SWAP
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+#endif
+    px->raw[0] = v;
+#else
+    const __m128i z = _mm_setzero_si128();
+    px->raw[0] = _mm_or_si128(_mm_or_si128(_mm_unpacklo_epi16(px->b, z), _mm_slli_epi32(_mm_unpacklo_epi16(px->g, z), 8)),
+                              _mm_or_si128(_mm_slli_epi32(_mm_unpacklo_epi16(px->r, z), 16), alpha[0]));
+    px->raw[1] = _mm_or_si128(_mm_or_si128(_mm_unpackhi_epi16(px->b, z), _mm_slli_epi32(_mm_unpackhi_epi16(px->g, z), 8)),
+                              _mm_or_si128(_mm_slli_epi32(_mm_unpackhi_epi16(px->r, z), 16), alpha[1]));
+#endif
+}
+
+/**
+ * Select raw pixels: `res = k ? a : b`
+ * @param k the condition in 16 bit lanes
+ * @param a raw pixels to use where `k` is set
+ * @param b raw pixels to use where `k` is cleared
+ * @param res store the result here
+ */
+static inline void sse2_select(__m128i k, const __m128i * a, const __m128i * b, __m128i * res)
+{
+#if LV_COLOR_DEPTH == 16
+    res[0] = _mm_or_si128(_mm_and_si128(k, a[0]), _mm_andnot_si128(k, b[0]));
+#else
+    __m128i k0 = _mm_unpacklo_epi16(k, k);
+    __m128i k1 = _mm_unpackhi_epi16(k, k);
+    res[0] = _mm_or_si128(_mm_and_si128(k0, a[0]), _mm_andnot_si128(k0, b[0]));
+    res[1] = _mm_or_si128(_mm_and_si128(k1, a[1]), _mm_andnot_si128(k1, b[1]));
+#endif
+}
+
+/**
+ * Compare raw pixels
+ * @return the result of the comparison in 16 bit lanes
+ */
+static inline __m128i sse2_equal(const __m128i * a, const __m128i * b)
+{
+#if LV_COLOR_DEPTH == 16
+    return _mm_cmpeq_epi16(a[0], b[0]);
+#else
+    return _mm_packs_epi32(_mm_cmpeq_epi32(a[0], b[0]), _mm_cmpeq_epi32(a[1], b[1]));
+#endif
+}
+
+/**
+ * Mix a channel of the foreground and the background like `lv_color_mix`
+ */
+static inline __m128i sse2_mix(__m128i fg, __m128i bg, __m128i o, __m128i o_inv)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(fg, o), _mm_mullo_epi16(bg, o_inv)), 8);
+}
+
+static int32_t sse2_blend_row(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * mask, int32_t len,
+                              lv_color_t color, lv_opa_t opa, lv_blend_mode_t mode)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(-1);
+    const __m128i ff   = _mm_set1_epi16(0xFF);
+    const __m128i v_opa = _mm_set1_epi16(opa);
+    __m128i alpha[RAW_CNT];
+    uint8_t i;
+    for(i = 0; i < RAW_CNT; i++) alpha[i] = _mm_set1_epi32((int32_t)0xFF000000);
+
+    bool normal = mode == LV_BLEND_MODE_NORMAL ? true : false;
+    bool mask_only = mask && normal && opa > LV_OPA_MAX ? true : false;
+
+    sse2_px_t fg_color;
+    if(src == NULL) {
+#if LV_COLOR_DEPTH == 16
+        fg_color.raw[0] = _mm_set1_epi16((int16_t)color.full);
+#else
+        fg_color.raw[0] = _mm_set1_epi32((int32_t)color.full);
+        fg_color.raw[1] = fg_color.raw[0];
+#endif
+        sse2_split(&fg_color);
+    }
+
+    int32_t x;
+    for(x = 0; x + 8 <= len; x += 8) {
+        __m128i o;
+        __m128i keep;
+        __m128i take;
+        if(mask == NULL) {
+            o = v_opa;
+            keep = normal || opa > LV_OPA_MIN ? zero : ones;
+            take = !normal && opa == LV_OPA_COVER ? ones : zero;
+        } else {
+            __m128i m = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&mask[x]), zero);
+            if(mask_only) {
+                o = m;
+                if(src) {
+                    keep = _mm_cmplt_epi16(m, _mm_set1_epi16(LV_OPA_MIN));
+                    take = _mm_cmpgt_epi16(m, _mm_set1_epi16(LV_OPA_MAX));
+                } else {
+                    keep = _mm_cmpeq_epi16(m, zero);
+                    take = _mm_cmpeq_epi16(m, ff);
+                }
+            } else {
+                __m128i full = normal && src == NULL ? _mm_cmpeq_epi16(m, ff) : _mm_cmpgt_epi16(m, _mm_set1_epi16(LV_OPA_MAX - 1));
+                __m128i scaled = _mm_srli_epi16(_mm_mullo_epi16(m, v_opa), 8);
+                o = _mm_or_si128(_mm_and_si128(full, v_opa), _mm_andnot_si128(full, scaled));
+                keep = _mm_cmpeq_epi16(m, zero);
+                if(normal) {
+                    if(src == NULL) keep = _mm_or_si128(keep, _mm_cmpeq_epi16(o, zero));
+                    take = zero;
+                } else {
+                    keep = _mm_or_si128(keep, _mm_cmplt_epi16(o, _mm_set1_epi16(LV_OPA_MIN + 1)));
+                    take = _mm_cmpeq_epi16(o, ff);
+                }
+            }
+        }
+
+        /*Skip if all pixels remain unchanged*/
+        if(_mm_movemask_epi8(keep) == 0xFFFF) continue;
+
+        sse2_px_t bg;
+        bg.raw[0] = _mm_loadu_si128((const __m128i *)&dest[x]);
+#if LV_COLOR_DEPTH == 32
+        bg.raw[1] = _mm_loadu_si128((const __m128i *)&dest[x + 4]);
+#endif
+        sse2_split(&bg);
+
+        sse2_px_t fg;
+        if(src) {
+            fg.raw[0] = _mm_loadu_si128((const __m128i *)&src[x]);
+#if LV_COLOR_DEPTH == 32
+            fg.raw[1] = _mm_loadu_si128((const __m128i *)&src[x + 4]);
+#endif
+            sse2_split(&fg);
+        } else {
+            fg = fg_color;
+            /*Where the color is already there it's simply copied*/
+            if(mask_only) take = _mm_or_si128(take, sse2_equal(bg.raw, fg.raw));
+        }
+
+        if(!normal) {
+            if(mode == LV_BLEND_MODE_ADDITIVE) {
+                fg.r = _mm_min_epi16(_mm_add_epi16(fg.r, bg.r), _mm_set1_epi16(CH_MAX_R));
+                fg.g = _mm_min_epi16(_mm_add_epi16(fg.g, bg.g), _mm_set1_epi16(CH_MAX_G));
+                fg.b = _mm_min_epi16(_mm_add_epi16(fg.b, bg.b), _mm_set1_epi16(CH_MAX_B));
+            } else {
+                fg.r = _mm_subs_epu16(bg.r, fg.r);
+                fg.g = _mm_subs_epu16(bg.g, fg.g);
+                fg.b = _mm_subs_epu16(bg.b, fg.b);
+            }
+            /*Keep the alpha of the foreground*/
+            __m128i fg_alpha[RAW_CNT];
+            for(i = 0; i < RAW_CNT; i++) fg_alpha[i] = _mm_and_si128(fg.raw[i], alpha[i]);
+            sse2_join(&fg, fg_alpha);
+        }
+
+        __m128i o_inv = _mm_sub_epi16(ff, o);
+        sse2_px_t res;
+        res.r = sse2_mix(fg.r, bg.r, o, o_inv);
+        res.g = sse2_mix(fg.g, bg.g, o, o_inv);
+        res.b = sse2_mix(fg.b, bg.b, o, o_inv);
+        sse2_join(&res, alpha);
+
+        sse2_select(take, fg.raw, res.raw, res.raw);
+        sse2_select(keep, bg.raw, res.raw, res.raw);
+
+        _mm_storeu_si128((__m128i *)&dest[x], res.raw[0]);
+#if LV_COLOR_DEPTH == 32
+        _mm_storeu_si128((__m128i *)&dest[x + 4], res.raw[1]);
+#endif
+    }
+
+    return x;
+}
+
+#endif /*LV_BLEND_SIMD_SSE2*/
+
+#if LV_BLEND_SIMD_AVX2
+
+/* The pack and unpack instructions of AVX2 work in 128 bit lanes.
+ * `_mm256_permute4x64_epi64(v, 0xD8)` swaps the middle 64 bit parts to get (or prepare) the natural order.*/
+
+/**
+ * Split the raw pixels to channels
+ * @param px pointer to pixels with `raw` set
+ */
+static inline AVX2_ATTR void avx2_split(avx2_px_t * px)
+{
+#if LV_COLOR_DEPTH == 16
+    __m256i v = px->raw[0];
+#if LV_COLOR_16_SWAP
+    v = _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8));
+#endif
+    px->r = _mm256_srli_epi16(v, 11);
+    px->g = _mm256_and_si256(_mm256_srli_epi16(v, 5), _mm256_set1_epi16(0x3F));
+    px->b = _mm256_and_si256(v, _mm256_set1_epi16(0x1F));
+#else
+    const __m256i m = _mm256_set1_epi32(0xFF);
+    px->b = _mm256_packs_epi32(_mm256_and_si256(px->raw[0], m), _mm256_and_si256(px->raw[1], m));
+    px->g = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(px->raw[0], 8), m),
+                               _mm256_and_si256(_mm256_srli_epi32(px->raw[1], 8), m));
+    px->r = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(px->raw[0], 16), m),
+                               _mm256_and_si256(_mm256_srli_epi32(px->raw[1], 16), m));
+    px->b = _mm256_permute4x64_epi64(px->b, 0xD8);
+    px->g = _mm256_permute4x64_epi64(px->g, 0xD8);
+    px->r = _mm256_permute4x64_epi64(px->r, 0xD8);
+#endif
+}
+
+/**
+ * Join the channels to raw pixels
+ * @param px pointer to pixels with the channels set
+ * @param alpha the alpha bits of the raw pixels (used only with 32 bit color depth)
+ */
+static inline AVX2_ATTR void avx2_join(avx2_px_t * px, const __m256i * alpha)
+{
+#if LV_COLOR_DEPTH == 16
+    (void)alpha;    /*Unused*/
+    __m256i v = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(px->r, 11), _mm256_slli_epi16(px->g, 5)), px->b);
+#if LV_COLOR_16_SWAP
+    v = _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8));
+#endif
+    px->raw[0] = v;
+#else
+    const __m256i z = _mm256_setzero_si256();
+    __m256i b = _mm256_permute4x64_epi64(px->b, 0xD8);
+    __m256i g = _mm256_permute4x64_epi64(px->g, 0xD8);
+    __m256i r = _mm256_permute4x64_epi64(px->r, 0xD8);
+    px->raw[0] = _mm256_or_si256(_mm256_or_si256(_mm256_unpacklo_epi16(b, z), _mm256_slli_epi32(_mm256_unpacklo_epi16(g, z), 8)),
+                                 _mm256_or_si256(_mm256_slli_epi32(_mm256_unpacklo_epi16(r, z), 16), alpha[0]));
+    px->raw[1] = _mm256_or_si256(_mm256_or_si256(_mm256_unpackhi_epi16(b, z), _mm256_slli_epi32(_mm256_unpackhi_epi16(g, z), 8)),
+                                 _mm256_or_si256(_mm256_slli_epi32(_mm256_unpackhi_epi16(r, z), 16), alpha[1]));
+#endif
+}
+
+/**
+ * Select raw pixels: `res = k ? a : b`
+ * @param k the condition in 16 bit lanes
+ * @param a raw pixels to use where `k` is set
+ * @param b raw pixels to use where `k` is cleared
+ * @param res store the result here
+ */
+static inline AVX2_ATTR void avx2_select(__m256i k, const __m256i * a, const __m256i * b, __m256i * res)
+{
+#if LV_COLOR_DEPTH == 16
+    res[0] = _mm256_blendv_epi8(b[0], a[0], k);
+#else
+    k = _mm256_permute4x64_epi64(k, 0xD8);
+    res[0] = _mm256_blendv_epi8(b[0], a[0], _mm256_unpacklo_epi16(k, k));
+    res[1] = _mm256_blendv_epi8(b[1], a[1], _mm256_unpackhi_epi16(k, k));
+#endif
+}
+
+/**
+ * Compare raw pixels
+ * @return the result of the comparison in 16 bit lanes
+ */
+static inline AVX2_ATTR __m256i avx2_equal(const __m256i * a, const __m256i * b)
+{
+#if LV_COLOR_DEPTH == 16
+    return _mm256_cmpeq_epi16(a[0], b[0]);
+#else
+    __m256i e = _mm256_packs_epi32(_mm256_cmpeq_epi32(a[0], b[0]), _mm256_cmpeq_epi32(a[1], b[1]));
+    return _mm256_permute4x64_epi64(e, 0xD8);
+#endif
+}
+
+/**
+ * Mix a channel of the foreground and the background like `lv_color_mix`
+ */
+static inline AVX2_ATTR __m256i avx2_mix(__m256i fg, __m256i bg, __m256i o, __m256i o_inv)
+{
+    return _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(fg, o), _mm256_mullo_epi16(bg, o_inv)), 8);
+}
+
+static int32_t avx2_blend_row(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * mask, int32_t len,
+                              lv_color_t color, lv_opa_t opa, lv_blend_mode_t mode)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16(-1);
+    const __m256i ff   = _mm256_set1_epi16(0xFF);
+    const __m256i v_opa = _mm256_set1_epi16(opa);
+    __m256i alpha[RAW_CNT];
+    uint8_t i;
+    for(i = 0; i < RAW_CNT; i++) alpha[i] = _mm256_set1_epi32((int32_t)0xFF000000);
+
+    bool normal = mode == LV_BLEND_MODE_NORMAL ? true : false;
+    bool mask_only = mask && normal && opa > LV_OPA_MAX ? true : false;
+
+    avx2_px_t fg_color;
+    if(src == NULL) {
+#if LV_COLOR_DEPTH == 16
+        fg_color.raw[0] = _mm256_set1_epi16((int16_t)color.full);
+#else
+        fg_color.raw[0] = _mm256_set1_epi32((int32_t)color.full);
+        fg_color.raw[1] = fg_color.raw[0];
+#endif
+        avx2_split(&fg_color);
+    }
+
+    int32_t x;
+    for(x = 0; x + 16 <= len; x += 16) {
+        __m256i o;
+        __m256i keep;
+        __m256i take;
+        if(mask == NULL) {
+            o = v_opa;
+            keep = normal || opa > LV_OPA_MIN ? zero : ones;
+            take = !normal && opa == LV_OPA_COVER ? ones : zero;
+        } else {
+            __m256i m = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&mask[x]));
+            if(mask_only) {
+                o = m;
+                if(src) {
+                    keep = _mm256_cmpgt_epi16(_mm256_set1_epi16(LV_OPA_MIN), m);
+                    take = _mm256_cmpgt_epi16(m, _mm256_set1_epi16(LV_OPA_MAX));
+                } else {
+                    keep = _mm256_cmpeq_epi16(m, zero);
+                    take = _mm256_cmpeq_epi16(m, ff);
+                }
+            } else {
+                __m256i full = normal && src == NULL ? _mm256_cmpeq_epi16(m, ff) : _mm256_cmpgt_epi16(m, _mm256_set1_epi16(LV_OPA_MAX - 1));
+                __m256i scaled = _mm256_srli_epi16(_mm256_mullo_epi16(m, v_opa), 8);
+                o = _mm256_blendv_epi8(scaled, v_opa, full);
+                keep = _mm256_cmpeq_epi16(m, zero);
+                if(normal) {
+                    if(src == NULL) keep = _mm256_or_si256(keep, _mm256_cmpeq_epi16(o, zero));
+                    take = zero;
+                } else {
+                    keep = _mm256_or_si256(keep, _mm256_cmpgt_epi16(_mm256_set1_epi16(LV_OPA_MIN + 1), o));
+                    take = _mm256_cmpeq_epi16(o, ff);
+                }
+            }
+        }
+
+        /*Skip if all pixels remain unchanged*/
+        if(_mm256_movemask_epi8(keep) == -1) continue;
+
+        avx2_px_t bg;
+        bg.raw[0] = _mm256_loadu_si256((const __m256i *)&dest[x]);
+#if LV_COLOR_DEPTH == 32
+        bg.raw[1] = _mm256_loadu_si256((const __m256i *)&dest[x + 8]);
+#endif
+        avx2_split(&bg);
+
+        avx2_px_t fg;
+        if(src) {
+            fg.raw[0] = _mm256_loadu_si256((const __m256i *)&src[x]);
+#if LV_COLOR_DEPTH == 32
+            fg.raw[1] = _mm256_loadu_si256((const __m256i *)&src[x + 8]);
+#endif
+            avx2_split(&fg);
+        } else {
+            fg = fg_color;
+            /*Where the color is already there it's simply copied*/
+            if(mask_only) take = _mm256_or_si256(take, avx2_equal(bg.raw, fg.raw));
+        }
+
+        if(!normal) {
+            if(mode == LV_BLEND_MODE_ADDITIVE) {
+                fg.r = _mm256_min_epi16(_mm256_add_epi16(fg.r, bg.r), _mm256_set1_epi16(CH_MAX_R));
+                fg.g = _mm256_min_epi16(_mm256_add_epi16(fg.g, bg.g), _mm256_set1_epi16(CH_MAX_G));
+                fg.b = _mm256_min_epi16(_mm256_add_epi16(fg.b, bg.b), _mm256_set1_epi16(CH_MAX_B));
+            } else {
+                fg.r = _mm256_subs_epu16(bg.r, fg.r);
+                fg.g = _mm256_subs_epu16(bg.g, fg.g);
+                fg.b = _mm256_subs_epu16(bg.b, fg.b);
+            }
+            /*Keep the alpha of the foreground*/
+            __m256i fg_alpha[RAW_CNT];
+            for(i = 0; i < RAW_CNT; i++) fg_alpha[i] = _mm256_and_si256(fg.raw[i], alpha[i]);
+            avx2_join(&fg, fg_alpha);
+        }
+
+        __m256i o_inv = _mm256_sub_epi16(ff, o);
+        avx2_px_t res;
+        res.r = avx2_mix(fg.r, bg.r, o, o_inv);
+        res.g = avx2_mix(fg.g, bg.g, o, o_inv);
+        res.b = avx2_mix(fg.b, bg.b, o, o_inv);
+        avx2_join(&res, alpha);
+
+        avx2_select(take, fg.raw, res.raw, res.raw);
+        avx2_select(keep, bg.raw, res.raw, res.raw);
+
+        _mm256_storeu_si256((__m256i *)&dest[x], res.raw[0]);
+#if LV_COLOR_DEPTH == 32
+        _mm256_storeu_si256((__m256i *)&dest[x + 8], res.raw[1]);
+#endif
+    }
+
+    return x;
+}
+
+#endif /*LV_BLEND_SIMD_AVX2*/
+
+#if LV_BLEND_SIMD_NEON
+
+/**
+ * Load raw pixels and split them to channels
+ * @param p pointer to the first pixel to load
+ * @param px store the pixels here
+ */
+static inline void neon_load(const lv_color_t * p, neon_px_t * px)
+{
+#if LV_COLOR_DEPTH == 16
+    px->raw = vld1q_u16((const uint16_t *)p);
+    uint16x8_t v = px->raw;
+#if LV_COLOR_16_SWAP
+    v = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(v)));
+#endif
+    px->r = vshrq_n_u16(v, 11);
+    px->g = vandq_u16(vshrq_n_u16(v, 5), vdupq_n_u16(0x3F));
+    px->b = vandq_u16(v, vdupq_n_u16(0x1F));
+#else
+    px->raw = vld4_u8((const uint8_t *)p);
+    px->b = vmovl_u8(px->raw.val[0]);
+    px->g = vmovl_u8(px->raw.val[1]);
+    px->r = vmovl_u8(px->raw.val[2]);
+#endif
+}
+
+/**
+ * Join the channels to raw pixels
+ * @param px pointer to pixels with the channels set
+ * @param alpha the alpha of the raw pixels (used only with 32 bit color depth)
+ */
+static inline void neon_join(neon_px_t * px, uint8x8_t alpha)
+{
+#if LV_COLOR_DEPTH == 16
+    (void)alpha;    /*Unused*/
+    uint16x8_t v = vorrq_u16(vorrq_u16(vshlq_n_u16(px->r, 11), vshlq_n_u16(px->g, 5)), px->b);
+#if LV_COLOR_16_SWAP
+    v = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(v)));
+#endif
+    px->raw = v;
+#else
+    px->raw.val[0] = vmovn_u16(px->b);
+    px->raw.val[1] = vmovn_u16(px->g);
+    px->raw.val[2] = vmovn_u16(px->r);
+    px->raw.val[3] = alpha;
+#endif
+}
+
+/**
+ * Select raw pixels: `res = k ? a : b`
+ * @param k the condition in 16 bit lanes
+ * @param a pixels to use where `k` is set
+ * @param b pixels to use where `k` is cleared
+ * @param res store the result here
+ */
+static inline void neon_select(uint16x8_t k, const neon_px_t * a, const neon_px_t * b, neon_px_t * res)
+{
+#if LV_COLOR_DEPTH == 16
+    res->raw = vbslq_u16(k, a->raw, b->raw);
+#else
+    uint8x8_t k8 = vmovn_u16(k);
+    uint8_t i;
+    for(i = 0; i < 4; i++) res->raw.val[i] = vbsl_u8(k8, a->raw.val[i], b->raw.val[i]);
+#endif
+}
+
+/**
+ * Compare raw pixels
+ * @return the result of the comparison in 16 bit lanes
+ */
+static inline uint16x8_t neon_equal(const neon_px_t * a, const neon_px_t * b)
+{
+#if LV_COLOR_DEPTH == 16
+    return vceqq_u16(a->raw, b->raw);
+#else
+    uint8x8_t e = vand_u8(vand_u8(vceq_u8(a->raw.val[0], b->raw.val[0]), vceq_u8(a->raw.val[1], b->raw.val[1])),
+                          vand_u8(vceq_u8(a->raw.val[2], b->raw.val[2]), vceq_u8(a->raw.val[3], b->raw.val[3])));
+    return vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(e)));
+#endif
+}
+
+/**
+ * Mix a channel of the foreground and the background like `lv_color_mix`
+ */
+static inline uint16x8_t neon_mix(uint16x8_t fg, uint16x8_t bg, uint16x8_t o, uint16x8_t o_inv)
+{
+    return vshrq_n_u16(vmlaq_u16(vmulq_u16(fg, o), bg, o_inv), 8);
+}
+
+static int32_t neon_blend_row(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * mask, int32_t len,
+                              lv_color_t color, lv_opa_t opa, lv_blend_mode_t mode)
+{
+    const uint16x8_t zero = vdupq_n_u16(0);
+    const uint16x8_t ones = vdupq_n_u16(0xFFFF);
+    const uint16x8_t ff   = vdupq_n_u16(0xFF);
+    const uint16x8_t v_opa = vdupq_n_u16(opa);
+
+    bool normal = mode == LV_BLEND_MODE_NORMAL ? true : false;
+    bool mask_only = mask && normal && opa > LV_OPA_MAX ? true : false;
+
+    neon_px_t fg_color;
+    if(src == NULL) {
+        lv_color_t color_buf[8];
+        uint8_t i;
+        for(i = 0; i < 8; i++) color_buf[i] = color;
+        neon_load(color_buf, &fg_color);
+    }
+
+    int32_t x;
+    for(x = 0; x + 8 <= len; x += 8) {
+        uint16x8_t o;
+        uint16x8_t keep;
+        uint16x8_t take;
+        if(mask == NULL) {
+            o = v_opa;
+            keep = normal || opa > LV_OPA_MIN ? zero : ones;
+            take = !normal && opa == LV_OPA_COVER ? ones : zero;
+        } else {
+            uint16x8_t m = vmovl_u8(vld1_u8(&mask[x]));
+            if(mask_only) {
+                o = m;
+                if(src) {
+                    keep = vcltq_u16(m, vdupq_n_u16(LV_OPA_MIN));
+                    take = vcgtq_u16(m, vdupq_n_u16(LV_OPA_MAX));
+                } else {
+                    keep = vceqq_u16(m, zero);
+                    take = vceqq_u16(m, ff);
+                }
+            } else {
+                uint16x8_t full = normal && src == NULL ? vceqq_u16(m, ff) : vcgeq_u16(m, vdupq_n_u16(LV_OPA_MAX));
+                uint16x8_t scaled = vshrq_n_u16(vmulq_u16(m, v_opa), 8);
+                o = vbslq_u16(full, v_opa, scaled);
+                keep = vceqq_u16(m, zero);
+                if(normal) {
+                    if(src == NULL) keep = vorrq_u16(keep, vceqq_u16(o, zero));
+                    take = zero;
+                } else {
+                    keep = vorrq_u16(keep, vcleq_u16(o, vdupq_n_u16(LV_OPA_MIN)));
+                    take = vceqq_u16(o, ff);
+                }
+            }
+        }
+
+        /*Skip if all pixels remain unchanged*/
+        uint16x4_t keep_all = vand_u16(vget_low_u16(keep), vget_high_u16(keep));
+        if(vget_lane_u64(vreinterpret_u64_u16(keep_all), 0) == UINT64_MAX) continue;
+
+        neon_px_t bg;
+        neon_load(&dest[x], &bg);
+
+        neon_px_t fg;
+        if(src) {
+            neon_load(&src[x], &fg);
+        } else {
+            fg = fg_color;
+            /*Where the color is already there it's simply copied*/
+            if(mask_only) take = vorrq_u16(take, neon_equal(&bg, &fg));
+        }
+
+        if(!normal) {
+            if(mode == LV_BLEND_MODE_ADDITIVE) {
+                fg.r = vminq_u16(vaddq_u16(fg.r, bg.r), vdupq_n_u16(CH_MAX_R));
+                fg.g = vminq_u16(vaddq_u16(fg.g, bg.g), vdupq_n_u16(CH_MAX_G));
+                fg.b = vminq_u16(vaddq_u16(fg.b, bg.b), vdupq_n_u16(CH_MAX_B));
+            } else {
+                fg.r = vqsubq_u16(bg.r, fg.r);
+                fg.g = vqsubq_u16(bg.g, fg.g);
+                fg.b = vqsubq_u16(bg.b, fg.b);
+            }
+            /*Keep the alpha of the foreground*/
+#if LV_COLOR_DEPTH == 32
+            neon_join(&fg, fg.raw.val[3]);
+#else
+            neon_join(&fg, vdup_n_u8(0xFF));
+#endif
+        }
+
+        uint16x8_t o_inv = vsubq_u16(ff, o);
+        neon_px_t res;
+        res.r = neon_mix(fg.r, bg.r, o, o_inv);
+        res.g = neon_mix(fg.g, bg.g, o, o_inv);
+        res.b = neon_mix(fg.b, bg.b, o, o_inv);
+        neon_join(&res, vdup_n_u8(0xFF));
+
+        neon_select(take, &fg, &res, &res);
+        neon_select(keep, &bg, &res, &res);
+
+#if LV_COLOR_DEPTH == 16
+        vst1q_u16((uint16_t *)&dest[x], res.raw);
+#else
+        vst4_u8((uint8_t *)&dest[x], res.raw);
+#endif
+    }
+
+    return x;
+}
+
+#endif /*LV_BLEND_SIMD_NEON*/
+
+#endif /*LV_BLEND_SIMD*/
@@ -0,0 +1,102 @@
+/**
+ * @file lv_draw_blend_simd.h
+ * Blend rows of pixels with SIMD instructions (SSE2/AVX2 or NEON)
+ */
+
+#ifndef LV_DRAW_BLEND_SIMD_H
+#define LV_DRAW_BLEND_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "lv_draw_blend.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Find the instruction set supported by the compiler. Only 16 and 32 bit color depths are handled.*/
+#if LV_USE_BLEND_SIMD && (LV_COLOR_DEPTH == 16 || LV_COLOR_DEPTH == 32)
+#  if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define LV_BLEND_SIMD_SSE2  1
+/*AVX2 is compiled with function attributes and used only if the CPU supports it*/
+#    if defined(__GNUC__)
+#      define LV_BLEND_SIMD_AVX2  1
+#    endif
+#  elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    define LV_BLEND_SIMD_NEON  1
+#  endif
+#endif
+
+#ifndef LV_BLEND_SIMD_SSE2
+#define LV_BLEND_SIMD_SSE2  0
+#endif
+
+#ifndef LV_BLEND_SIMD_AVX2
+#define LV_BLEND_SIMD_AVX2  0
+#endif
+
+#ifndef LV_BLEND_SIMD_NEON
+#define LV_BLEND_SIMD_NEON  0
+#endif
+
+#define LV_BLEND_SIMD   (LV_BLEND_SIMD_SSE2 || LV_BLEND_SIMD_NEON)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_BLEND_SIMD
+
+/**
+ * Select the fastest instruction set supported by the CPU
+ */
+void lv_blend_simd_init(void);
+
+/**
+ * Blend a color on a row of pixels.
+ * The result is the same as `lv_blend_fill`'s with the same parameters.
+ * @param dest pointer to the first pixel to blend
+ * @param mask opacity of each pixel or NULL if there is no mask (`LV_DRAW_MASK_RES_FULL_COVER`)
+ * @param len number of pixels in the row
+ * @param color the color to blend
+ * @param opa opacity of the color. If `mode` is `LV_BLEND_MODE_NORMAL` and `mask` is NULL should be <= `LV_OPA_MAX`
+ * @param mode the blend mode
+ * @return number of blended pixels from the beginning of the row. The rest should be blended by the caller.
+ */
+int32_t lv_blend_simd_fill(lv_color_t * dest, const lv_opa_t * mask, int32_t len, lv_color_t color, lv_opa_t opa,
+                           lv_blend_mode_t mode);
+
+/**
+ * Blend a row of pixels on an other row of pixels.
+ * The result is the same as `lv_blend_map`'s with the same parameters.
+ * @param dest pointer to the first pixel to blend
+ * @param src pointer to the first pixel to blend on `dest`
+ * @param mask opacity of each pixel or NULL if there is no mask (`LV_DRAW_MASK_RES_FULL_COVER`)
+ * @param len number of pixels in the row
+ * @param opa opacity of `src`. If `mode` is `LV_BLEND_MODE_NORMAL` and `mask` is NULL should be <= `LV_OPA_MAX`
+ * @param mode the blend mode
+ * @return number of blended pixels from the beginning of the row. The rest should be blended by the caller.
+ */
+int32_t lv_blend_simd_map(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * mask, int32_t len, lv_opa_t opa,
+                          lv_blend_mode_t mode);
+
+#endif /*LV_BLEND_SIMD*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_BLEND_SIMD_H*/
@@ -8,11 +8,13 @@
  *********************/
 #include "lv_draw_img.h"
 #include "lv_img_cache.h"
+#include "lv_draw_backend.h"
 #include "../lv_hal/lv_hal_disp.h"
 #include "../lv_misc/lv_log.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_mem.h"
 #include "../lv_misc/lv_math.h"
+#include "lv_draw.h"
 
 /*********************
  *      DEFINES
@@ -27,6 +29,8 @@
  **********************/
 static lv_res_t lv_img_draw_core(const lv_area_t * coords, const lv_area_t * mask, const void * src,
 	const lv_style_t * style, uint16_t angle, lv_point_t * pivot, uint16_t zoom, bool antialaias, lv_opa_t opa_scale);
+static lv_res_t lv_img_draw_entry(lv_img_cache_entry_t * cdsc, const lv_area_t * coords, const lv_area_t * mask,
+	const lv_style_t * style, lv_opa_t opa, uint16_t angle, lv_point_t * pivot, uint16_t zoom, bool antialaias);
 
 static void lv_draw_map(const lv_area_t * map_area, const lv_area_t * clip_area, const uint8_t * map_p, lv_opa_t opa,
 	bool chroma_key, bool alpha_byte, const lv_style_t * style, uint16_t angle, lv_point_t * pivot, uint16_t zoom, bool antialaias);
@@ -64,6 +68,10 @@ void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask, const void *
         return;
     }
 
+#if LV_USE_DRAW_BACKEND
+    if(lv_draw_backend_add_img(coords, mask, src, style, angle, center, zoom, antialias, opa_scale) == LV_RES_OK) return;
+#endif
+
     lv_res_t res;
     res = lv_img_draw_core(coords, mask, src, style, angle, center, zoom, antialias, opa_scale);
 
@@ -78,7 +86,7 @@ void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask, const void *
 /**
  * Get the pixel size of a color format in bits
  * @param cf a color format (`LV_IMG_CF_...`)
- * @return the pixel size in bits
+ * @return the pixel size in bits (the size of the decoded pixels for the compressed formats)
  */
 uint8_t lv_img_cf_get_px_size(lv_img_cf_t cf)
 {
@@ -88,8 +96,11 @@ uint8_t lv_img_cf_get_px_size(lv_img_cf_t cf)
     case LV_IMG_CF_UNKNOWN:
     case LV_IMG_CF_RAW: px_size = 0; break;
     case LV_IMG_CF_TRUE_COLOR:
-    case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED: px_size = LV_COLOR_SIZE; break;
-    case LV_IMG_CF_TRUE_COLOR_ALPHA: px_size = LV_IMG_PX_SIZE_ALPHA_BYTE << 3; break;
+    case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+    case LV_IMG_CF_RLE_TRUE_COLOR:
+    case LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED: px_size = LV_COLOR_SIZE; break;
+    case LV_IMG_CF_TRUE_COLOR_ALPHA:
+    case LV_IMG_CF_RLE_TRUE_COLOR_ALPHA: px_size = LV_IMG_PX_SIZE_ALPHA_BYTE << 3; break;
     case LV_IMG_CF_INDEXED_1BIT:
     case LV_IMG_CF_ALPHA_1BIT: px_size = 1; break;
     case LV_IMG_CF_INDEXED_2BIT:
@@ -115,6 +126,7 @@ bool lv_img_cf_is_chroma_keyed(lv_img_cf_t cf)
 
     switch(cf) {
     case LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED:
+    case LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED:
     case LV_IMG_CF_RAW_CHROMA_KEYED:
 #if LV_INDEXED_CHROMA
     case LV_IMG_CF_INDEXED_1BIT:
@@ -141,6 +153,7 @@ bool lv_img_cf_has_alpha(lv_img_cf_t cf)
 
     switch(cf) {
     case LV_IMG_CF_TRUE_COLOR_ALPHA:
+    case LV_IMG_CF_RLE_TRUE_COLOR_ALPHA:
     case LV_IMG_CF_RAW_ALPHA:
     case LV_IMG_CF_INDEXED_1BIT:
     case LV_IMG_CF_INDEXED_2BIT:
@@ -197,10 +210,53 @@ static lv_res_t lv_img_draw_core(const lv_area_t * coords, const lv_area_t * mas
     lv_opa_t opa =
             opa_scale == LV_OPA_COVER ? style->image.opa : (uint16_t)((uint16_t)style->image.opa * opa_scale) >> 8;
 
+    /*The image cache and the decoders are shared by the drawing threads*/
+    LV_DRAW_LOCK();
+#if LV_IMG_CACHE_ASYNC
+    /*Don't wait for the slow images. Nothing is drawn until they are opened in the background.*/
+    bool pending;
+    lv_img_cache_entry_t * cdsc = lv_img_cache_open_async(src, style, mask, &pending);
+#else
     lv_img_cache_entry_t * cdsc = lv_img_cache_open(src, style);
+#endif
+#if LV_USE_PARALLEL_DRAW
+    /*Don't let the other threads close the image while it's drawn*/
+    if(cdsc) cdsc->draw_cnt++;
+#endif
+    LV_DRAW_UNLOCK();
 
+#if LV_IMG_CACHE_ASYNC
+    if(pending) return LV_RES_OK;
+#endif
     if(cdsc == NULL) return LV_RES_INV;
 
+    lv_res_t res = lv_img_draw_entry(cdsc, coords, mask, style, opa, angle, pivot, zoom, antialias);
+
+#if LV_USE_PARALLEL_DRAW
+    LV_DRAW_LOCK();
+    cdsc->draw_cnt--;
+    LV_DRAW_UNLOCK();
+#endif
+
+    return res;
+}
+
+/**
+ * Draw an image opened in the image cache
+ * @param cdsc pointer to the cache entry of the image
+ * @param coords the coordinates of the image
+ * @param mask the image will be drawn only in this area
+ * @param style style of the image
+ * @param opa opacity of the image
+ * @param angle rotation angle of the image
+ * @param pivot rotation center of the image
+ * @param zoom zoom factor
+ * @param antialias anti-alias transformations (rotate, zoom) or not
+ * @return LV_RES_OK: drawn (or nothing to draw); LV_RES_INV: the image couldn't be read
+ */
+static lv_res_t lv_img_draw_entry(lv_img_cache_entry_t * cdsc, const lv_area_t * coords, const lv_area_t * mask,
+	const lv_style_t * style, lv_opa_t opa, uint16_t angle, lv_point_t * pivot, uint16_t zoom, bool antialias)
+{
     bool chroma_keyed = lv_img_cf_is_chroma_keyed(cdsc->dec_dsc.header.cf);
     bool alpha_byte   = lv_img_cf_has_alpha(cdsc->dec_dsc.header.cf);
 
@@ -303,9 +359,12 @@ static lv_res_t lv_img_draw_core(const lv_area_t * coords, const lv_area_t * mas
             union_ok = lv_area_intersect(&mask_line, mask, &line);
             if(union_ok == false) continue;
 
+            /*The decoder's state (e.g. the file position) is shared by the drawing threads*/
+            LV_DRAW_LOCK();
             read_res = lv_img_decoder_read_line(&cdsc->dec_dsc, x, y, width, buf);
+            if(read_res != LV_RES_OK) lv_img_decoder_close(&cdsc->dec_dsc);
+            LV_DRAW_UNLOCK();
             if(read_res != LV_RES_OK) {
-                lv_img_decoder_close(&cdsc->dec_dsc);
                 LV_LOG_WARN("Image draw can't read the line");
                 lv_mem_buf_release(buf);
                 return LV_RES_INV;
@@ -438,12 +497,50 @@ static void lv_draw_map(const lv_area_t * map_area, const lv_area_t * clip_area,
             map_px = map_buf_tmp;
             px_i_start = px_i;
 
-            for(x = 0; x < lv_area_get_width(&draw_area); x++, map_px += px_size_byte, px_i++) {
+            if(transform) {
+                /*Transform the whole row at once*/
+                lv_coord_t rot_x = (disp_area->x1 + draw_area.x1) - map_area->x1;
+                lv_coord_t rot_y = y + (disp_area->y1 + draw_area.y1) - map_area->y1;
+                lv_img_buf_transform_row(&trans_dsc, rot_x, rot_y, lv_area_get_width(&draw_area), &map2[px_i], &mask_buf[px_i]);
 
-                if(transform == false) {
+                /*Without premultiplied alpha the pixels need to be touched only for recoloring*/
+                if(LV_COLOR_PREMULT == 0 && style->image.intense == 0) {
+                    px_i += lv_area_get_width(&draw_area);
+                } else {
+                    for(x = 0; x < lv_area_get_width(&draw_area); x++, px_i++) {
+                        lv_opa_t px_opa = mask_buf[px_i];
+                        if(px_opa == LV_OPA_TRANSP) continue;
+
+                        c.full = map2[px_i].full;
+#if LV_COLOR_PREMULT
+                        /*The alpha is blended from the color's alpha channel*/
+                        mask_buf[px_i] = px_opa < LV_OPA_MIN ? LV_OPA_TRANSP : LV_OPA_COVER;
+                        c.ch.alpha = px_opa;
+#endif
+                        if(style->image.intense != 0) {
+#if LV_COLOR_PREMULT
+                            /*Recolor with the premultiplied color and keep the alpha*/
+                            lv_opa_t px_alpha = c.ch.alpha;
+                            c = lv_color_mix(lv_color_premult(style->image.color, px_alpha), c, style->image.intense);
+                            c.ch.alpha = px_alpha;
+#else
+                            c = lv_color_mix(style->image.color, c, style->image.intense);
+#endif
+                        }
+
+                        map2[px_i].full = c.full;
+                    }
+                }
+            } else {
+                for(x = 0; x < lv_area_get_width(&draw_area); x++, map_px += px_size_byte, px_i++) {
                     if(alpha_byte) {
                         lv_opa_t px_opa = map_px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+#if LV_COLOR_PREMULT
+                        /*The alpha is blended from the color's alpha channel*/
+                        mask_buf[px_i] = px_opa < LV_OPA_MIN ? LV_OPA_TRANSP : LV_OPA_COVER;
+#else
                         mask_buf[px_i] = px_opa;
+#endif
                         if(px_opa < LV_OPA_MIN) continue;
                     } else {
                         mask_buf[px_i] = LV_OPA_COVER;
@@ -462,26 +559,20 @@ static void lv_draw_map(const lv_area_t * map_area, const lv_area_t * clip_area,
                             continue;
                         }
                     }
-                } else {
-                    /*Rotate*/
-                    bool ret;
-                    lv_coord_t rot_x = x + (disp_area->x1 + draw_area.x1) - map_area->x1;
-                    lv_coord_t rot_y = y + (disp_area->y1 + draw_area.y1) - map_area->y1;
-                    ret = lv_img_buf_transform(&trans_dsc, rot_x, rot_y);
-                    if(ret == false) {
-                        mask_buf[px_i] = LV_OPA_TRANSP;
-                        continue;
-                    } else {
-                        mask_buf[px_i] = trans_dsc.res.opa;
-                        c.full = trans_dsc.res.color.full;
+
+                    if(style->image.intense != 0) {
+#if LV_COLOR_PREMULT
+                        /*Recolor with the premultiplied color and keep the alpha*/
+                        lv_opa_t px_alpha = c.ch.alpha;
+                        c = lv_color_mix(lv_color_premult(style->image.color, px_alpha), c, style->image.intense);
+                        c.ch.alpha = px_alpha;
+#else
+                        c = lv_color_mix(style->image.color, c, style->image.intense);
+#endif
                     }
-                }
 
-                if(style->image.intense != 0) {
-                    c = lv_color_mix(style->image.color, c, style->image.intense);
+                    map2[px_i].full = c.full;
                 }
-
-                map2[px_i].full = c.full;
             }
 
             /*Apply the masks if any*/
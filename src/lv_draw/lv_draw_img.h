@@ -61,7 +61,7 @@ lv_img_src_t lv_img_src_get_type(const void * src);
 /**
  * Get the pixel size of a color format in bits
  * @param cf a color format (`LV_IMG_CF_...`)
- * @return the pixel size in bits
+ * @return the pixel size in bits (the size of the decoded pixels for the compressed formats)
  */
 uint8_t lv_img_cf_get_px_size(lv_img_cf_t cf);
 
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_label.h"
+#include "lv_draw_backend.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_hal/lv_hal_disp.h"
 #include "../lv_core/lv_refr.h"
@@ -80,6 +81,12 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
     /*No need to waste processor time if string is empty*/
     if (txt[0] == '\0')  return;
 
+#if LV_USE_DRAW_BACKEND
+    if(lv_draw_backend_add_label(coords, mask, style, opa_scale, txt, flag, offset, sel, hint, bidi_dir) == LV_RES_OK) {
+        return;
+    }
+#endif
+
     if((flag & LV_TXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
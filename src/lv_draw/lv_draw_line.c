@@ -10,6 +10,7 @@
 #include <stdbool.h>
 #include "lv_draw.h"
 #include "lv_draw_mask.h"
+#include "lv_draw_backend.h"
 #include "lv_draw_blend.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_math.h"
@@ -17,10 +18,35 @@
 /*********************
  *      DEFINES
  *********************/
+/*Sample the edges of the polylines on this many sub-lines in a pixel row (vertical anti-aliasing)*/
+#define POLYLINE_SUBLINE_CNT    4
+#define POLYLINE_SUBLINE_SHIFT  2
+
+/*Number of points to get at once from the point callback of the polylines*/
+#define POLYLINE_PT_BLOCK       32
+
+/*Number of rows in the coverage buffer. The draw area is processed in chunks of this many rows.*/
+#define POLYLINE_BUF_ROWS       16
 
 /**********************
  *      TYPEDEFS
  **********************/
+/*A convex polygon with coordinates in 1/256 pixel units*/
+typedef struct
+{
+    int32_t x[4];
+    int32_t y[4];
+    uint8_t cnt;
+} lv_line_poly_t;
+
+/*A not horizontal edge of a polygon*/
+typedef struct
+{
+    int32_t y1;     /*Top (inclusive)*/
+    int32_t y2;     /*Bottom (exclusive)*/
+    int32_t x1;     /*X on the top*/
+    int32_t slope;  /*Change of x per 1 y in 1/65536 units*/
+} lv_line_edge_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -31,6 +57,11 @@ static void draw_line_hor(const lv_point_t * point1, const lv_point_t * point2,
         const lv_style_t * style, lv_opa_t opa_scale);
 static void draw_line_ver(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * clip,
         const lv_style_t * style, lv_opa_t opa_scale);
+static void polyline_array_point_cb(const void * user_data, uint16_t id, uint16_t cnt, lv_point_t * points);
+static bool polyline_get_normal(const lv_point_t * p1, const lv_point_t * p2, int32_t half_w, int32_t * nx, int32_t * ny);
+static void polyline_render_poly(const lv_line_poly_t * poly, const lv_area_t * chunk, lv_opa_t * cov_buf, uint16_t * sum_buf);
+static void polyline_render_rect(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const lv_area_t * chunk, lv_opa_t * cov_buf);
+static uint32_t polyline_sqrt(uint64_t x);
 
 
 /**********************
@@ -59,6 +90,10 @@ void lv_draw_line(const lv_point_t * point1, const lv_point_t * point2, const lv
     if(style->line.width == 0) return;
     if(point1->x == point2->x && point1->y == point2->y) return;
 
+#if LV_USE_DRAW_BACKEND
+    if(lv_draw_backend_add_line(point1, point2, clip, style, opa_scale) == LV_RES_OK) return;
+#endif
+
     lv_area_t clip_line;
     clip_line.x1 = LV_MATH_MIN(point1->x, point2->x) - style->line.width/2;
     clip_line.x2 = LV_MATH_MAX(point1->x, point2->x) + style->line.width/2;
@@ -74,6 +109,196 @@ void lv_draw_line(const lv_point_t * point1, const lv_point_t * point2, const lv
     else draw_line_skew(point1, point2, &clip_line, style, opa_scale);
 }
 
+/**
+ * Draw connected lines. The joints are drawn only once, so it's
+ * faster and looks better than drawing the lines one by one with `lv_draw_line`.
+ * @param points array of points (absolute coordinates)
+ * @param point_cnt number of points in `points`
+ * @param clip the lines will be drawn only on this area
+ * @param style pointer to a line's style
+ * @param opa_scale scale down all opacities by the factor
+ */
+void lv_draw_polyline(const lv_point_t * points, uint16_t point_cnt, const lv_area_t * clip,
+                      const lv_style_t * style, lv_opa_t opa_scale)
+{
+    lv_draw_polyline_cb(polyline_array_point_cb, points, point_cnt, clip, style, opa_scale);
+}
+
+/**
+ * Draw connected lines whose points are calculated on demand by a callback.
+ * Same as `lv_draw_polyline` but the points needn't to be stored.
+ * @param point_cb called to get consecutive points. Can be called more times with the same indices.
+ * @param user_data passed to `point_cb`
+ * @param point_cnt number of points
+ * @param clip the lines will be drawn only on this area
+ * @param style pointer to a line's style
+ * @param opa_scale scale down all opacities by the factor
+ */
+void lv_draw_polyline_cb(lv_draw_polyline_point_cb_t point_cb, const void * user_data, uint16_t point_cnt,
+                         const lv_area_t * clip, const lv_style_t * style, lv_opa_t opa_scale)
+{
+    if(style->line.width == 0) return;
+    if(point_cnt < 2) return;
+
+    lv_opa_t opa = style->line.opa;
+    if(opa_scale != LV_OPA_COVER) opa = (opa * opa_scale) >> 8;
+    if(opa < LV_OPA_MIN) return;
+
+    /*The lines and the joints can be at most this far from the points*/
+    lv_coord_t ext = (style->line.width >> 1) + 2;
+
+    /*The points are not stored so get them only while processing the chunks.
+     *The lines which can't reach the next chunks are not checked again.*/
+    lv_area_t draw_area;
+    lv_area_copy(&draw_area, clip);
+    uint16_t line_first = 0;
+    uint16_t line_last  = point_cnt - 2;
+    lv_point_t pt_block[POLYLINE_PT_BLOCK + 1];
+    uint16_t i;
+
+    lv_coord_t draw_area_w = lv_area_get_width(&draw_area);
+    lv_coord_t chunk_h = LV_MATH_MIN(POLYLINE_BUF_ROWS, lv_area_get_height(&draw_area));
+
+    /*A row of sub-line coverages and the coverage of the pixels of a chunk.
+     *Use less rows if there is not enough memory.*/
+    uint16_t * sum_buf = lv_mem_buf_get(draw_area_w * sizeof(uint16_t));
+    if(sum_buf == NULL) return;
+
+    lv_opa_t * cov_buf = lv_mem_buf_get(draw_area_w * chunk_h);
+    while(cov_buf == NULL && chunk_h > 1) {
+        chunk_h = chunk_h >> 1;
+        cov_buf = lv_mem_buf_get(draw_area_w * chunk_h);
+    }
+
+    if(cov_buf == NULL) {
+        lv_mem_buf_release(sum_buf);
+        return;
+    }
+
+    int16_t other_mask_cnt = lv_draw_mask_get_cnt();
+
+    /*Width in 1/256 units. The points are in the middle of a pixel with odd width (as in `lv_draw_line`)*/
+    int32_t half_w = style->line.width * 128;
+    int32_t ofs = (style->line.width & 0x1) ? 128 : 0;
+
+    lv_area_t chunk;
+    chunk.x1 = draw_area.x1;
+    chunk.x2 = draw_area.x2;
+    for(chunk.y1 = draw_area.y1; chunk.y1 <= draw_area.y2; chunk.y1 += chunk_h) {
+        chunk.y2 = LV_MATH_MIN(chunk.y1 + chunk_h - 1, draw_area.y2);
+        memset(cov_buf, LV_OPA_TRANSP, draw_area_w * lv_area_get_height(&chunk));
+
+        /*Normal vector of the previous line if it ends on the current point*/
+        bool prev_valid = false;
+        int32_t prev_nx = 0;
+        int32_t prev_ny = 0;
+        /*Only the lines reaching below this chunk need to be checked in the next chunks*/
+        uint16_t next_first = line_last + 1;
+        uint16_t next_last  = 0;
+
+        for(i = line_first; i <= line_last; i++) {
+            /*Get the start and end points of the next lines*/
+            uint16_t b = (i - line_first) % POLYLINE_PT_BLOCK;
+            if(b == 0) point_cb(user_data, i, LV_MATH_MIN(POLYLINE_PT_BLOCK, line_last - i + 1) + 1, pt_block);
+            const lv_point_t * p1 = &pt_block[b];
+            const lv_point_t * p2 = &pt_block[b + 1];
+
+            if(LV_MATH_MAX(p1->y, p2->y) + ext > chunk.y2) {
+                if(next_first > i) next_first = i;
+                next_last = i;
+            }
+
+            /*Skip the lines (and the joint on their start) out of the chunk*/
+            if(LV_MATH_MIN(p1->y, p2->y) - ext > chunk.y2 || LV_MATH_MAX(p1->y, p2->y) + ext < chunk.y1 ||
+               LV_MATH_MIN(p1->x, p2->x) - ext > chunk.x2 || LV_MATH_MAX(p1->x, p2->x) + ext < chunk.x1) {
+                prev_valid = false;
+                continue;
+            }
+
+            int32_t nx;
+            int32_t ny;
+            /*Zero length lines have no direction: keep the joint between the neighbors*/
+            if(polyline_get_normal(p1, p2, half_w, &nx, &ny) == false) continue;
+
+            int32_t x1 = (p1->x << 8) + ofs;
+            int32_t y1 = (p1->y << 8) + ofs;
+            int32_t x2 = (p2->x << 8) + ofs;
+            int32_t y2 = (p2->y << 8) + ofs;
+
+            lv_line_poly_t poly;
+            poly.cnt = 4;
+            poly.x[0] = x1 + nx;
+            poly.y[0] = y1 + ny;
+            poly.x[1] = x2 + nx;
+            poly.y[1] = y2 + ny;
+            poly.x[2] = x2 - nx;
+            poly.y[2] = y2 - ny;
+            poly.x[3] = x1 - nx;
+            poly.y[3] = y1 - ny;
+
+            /*Horizontal and vertical lines are rectangles whose coverage can be calculated directly*/
+            if(p1->x == p2->x || p1->y == p2->y) {
+                polyline_render_rect(LV_MATH_MIN(poly.x[0], poly.x[2]), LV_MATH_MIN(poly.y[0], poly.y[2]),
+                                     LV_MATH_MAX(poly.x[0], poly.x[2]), LV_MATH_MAX(poly.y[0], poly.y[2]), &chunk, cov_buf);
+            } else {
+                polyline_render_poly(&poly, &chunk, cov_buf, sum_buf);
+            }
+
+            /*Fill the gap between the previous and this line on the outer side of the joint (bevel join).
+             *If the line turns to the side of the previous normal vector the gap is on the other side.*/
+            int64_t turn = (int64_t)prev_nx * (p2->x - p1->x) + (int64_t)prev_ny * (p2->y - p1->y);
+            if(prev_valid && turn != 0) {
+                int32_t side = turn > 0 ? -1 : 1;
+                poly.cnt = 3;
+                poly.x[0] = x1;
+                poly.y[0] = y1;
+                poly.x[1] = x1 + side * prev_nx;
+                poly.y[1] = y1 + side * prev_ny;
+                poly.x[2] = x1 + side * nx;
+                poly.y[2] = y1 + side * ny;
+                polyline_render_poly(&poly, &chunk, cov_buf, sum_buf);
+            }
+
+            prev_valid = true;
+            prev_nx = nx;
+            prev_ny = ny;
+        }
+
+        /*Blend the covered part of the rows*/
+        lv_coord_t y;
+        for(y = chunk.y1; y <= chunk.y2; y++) {
+            lv_opa_t * cov_row = &cov_buf[(y - chunk.y1) * draw_area_w];
+            lv_coord_t first = 0;
+            lv_coord_t last = draw_area_w - 1;
+            while(first <= last && cov_row[first] == LV_OPA_TRANSP) first++;
+            if(first > last) continue;
+            while(cov_row[last] == LV_OPA_TRANSP) last--;
+
+            lv_area_t fill_area;
+            fill_area.x1 = draw_area.x1 + first;
+            fill_area.x2 = draw_area.x1 + last;
+            fill_area.y1 = y;
+            fill_area.y2 = y;
+
+            if(other_mask_cnt) {
+                lv_draw_mask_res_t mask_res;
+                mask_res = lv_draw_mask_apply(&cov_row[first], fill_area.x1, y, last - first + 1);
+                if(mask_res == LV_DRAW_MASK_RES_FULL_TRANSP) continue;
+            }
+
+            lv_blend_fill(clip, &fill_area, style->line.color, &cov_row[first], LV_DRAW_MASK_RES_CHANGED, opa,
+                          style->line.blend_mode);
+        }
+
+        if(next_first > next_last) break;
+        line_first = next_first;
+        line_last  = next_last;
+    }
+
+    lv_mem_buf_release(cov_buf);
+    lv_mem_buf_release(sum_buf);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -347,3 +572,217 @@ static void draw_line_skew(const lv_point_t * point1, const lv_point_t * point2,
     lv_draw_mask_remove_id(mask_top_id);
     lv_draw_mask_remove_id(mask_bottom_id);
 }
+
+/**
+ * Get points of an array. The point callback of `lv_draw_polyline`
+ * @param user_data pointer to the array of points
+ * @param id index of the first point
+ * @param cnt number of points to get
+ * @param points store the points here
+ */
+static void polyline_array_point_cb(const void * user_data, uint16_t id, uint16_t cnt, lv_point_t * points)
+{
+    const lv_point_t * array = user_data;
+    memcpy(points, &array[id], cnt * sizeof(lv_point_t));
+}
+
+/**
+ * Get the normal vector of a line with `half_w` length
+ * @param p1 first point of the line
+ * @param p2 second point of the line
+ * @param half_w half of the line width in 1/256 units
+ * @param nx store the x component of the normal vector here (1/256 units)
+ * @param ny store the y component of the normal vector here (1/256 units)
+ * @return false: zero length line without normal vector
+ */
+static bool polyline_get_normal(const lv_point_t * p1, const lv_point_t * p2, int32_t half_w, int32_t * nx, int32_t * ny)
+{
+    int32_t dx = p2->x - p1->x;
+    int32_t dy = p2->y - p1->y;
+    if(dx == 0 && dy == 0) return false;
+
+    /*Simple cases without square root*/
+    if(dx == 0) {
+        *nx = dy > 0 ? -half_w : half_w;
+        *ny = 0;
+        return true;
+    }
+
+    if(dy == 0) {
+        *nx = 0;
+        *ny = dx > 0 ? half_w : -half_w;
+        return true;
+    }
+
+    /*Length in 1/256 units*/
+    int64_t len = polyline_sqrt((uint64_t)((int64_t)dx * dx + (int64_t)dy * dy) << 16);
+
+    *nx = (int32_t)(((int64_t)-dy * half_w * 256) / len);
+    *ny = (int32_t)(((int64_t)dx * half_w * 256) / len);
+
+    return true;
+}
+
+/**
+ * Add the coverage of a convex polygon to the coverage buffer of a chunk.
+ * The overlapping parts of the polygons are not added twice but the greater coverage is used.
+ * @param poly pointer to a polygon
+ * @param chunk the area of the chunk (absolute coordinates)
+ * @param cov_buf coverage buffer of the chunk
+ * @param sum_buf a buffer for a row of the chunk to sum the coverages of the sub-lines
+ */
+static void polyline_render_poly(const lv_line_poly_t * poly, const lv_area_t * chunk, lv_opa_t * cov_buf, uint16_t * sum_buf)
+{
+    /*Get the not horizontal edges to find the intersections quickly in every sub-line*/
+    lv_line_edge_t edges[4];
+    uint8_t edge_cnt = 0;
+    int32_t y_min = poly->y[0];
+    int32_t y_max = poly->y[0];
+    uint8_t i;
+    for(i = 0; i < poly->cnt; i++) {
+        uint8_t j = i + 1 < poly->cnt ? i + 1 : 0;
+        y_min = LV_MATH_MIN(y_min, poly->y[i]);
+        y_max = LV_MATH_MAX(y_max, poly->y[i]);
+        if(poly->y[i] == poly->y[j]) continue;
+
+        lv_line_edge_t * e = &edges[edge_cnt];
+        uint8_t top = poly->y[i] < poly->y[j] ? i : j;
+        uint8_t bottom = top == i ? j : i;
+        e->y1 = poly->y[top];
+        e->y2 = poly->y[bottom];
+        e->x1 = poly->x[top];
+        e->slope = (int32_t)(((int64_t)(poly->x[bottom] - poly->x[top]) << 16) / (e->y2 - e->y1));
+        edge_cnt++;
+    }
+    if(edge_cnt < 2) return;
+
+    int32_t row_start = LV_MATH_MAX(y_min >> 8, chunk->y1);
+    int32_t row_end = LV_MATH_MIN(y_max >> 8, chunk->y2);
+    int32_t x_lim1 = chunk->x1 << 8;
+    int32_t x_lim2 = (chunk->x2 + 1) << 8;
+    lv_coord_t chunk_w = lv_area_get_width(chunk);
+
+    int32_t row;
+    for(row = row_start; row <= row_end; row++) {
+        /*The range of `sum_buf` used in this row. Cleared when extended.*/
+        int32_t used1 = 0;
+        int32_t used2 = -1;
+
+        uint8_t s;
+        for(s = 0; s < POLYLINE_SUBLINE_CNT; s++) {
+            int32_t y = (row << 8) + ((2 * s + 1) << 7) / POLYLINE_SUBLINE_CNT;
+            /*Find the intersections of the sub-line with the edges*/
+            int32_t xl = INT32_MAX;
+            int32_t xr = INT32_MIN;
+            uint8_t e;
+            for(e = 0; e < edge_cnt; e++) {
+                if(y < edges[e].y1 || y >= edges[e].y2) continue;
+                int32_t x = edges[e].x1 + (int32_t)(((int64_t)(y - edges[e].y1) * edges[e].slope) >> 16);
+                if(x < xl) xl = x;
+                if(x > xr) xr = x;
+            }
+
+            xl = LV_MATH_MAX(xl, x_lim1);
+            xr = LV_MATH_MIN(xr, x_lim2);
+            if(xl >= xr) continue;
+
+            /*Pixels relative to the chunk*/
+            int32_t px1 = (xl >> 8) - chunk->x1;
+            int32_t px2 = ((xr - 1) >> 8) - chunk->x1;
+
+            if(used1 > used2) {
+                memset(&sum_buf[px1], 0, (px2 - px1 + 1) * sizeof(uint16_t));
+                used1 = px1;
+                used2 = px2;
+            } else {
+                if(px1 < used1) {
+                    memset(&sum_buf[px1], 0, (used1 - px1) * sizeof(uint16_t));
+                    used1 = px1;
+                }
+                if(px2 > used2) {
+                    memset(&sum_buf[used2 + 1], 0, (px2 - used2) * sizeof(uint16_t));
+                    used2 = px2;
+                }
+            }
+
+            /*Add the covered part of the pixels*/
+            int32_t xl_rel = xl - x_lim1;
+            int32_t xr_rel = xr - x_lim1;
+            if(px1 == px2) {
+                sum_buf[px1] += xr_rel - xl_rel;
+            } else {
+                sum_buf[px1] += ((px1 + 1) << 8) - xl_rel;
+                int32_t px;
+                for(px = px1 + 1; px < px2; px++) sum_buf[px] += 256;
+                sum_buf[px2] += xr_rel - (px2 << 8);
+            }
+        }
+
+        if(used1 > used2) continue;
+
+        /*Convert to opacity and keep the greater coverage*/
+        lv_opa_t * cov_row = &cov_buf[(row - chunk->y1) * chunk_w];
+        int32_t px;
+        for(px = used1; px <= used2; px++) {
+            lv_opa_t cov = (sum_buf[px] * 255) >> (8 + POLYLINE_SUBLINE_SHIFT);
+            if(cov > cov_row[px]) cov_row[px] = cov;
+        }
+    }
+}
+
+/**
+ * Add the coverage of a rectangle to the coverage buffer of a chunk.
+ * The overlapping parts are not added twice but the greater coverage is used.
+ * @param x1 left edge in 1/256 units
+ * @param y1 top edge in 1/256 units
+ * @param x2 right edge in 1/256 units
+ * @param y2 bottom edge in 1/256 units
+ * @param chunk the area of the chunk (absolute coordinates)
+ * @param cov_buf coverage buffer of the chunk
+ */
+static void polyline_render_rect(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const lv_area_t * chunk, lv_opa_t * cov_buf)
+{
+    int32_t row_start = LV_MATH_MAX(y1 >> 8, chunk->y1);
+    int32_t row_end = LV_MATH_MIN((y2 - 1) >> 8, chunk->y2);
+    int32_t col_start = LV_MATH_MAX(x1 >> 8, chunk->x1);
+    int32_t col_end = LV_MATH_MIN((x2 - 1) >> 8, chunk->x2);
+    if(row_start > row_end || col_start > col_end) return;
+
+    lv_coord_t chunk_w = lv_area_get_width(chunk);
+    int32_t row;
+    for(row = row_start; row <= row_end; row++) {
+        int32_t cov_y = LV_MATH_MIN(y2, (row + 1) << 8) - LV_MATH_MAX(y1, row << 8);
+        lv_opa_t * cov_row = &cov_buf[(row - chunk->y1) * chunk_w - chunk->x1];
+        int32_t col;
+        for(col = col_start; col <= col_end; col++) {
+            int32_t cov_x = LV_MATH_MIN(x2, (col + 1) << 8) - LV_MATH_MAX(x1, col << 8);
+            lv_opa_t cov = (cov_x * cov_y * 255) >> 16;
+            if(cov > cov_row[col]) cov_row[col] = cov;
+        }
+    }
+}
+
+/**
+ * Integer square root
+ * @param x a number
+ * @return the integer part of the square root of `x`
+ */
+static uint32_t polyline_sqrt(uint64_t x)
+{
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while(bit > x) bit >>= 2;
+
+    while(bit != 0) {
+        if(x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)res;
+}
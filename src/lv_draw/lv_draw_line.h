@@ -22,6 +22,15 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/**
+ * Get consecutive points of a polyline. Used to draw lines without storing their points.
+ * @param user_data the `user_data` parameter of `lv_draw_polyline_cb`
+ * @param id index of the first point
+ * @param cnt number of points to get
+ * @param points store the points here (absolute coordinates)
+ */
+typedef void (*lv_draw_polyline_point_cb_t)(const void * user_data, uint16_t id, uint16_t cnt, lv_point_t * points);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -37,6 +46,31 @@ extern "C" {
 void lv_draw_line(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * mask,
                   const lv_style_t * style, lv_opa_t opa_scale);
 
+/**
+ * Draw connected lines. The joints are drawn only once, so it's
+ * faster and looks better than drawing the lines one by one with `lv_draw_line`.
+ * @param points array of points (absolute coordinates)
+ * @param point_cnt number of points in `points`
+ * @param mask the lines will be drawn only on this area
+ * @param style pointer to a line's style
+ * @param opa_scale scale down all opacities by the factor
+ */
+void lv_draw_polyline(const lv_point_t * points, uint16_t point_cnt, const lv_area_t * mask,
+                      const lv_style_t * style, lv_opa_t opa_scale);
+
+/**
+ * Draw connected lines whose points are calculated on demand by a callback.
+ * Same as `lv_draw_polyline` but the points needn't to be stored.
+ * @param point_cb called to get consecutive points. Can be called more times with the same indices.
+ * @param user_data passed to `point_cb`
+ * @param point_cnt number of points
+ * @param mask the lines will be drawn only on this area
+ * @param style pointer to a line's style
+ * @param opa_scale scale down all opacities by the factor
+ */
+void lv_draw_polyline_cb(lv_draw_polyline_point_cb_t point_cb, const void * user_data, uint16_t point_cnt,
+                         const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale);
+
 /**********************
  *      MACROS
  **********************/
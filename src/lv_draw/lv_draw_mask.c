@@ -10,6 +10,14 @@
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_log.h"
 #include "../lv_core/lv_debug.h"
+#include "../lv_misc/lv_profiler.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_gc.h"
+#include "lv_draw.h"
+
+#if defined(LV_GC_INCLUDE)
+#include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
 
 /*********************
  *      DEFINES
@@ -25,11 +33,25 @@ typedef struct
     void * custom_id;
 }lv_mask_saved_t;
 
+#if LV_USE_RADIUS_CACHE
+/** Opacity of the pixels in the top left corner of the rounded rectangles with a given radius.
+ * The other corners are its mirrors.*/
+typedef struct _lv_draw_mask_radius_cache_t
+{
+    lv_coord_t radius;
+    uint32_t last_frame;    /*The frame when the corner was last used*/
+    uint32_t size;          /*Size of `first` and `map` together in bytes*/
+    lv_coord_t * first;     /*Index of the first not transparent pixel in each row*/
+    lv_opa_t * map;         /*`radius x radius` opacities, row by row from the top of the corner*/
+}lv_draw_mask_radius_cache_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_draw_mask_res_t lv_draw_mask_line(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_draw_mask_line_param_t * param);
 static lv_draw_mask_res_t lv_draw_mask_radius(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_draw_mask_radius_param_t * param);
+static lv_draw_mask_res_t lv_draw_mask_radius_calc(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_draw_mask_radius_param_t * param);
 static lv_draw_mask_res_t lv_draw_mask_angle(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_draw_mask_angle_param_t * param);
 static lv_draw_mask_res_t lv_draw_mask_fade(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_draw_mask_fade_param_t * param);
 static lv_draw_mask_res_t lv_draw_mask_map(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_draw_mask_map_param_t * param);
@@ -37,12 +59,25 @@ static lv_draw_mask_res_t lv_draw_mask_map(lv_opa_t * mask_buf, lv_coord_t abs_x
 static lv_draw_mask_res_t line_mask_flat(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_draw_mask_line_param_t * p);
 static lv_draw_mask_res_t line_mask_steep(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_draw_mask_line_param_t * p);
 
+#if LV_USE_RADIUS_CACHE
+static lv_draw_mask_radius_cache_t * radius_cache_get(lv_coord_t radius);
+static void radius_cache_build(lv_draw_mask_radius_cache_t * cache);
+static bool radius_cache_evict_lru(void);
+static lv_draw_mask_res_t radius_cache_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t len, lv_coord_t row, lv_draw_mask_radius_param_t * p);
+#endif
+
+static inline lv_draw_mask_res_t bounds_check(const lv_draw_mask_bounds_t * b, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len);
 static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
-static lv_mask_saved_t mask_list[LV_MASK_MAX_NUM];
+static LV_THREAD_LOCAL lv_mask_saved_t mask_list[LV_MASK_MAX_NUM];
+
+#if LV_USE_RADIUS_CACHE
+static uint32_t radius_cache_mem_used;  /*Total size of the cached corners*/
+static uint32_t radius_cache_frame_act; /*Counts the frames to find the least recently used corners*/
+#endif
 
 /**********************
  *      MACROS
@@ -92,18 +127,27 @@ lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_
 {
     bool changed = false;
     lv_draw_mask_common_dsc_t * dsc;
+    LV_PROFILER_BEGIN(prof_start);
 
     lv_draw_mask_res_t res = LV_DRAW_MASK_RES_FULL_COVER;
     uint8_t i;
     for(i = 0; i < LV_MASK_MAX_NUM; i++) {
         if(mask_list[i].param) {
             dsc = mask_list[i].param;
-            res = dsc->cb(mask_buf, abs_x, abs_y, len, (void*)mask_list[i].param);
-            if(res == LV_DRAW_MASK_RES_FULL_TRANSP) return LV_DRAW_MASK_RES_FULL_TRANSP;
+            /*Skip the callback if the line is surely not changed by the mask*/
+            res = bounds_check(&dsc->bounds, abs_x, abs_y, len);
+            if(res == LV_DRAW_MASK_RES_UNKNOWN) {
+                res = dsc->cb(mask_buf, abs_x, abs_y, len, (void*)mask_list[i].param);
+                LV_PROFILER_COUNT(LV_PROFILER_CNT_MASK_EVAL, 1);
+            }
+            if(res == LV_DRAW_MASK_RES_FULL_TRANSP) break;
             else if(res == LV_DRAW_MASK_RES_CHANGED) changed = true;
         }
     }
 
+    LV_PROFILER_COUNT_TIME(LV_PROFILER_CNT_MASK_TIME, prof_start);
+
+    if(res == LV_DRAW_MASK_RES_FULL_TRANSP) return LV_DRAW_MASK_RES_FULL_TRANSP;
     return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
 }
 
@@ -160,6 +204,27 @@ uint8_t lv_draw_mask_get_cnt(void)
     return cnt;
 }
 
+#if LV_USE_RADIUS_CACHE
+/**
+ * Initialize the cache of the rounded corners
+ */
+void lv_draw_mask_radius_cache_init(void)
+{
+    lv_ll_init(&LV_GC_ROOT(_lv_radius_cache_ll), sizeof(lv_draw_mask_radius_cache_t));
+    radius_cache_mem_used  = 0;
+    radius_cache_frame_act = 1;
+}
+
+/**
+ * Start a new frame. The corners used in the current frame are not freed.
+ * Call it before refreshing a display.
+ */
+void lv_draw_mask_radius_cache_new_frame(void)
+{
+    radius_cache_frame_act++;
+}
+#endif
+
 /**
  *Initialize a line mask from two points.
  * @param param pointer to a `lv_draw_mask_param_t` to initialize
@@ -200,6 +265,10 @@ void lv_draw_mask_line_points_init(lv_draw_mask_line_param_t * param, lv_coord_t
     param->dsc.cb = (lv_draw_mask_cb_t)lv_draw_mask_line;
     param->dsc.type = LV_DRAW_MASK_TYPE_LINE;
 
+    /*A line is infinite so it can affect any pixel*/
+    param->dsc.bounds.out_valid = 0;
+    param->dsc.bounds.in_valid = 0;
+
     lv_coord_t dx = p2x-p1x;
     lv_coord_t dy = p2y-p1y;
 
@@ -313,6 +382,8 @@ void lv_draw_mask_angle_init(lv_draw_mask_angle_param_t * param, lv_coord_t vert
     param->cfg.vertex_p.y = vertex_y;
     param->dsc.cb = (lv_draw_mask_cb_t)lv_draw_mask_angle;
     param->dsc.type = LV_DRAW_MASK_TYPE_ANGLE;
+    param->dsc.bounds.out_valid = 0;
+    param->dsc.bounds.in_valid = 0;
 
     if(start_angle >= 0 && start_angle < 180) {
         start_side = LV_DRAW_MASK_LINE_SIDE_LEFT;
@@ -354,7 +425,22 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
     param->cfg.radius = radius;
     param->cfg.outer = inv ? 1 : 0;
     param->dsc.cb = (lv_draw_mask_cb_t)lv_draw_mask_radius;
+#if LV_USE_RADIUS_CACHE
+    param->cache = NULL;
+    param->cache_frame = 0;
+#endif
     param->dsc.type = LV_DRAW_MASK_TYPE_RADIUS;
+
+    /*Out of the rectangle and between the corners all pixels are either kept or cleared*/
+    lv_area_copy(&param->dsc.bounds.area, rect);
+    param->dsc.bounds.inner.x1 = rect->x1;
+    param->dsc.bounds.inner.y1 = rect->y1 + radius;
+    param->dsc.bounds.inner.x2 = rect->x2;
+    param->dsc.bounds.inner.y2 = rect->y2 - radius;
+    param->dsc.bounds.out_res = inv ? LV_DRAW_MASK_RES_FULL_COVER : LV_DRAW_MASK_RES_FULL_TRANSP;
+    param->dsc.bounds.in_res = inv ? LV_DRAW_MASK_RES_FULL_TRANSP : LV_DRAW_MASK_RES_FULL_COVER;
+    param->dsc.bounds.out_valid = 1;
+    param->dsc.bounds.in_valid = 1;
 }
 
 
@@ -376,6 +462,23 @@ void lv_draw_mask_fade_init(lv_draw_mask_fade_param_t * param, lv_area_t * coord
     param->cfg.y_bottom = y_bottom;
     param->dsc.cb = (lv_draw_mask_cb_t)lv_draw_mask_fade;
     param->dsc.type = LV_DRAW_MASK_TYPE_FADE;
+
+    /*Out of `coords` and where the opacity is constant 0 or 255 the callback is not required*/
+    lv_area_copy(&param->dsc.bounds.area, coords);
+    lv_area_copy(&param->dsc.bounds.inner, coords);
+    param->dsc.bounds.out_res = LV_DRAW_MASK_RES_FULL_COVER;
+    param->dsc.bounds.out_valid = 1;
+    param->dsc.bounds.in_valid = 0;
+
+    if(opa_top > LV_OPA_MAX || opa_top < LV_OPA_MIN) {
+        param->dsc.bounds.inner.y2 = LV_MATH_MIN(y_top, coords->y2);
+        param->dsc.bounds.in_res = opa_top > LV_OPA_MAX ? LV_DRAW_MASK_RES_FULL_COVER : LV_DRAW_MASK_RES_FULL_TRANSP;
+        param->dsc.bounds.in_valid = 1;
+    } else if(opa_bottom > LV_OPA_MAX || opa_bottom < LV_OPA_MIN) {
+        param->dsc.bounds.inner.y1 = LV_MATH_MAX(y_bottom, coords->y1);
+        param->dsc.bounds.in_res = opa_bottom > LV_OPA_MAX ? LV_DRAW_MASK_RES_FULL_COVER : LV_DRAW_MASK_RES_FULL_TRANSP;
+        param->dsc.bounds.in_valid = 1;
+    }
 }
 
 
@@ -391,6 +494,11 @@ void lv_draw_mask_map_init(lv_draw_mask_map_param_t * param, lv_area_t * coords,
     param->cfg.map = map;
     param->dsc.cb = (lv_draw_mask_cb_t)lv_draw_mask_map;
     param->dsc.type = LV_DRAW_MASK_TYPE_MAP;
+
+    lv_area_copy(&param->dsc.bounds.area, coords);
+    param->dsc.bounds.out_res = LV_DRAW_MASK_RES_FULL_COVER;
+    param->dsc.bounds.out_valid = 1;
+    param->dsc.bounds.in_valid = 0;
 }
 
 
@@ -834,6 +942,25 @@ static lv_draw_mask_res_t lv_draw_mask_angle(lv_opa_t * mask_buf, lv_coord_t abs
 }
 
 static lv_draw_mask_res_t lv_draw_mask_radius(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_draw_mask_radius_param_t * p)
+{
+#if LV_USE_RADIUS_CACHE
+    /*Use the cached corner in the rows of the corners. The bottom corners are mirrors of the top ones.*/
+    lv_coord_t row = abs_y - p->cfg.rect.y1;
+    if(row >= p->cfg.radius) row = lv_area_get_height(&p->cfg.rect) - 1 - row;
+
+    if(row >= 0 && row < p->cfg.radius) {
+        if(p->cache_frame != radius_cache_frame_act) {
+            p->cache = radius_cache_get(p->cfg.radius);
+            p->cache_frame = radius_cache_frame_act;
+        }
+        if(p->cache) return radius_cache_apply(mask_buf, abs_x, len, row, p);
+    }
+#endif
+
+    return lv_draw_mask_radius_calc(mask_buf, abs_x, abs_y, len, p);
+}
+
+static lv_draw_mask_res_t lv_draw_mask_radius_calc(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len, lv_draw_mask_radius_param_t * p)
 {
     if(p->cfg.outer == 0) {
         if(abs_y < p->cfg.rect.y1 || abs_y > p->cfg.rect.y2) {
@@ -1117,6 +1244,196 @@ static lv_draw_mask_res_t lv_draw_mask_map(lv_opa_t * mask_buf, lv_coord_t abs_x
 }
 
 
+#if LV_USE_RADIUS_CACHE
+/**
+ * Get the cached corner of a radius. Create it if it's not cached yet.
+ * @param radius the radius
+ * @return the cached corner or NULL if it doesn't fit into `LV_RADIUS_CACHE_SIZE`
+ */
+static lv_draw_mask_radius_cache_t * radius_cache_get(lv_coord_t radius)
+{
+    if(radius <= 0) return NULL;
+
+    LV_DRAW_LOCK();
+
+    lv_draw_mask_radius_cache_t * cache;
+    LV_LL_READ(LV_GC_ROOT(_lv_radius_cache_ll), cache) {
+        if(cache->radius == radius) {
+            cache->last_frame = radius_cache_frame_act;
+            LV_DRAW_UNLOCK();
+            return cache;
+        }
+    }
+
+    uint32_t size = radius * sizeof(lv_coord_t) + (uint32_t)radius * radius;
+    if(size > LV_RADIUS_CACHE_SIZE) {
+        LV_DRAW_UNLOCK();
+        return NULL;
+    }
+
+    while(radius_cache_mem_used + size > LV_RADIUS_CACHE_SIZE) {
+        if(radius_cache_evict_lru() == false) {
+            LV_DRAW_UNLOCK();
+            return NULL;
+        }
+    }
+
+    cache = lv_ll_ins_head(&LV_GC_ROOT(_lv_radius_cache_ll));
+    if(cache == NULL) {
+        LV_DRAW_UNLOCK();
+        return NULL;
+    }
+
+    cache->first = lv_mem_alloc(size);
+    if(cache->first == NULL) {
+        lv_ll_remove(&LV_GC_ROOT(_lv_radius_cache_ll), cache);
+        lv_mem_free(cache);
+        LV_DRAW_UNLOCK();
+        return NULL;
+    }
+
+    cache->map        = (lv_opa_t *)&cache->first[radius];
+    cache->radius     = radius;
+    cache->size       = size;
+    cache->last_frame = radius_cache_frame_act;
+    radius_cache_mem_used += size;
+
+    radius_cache_build(cache);
+
+    LV_DRAW_UNLOCK();
+
+    return cache;
+}
+
+/**
+ * Compute the opacities of a corner by masking the top left corner of a `2 * radius` sized rectangle
+ * @param cache pointer to a cache entry with allocated `first` and `map`
+ */
+static void radius_cache_build(lv_draw_mask_radius_cache_t * cache)
+{
+    lv_coord_t r = cache->radius;
+
+    lv_draw_mask_radius_param_t p;
+    p.cfg.rect.x1 = 0;
+    p.cfg.rect.y1 = 0;
+    p.cfg.rect.x2 = 2 * r - 1;
+    p.cfg.rect.y2 = 2 * r - 1;
+    p.cfg.radius = r;
+    p.cfg.outer = 0;
+
+    lv_coord_t row;
+    for(row = 0; row < r; row++) {
+        lv_opa_t * map = &cache->map[row * r];
+        memset(map, LV_OPA_COVER, r);
+        if(lv_draw_mask_radius_calc(map, 0, row, r, &p) == LV_DRAW_MASK_RES_FULL_TRANSP) {
+            memset(map, LV_OPA_TRANSP, r);
+        }
+
+        /*The partially covered pixels got `mask_mix(LV_OPA_COVER, m) = m - 1`. Store `m`.*/
+        lv_coord_t i;
+        for(i = 0; i < r; i++) {
+            if(map[i] != LV_OPA_TRANSP && map[i] != LV_OPA_COVER) map[i]++;
+        }
+
+        for(i = 0; i < r && map[i] == LV_OPA_TRANSP; i++);
+        cache->first[row] = i;
+    }
+}
+
+/**
+ * Free the least recently used corner which wasn't used in the current frame
+ * @return false: there was no such corner
+ */
+static bool radius_cache_evict_lru(void)
+{
+    lv_draw_mask_radius_cache_t * lru = NULL;
+    lv_draw_mask_radius_cache_t * cache;
+    LV_LL_READ(LV_GC_ROOT(_lv_radius_cache_ll), cache) {
+        if(cache->last_frame == radius_cache_frame_act) continue;
+        if(lru == NULL || cache->last_frame < lru->last_frame) lru = cache;
+    }
+
+    if(lru == NULL) return false;
+
+    radius_cache_mem_used -= lru->size;
+    lv_mem_free(lru->first);
+    lv_ll_remove(&LV_GC_ROOT(_lv_radius_cache_ll), lru);
+    lv_mem_free(lru);
+
+    return true;
+}
+
+/**
+ * Apply a row of a cached corner on the mask. Has the same result as `lv_draw_mask_radius_calc`.
+ * @param mask_buf the mask buffer
+ * @param abs_x absolute X coordinate of the first pixel in `mask_buf`
+ * @param len length of `mask_buf`
+ * @param row row of the corner (0: the top/bottom row of the rectangle)
+ * @param p the parameter of the mask with a valid `cache`
+ * @return an element of `lv_draw_mask_res_t`
+ */
+static lv_draw_mask_res_t radius_cache_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t len, lv_coord_t row, lv_draw_mask_radius_param_t * p)
+{
+    lv_coord_t r = p->cfg.radius;
+    const lv_opa_t * map = &p->cache->map[row * r];
+    int32_t first = p->cache->first[row];
+    int32_t k = p->cfg.rect.x1 - abs_x;   /*Index of the rectangle's first pixel in `mask_buf`*/
+    int32_t w = lv_area_get_width(&p->cfg.rect);
+
+    if(p->cfg.outer == 0) {
+        /*Clear the pixels out of the circle*/
+        int32_t kl = k + first;
+        int32_t kr = k + w - first;
+        if(kl >= len || kr <= 0) return LV_DRAW_MASK_RES_FULL_TRANSP;
+        if(kl > 0) memset(&mask_buf[0], 0x00, kl);
+        if(kr < len) memset(&mask_buf[kr], 0x00, len - kr);
+    } else {
+        /*Clear the pixels between the corners*/
+        int32_t kl = LV_MATH_MAX(k + r, 0);
+        int32_t kr = LV_MATH_MIN(k + w - r, len);
+        if(kl < kr) memset(&mask_buf[kl], 0x00, kr - kl);
+    }
+
+    /*Mask the pixels of the left and right corners*/
+    int32_t i;
+    for(i = first; i < r; i++) {
+        lv_opa_t m = map[i];
+        if(p->cfg.outer) m = 255 - m;
+
+        int32_t kl = k + i;
+        if(kl >= 0 && kl < len) mask_buf[kl] = mask_mix(mask_buf[kl], m);
+
+        int32_t kr = k + w - 1 - i;
+        if(kr >= 0 && kr < len) mask_buf[kr] = mask_mix(mask_buf[kr], m);
+    }
+
+    return LV_DRAW_MASK_RES_CHANGED;
+}
+#endif
+
+/**
+ * Get the result of a mask on a line from its bounds
+ * @param b the bounds of the mask
+ * @param abs_x absolute X coordinate where the line starts
+ * @param abs_y absolute Y coordinate of the line
+ * @param len length of the line
+ * @return `LV_DRAW_MASK_RES_FULL_COVER/TRANSP` or `LV_DRAW_MASK_RES_UNKNOWN` if the callback needs to be called
+ */
+static inline lv_draw_mask_res_t bounds_check(const lv_draw_mask_bounds_t * b, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t len)
+{
+    lv_coord_t x2 = abs_x + len - 1;
+
+    if(b->out_valid) {
+        if(abs_y < b->area.y1 || abs_y > b->area.y2 || x2 < b->area.x1 || abs_x > b->area.x2) return b->out_res;
+    }
+
+    if(b->in_valid) {
+        if(abs_y >= b->inner.y1 && abs_y <= b->inner.y2 && abs_x >= b->inner.x1 && x2 <= b->inner.x2) return b->in_res;
+    }
+
+    return LV_DRAW_MASK_RES_UNKNOWN;
+}
+
 static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new)
 {
     if(mask_new > LV_OPA_MAX) return mask_act;
@@ -57,9 +57,30 @@ typedef lv_draw_mask_res_t (*lv_draw_mask_cb_t)(lv_opa_t * mask_buf, lv_coord_t
 
 typedef uint8_t lv_draw_mask_line_side_t;
 
+/** Describes where a mask can change the pixels.
+ * Used to get the result of a mask on a line without calling its callback.
+ * All zero means no bounds, i.e. the callback is always called (e.g. for custom masks).*/
+typedef struct {
+    /*Lines out of this area have `out_res` result*/
+    lv_area_t area;
+
+    /*Lines entirely in this area have `in_res` result*/
+    lv_area_t inner;
+
+    lv_draw_mask_res_t out_res;
+    lv_draw_mask_res_t in_res;
+
+    /*1: `area` and `out_res` are set*/
+    uint8_t out_valid : 1;
+
+    /*1: `inner` and `in_res` are set*/
+    uint8_t in_valid : 1;
+}lv_draw_mask_bounds_t;
+
 typedef struct {
     lv_draw_mask_cb_t cb;
     lv_draw_mask_type_t type;
+    lv_draw_mask_bounds_t bounds;
 }lv_draw_mask_common_dsc_t;
 
 typedef struct {
@@ -127,6 +148,11 @@ typedef struct {
         uint8_t outer:1;
     }cfg;
 
+#if LV_USE_RADIUS_CACHE
+    /*The cached corner of `cfg.radius` and the frame when it was looked up (set while drawing)*/
+    struct _lv_draw_mask_radius_cache_t * cache;
+    uint32_t cache_frame;
+#endif
 }lv_draw_mask_radius_param_t;
 
 typedef struct {
@@ -200,6 +226,19 @@ void * lv_draw_mask_remove_custom(void * custom_id);
  */
 uint8_t lv_draw_mask_get_cnt(void);
 
+#if LV_USE_RADIUS_CACHE
+/**
+ * Initialize the cache of the rounded corners
+ */
+void lv_draw_mask_radius_cache_init(void);
+
+/**
+ * Start a new frame. The corners used in the current frame are not freed.
+ * Call it before refreshing a display.
+ */
+void lv_draw_mask_radius_cache_new_frame(void);
+#endif
+
 /**
  *Initialize a line mask from two points.
  * @param param pointer to a `lv_draw_mask_param_t` to initialize
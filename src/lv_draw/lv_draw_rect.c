@@ -9,9 +9,15 @@
 #include "lv_draw_rect.h"
 #include "lv_draw_blend.h"
 #include "lv_draw_mask.h"
+#include "lv_draw_backend.h"
 #include "../lv_misc/lv_circ.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_core/lv_refr.h"
+#include "../lv_misc/lv_gc.h"
+
+#if defined(LV_GC_INCLUDE)
+#include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
 
 /*********************
  *      DEFINES
@@ -23,6 +29,34 @@
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_SHADOW_CACHE
+/** A blurred shadow corner*/
+typedef struct
+{
+    lv_coord_t sw;          /*Width of the shadow*/
+    lv_coord_t r;           /*Radius of the shadow*/
+    lv_coord_t w;           /*Size of the shadow's rectangle limited to the sizes which still affect the corner*/
+    lv_coord_t h;
+    uint32_t last_use;      /*Value of `shadow_cache_use_cnt` when the corner was last used*/
+    uint32_t size;          /*Size of `buf` in bytes*/
+    lv_opa_t * buf;         /*The corner, the result of `shadow_draw_corner_buf`*/
+} lv_shadow_cache_entry_t;
+#endif
+
+#if LV_USE_GRAD_CACHE
+/** The colors of a gradient*/
+typedef struct
+{
+    lv_color_t main_color;
+    lv_color_t grad_color;
+    uint8_t main_color_stop;
+    uint8_t grad_color_stop;
+    lv_coord_t len;         /*Length of the gradient, number of colors in `buf`*/
+    uint32_t last_use;      /*Value of `grad_cache_use_cnt` when the line was last used*/
+    lv_color_t * buf;
+} lv_grad_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -30,12 +64,31 @@ static void draw_bg(const lv_area_t * coords, const lv_area_t * clip, const lv_s
 static void draw_border(const lv_area_t * coords, const lv_area_t * clip, const lv_style_t * style, lv_opa_t opa_scale);
 static void draw_shadow(const lv_area_t * coords, const lv_area_t * clip, const lv_style_t * style, lv_opa_t opa_scale);
 static lv_color_t grad_get(const lv_style_t * style, lv_coord_t s, lv_coord_t i);
+#if LV_USE_GRAD_CACHE
+static lv_grad_cache_entry_t * grad_cache_get(const lv_style_t * style, lv_coord_t len);
+#endif
 static void shadow_draw_corner_buf(const lv_area_t * coords,  uint16_t * sh_buf, lv_coord_t s, lv_coord_t r);
 static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
+#if LV_USE_SHADOW_CACHE
+static void shadow_cache_get_corner(const lv_area_t * coords, lv_opa_t * sh_buf, lv_coord_t sw, lv_coord_t r);
+static lv_shadow_cache_entry_t * shadow_cache_find(lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h);
+static void shadow_cache_free(lv_shadow_cache_entry_t * entry);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_SHADOW_CACHE
+static uint32_t shadow_cache_mem_used;  /*Total size of the cached corners*/
+static uint32_t shadow_cache_use_cnt;   /*Incremented on every use to find the least recently used corner*/
+static uint32_t shadow_cache_hit;
+static uint32_t shadow_cache_miss;
+#endif
+
+#if LV_USE_GRAD_CACHE
+static uint32_t grad_cache_mem_used;    /*Total size of the cached lines*/
+static uint32_t grad_cache_use_cnt;     /*Incremented on every use to find the least recently used line*/
+#endif
 
 /**********************
  *      MACROS
@@ -56,6 +109,10 @@ void lv_draw_rect(const lv_area_t * coords, const lv_area_t * clip, const lv_sty
 {
     if(lv_area_get_height(coords) < 1 || lv_area_get_width(coords) < 1) return;
 
+#if LV_USE_DRAW_BACKEND
+    if(lv_draw_backend_add_rect(coords, clip, style, opa_scale) == LV_RES_OK) return;
+#endif
+
     draw_shadow(coords, clip, style, opa_scale);
     draw_bg(coords, clip, style, opa_scale);
     draw_border(coords, clip, style, opa_scale);
@@ -93,6 +150,96 @@ void lv_draw_px(const lv_point_t * point, const lv_area_t * clip_area, const lv_
     }
 }
 
+#if LV_USE_SHADOW_CACHE
+/**
+ * Initialize the cache of the shadow corners
+ */
+void lv_draw_shadow_cache_init(void)
+{
+    lv_ll_init(&LV_GC_ROOT(_lv_shadow_cache_ll), sizeof(lv_shadow_cache_entry_t));
+    shadow_cache_mem_used = 0;
+    shadow_cache_use_cnt  = 0;
+    lv_draw_shadow_cache_reset_stat();
+}
+
+/**
+ * Free all cached shadow corners
+ */
+void lv_draw_shadow_cache_clean(void)
+{
+    LV_DRAW_LOCK();
+    lv_shadow_cache_entry_t * entry = lv_ll_get_head(&LV_GC_ROOT(_lv_shadow_cache_ll));
+    while(entry) {
+        lv_shadow_cache_entry_t * entry_next = lv_ll_get_next(&LV_GC_ROOT(_lv_shadow_cache_ll), entry);
+        shadow_cache_free(entry);
+        entry = entry_next;
+    }
+    LV_DRAW_UNLOCK();
+}
+
+/**
+ * Get the statistics of the shadow cache
+ * @param stat store the statistics here
+ */
+void lv_draw_shadow_cache_get_stat(lv_draw_shadow_cache_stat_t * stat)
+{
+    LV_DRAW_LOCK();
+    stat->hit       = shadow_cache_hit;
+    stat->miss      = shadow_cache_miss;
+    stat->mem_used  = shadow_cache_mem_used;
+    stat->entry_cnt = lv_ll_get_len(&LV_GC_ROOT(_lv_shadow_cache_ll));
+    LV_DRAW_UNLOCK();
+}
+
+/**
+ * Reset the hit and miss counters of the shadow cache
+ */
+void lv_draw_shadow_cache_reset_stat(void)
+{
+    shadow_cache_hit  = 0;
+    shadow_cache_miss = 0;
+}
+#endif
+
+#if LV_USE_GRAD_CACHE
+/**
+ * Initialize the cache of the gradient colors
+ */
+void lv_draw_grad_cache_init(void)
+{
+    lv_ll_init(&LV_GC_ROOT(_lv_grad_cache_ll), sizeof(lv_grad_cache_entry_t));
+    grad_cache_mem_used = 0;
+    grad_cache_use_cnt  = 0;
+}
+#endif
+
+/**
+ * Get a part of the colors of a gradient
+ * @param style the style with the gradient's colors and stops
+ * @param len length of the gradient
+ * @param ofs index of the first color to get
+ * @param cnt number of colors to get
+ * @param buf store the colors here
+ */
+void lv_draw_grad_get_line(const lv_style_t * style, lv_coord_t len, lv_coord_t ofs, lv_coord_t cnt, lv_color_t * buf)
+{
+#if LV_USE_GRAD_CACHE
+    LV_DRAW_LOCK();
+    lv_grad_cache_entry_t * entry = grad_cache_get(style, len);
+    if(entry) {
+        memcpy(buf, &entry->buf[ofs], cnt * sizeof(lv_color_t));
+        LV_DRAW_UNLOCK();
+        return;
+    }
+    LV_DRAW_UNLOCK();
+#endif
+
+    lv_coord_t i;
+    for(i = 0; i < cnt; i++) {
+        buf[i] = grad_get(style, len, ofs + i);
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -176,14 +323,19 @@ static void draw_bg(const lv_area_t * coords, const lv_area_t * clip, const lv_s
 
 
             lv_color_t * grad_map = NULL;
-            /*In case of horizontal gradient pre-compute a line with a gradient*/
+            /*In case of horizontal gradient get a line with a gradient*/
             if(style->body.grad_dir == LV_GRAD_DIR_HOR && style->body.main_color.full != style->body.grad_color.full) {
                 grad_map = lv_mem_buf_get(coords_w * sizeof(lv_color_t));
+                lv_draw_grad_get_line(style, coords_w, 0, coords_w, grad_map);
+            }
 
-                lv_coord_t i;
-                for(i = 0; i < coords_w; i++) {
-                    grad_map[i] = grad_get(style, coords_w, i);
-                }
+            /*In case of vertical gradient get the colors of the rows to draw*/
+            lv_color_t * grad_ver = NULL;
+            lv_coord_t grad_ver_ofs = vdb->area.y1 + draw_area.y1 - coords_bg.y1;
+            if(style->body.grad_dir == LV_GRAD_DIR_VER && style->body.main_color.full != style->body.grad_color.full) {
+                lv_coord_t row_cnt = lv_area_get_height(&draw_area);
+                grad_ver = lv_mem_buf_get(row_cnt * sizeof(lv_color_t));
+                lv_draw_grad_get_line(style, coords_h, grad_ver_ofs, row_cnt, grad_ver);
             }
 
             lv_area_t fill_area;
@@ -210,8 +362,8 @@ static void draw_bg(const lv_area_t * coords, const lv_area_t * clip, const lv_s
                 }
 
                 /*Get the current line color*/
-                if(style->body.grad_dir == LV_GRAD_DIR_VER && style->body.main_color.full != style->body.grad_color.full) {
-                    grad_color = grad_get(style, lv_area_get_height(&coords_bg), y - coords_bg.y1);
+                if(grad_ver) {
+                    grad_color = grad_ver[y - coords_bg.y1 - grad_ver_ofs];
                 }
 
                 /* If there is not other mask and drawing the corner area split the drawing to corner and middle areas
@@ -259,6 +411,7 @@ static void draw_bg(const lv_area_t * coords, const lv_area_t * clip, const lv_s
             }
 
             if(grad_map) lv_mem_buf_release(grad_map);
+            if(grad_ver) lv_mem_buf_release(grad_ver);
         }
 
         lv_draw_mask_remove_id(mask_rout_id);
@@ -481,11 +634,96 @@ static lv_color_t grad_get(const lv_style_t * style, lv_coord_t s, lv_coord_t i)
 
     lv_coord_t d = style->body.grad_color_stop - style->body.main_color_stop;
     d = (s * d) >> 8;
-    i -= min;
-    lv_opa_t mix = (i * 255) / d;
+    lv_coord_t ofs = i - min;
+    lv_opa_t mix = (ofs * 255) / d;
+
+#if LV_GRAD_DITHER && LV_COLOR_DEPTH == 16
+    /* Round the exact mix of the channels up or down with an ordered pattern.
+     * `v` is in 1/255 units of the channel's step.*/
+    static const uint8_t pattern[4] = {0, 2, 1, 3};
+    uint32_t th = (pattern[i & 0x3] * 2 + 1) * 255;
+    lv_color_t c1 = style->body.grad_color;
+    lv_color_t c2 = style->body.main_color;
+    lv_color_t ret;
+    uint32_t v;
+
+    v = LV_COLOR_GET_R(c1) * mix + LV_COLOR_GET_R(c2) * (255 - mix);
+    LV_COLOR_SET_R(ret, v / 255 + ((v % 255) * 8 > th ? 1 : 0));
+    v = LV_COLOR_GET_G(c1) * mix + LV_COLOR_GET_G(c2) * (255 - mix);
+    LV_COLOR_SET_G(ret, v / 255 + ((v % 255) * 8 > th ? 1 : 0));
+    v = LV_COLOR_GET_B(c1) * mix + LV_COLOR_GET_B(c2) * (255 - mix);
+    LV_COLOR_SET_B(ret, v / 255 + ((v % 255) * 8 > th ? 1 : 0));
+
+    return ret;
+#else
     return lv_color_mix(style->body.grad_color, style->body.main_color, mix);
+#endif
 }
 
+#if LV_USE_GRAD_CACHE
+/**
+ * Get the colors of a gradient from the cache. Create them if not cached yet.
+ * Should be called in `LV_DRAW_LOCK`.
+ * @param style the style with the gradient's colors and stops
+ * @param len length of the gradient
+ * @return the cached gradient or NULL if it doesn't fit into `LV_GRAD_CACHE_SIZE`
+ */
+static lv_grad_cache_entry_t * grad_cache_get(const lv_style_t * style, lv_coord_t len)
+{
+    lv_grad_cache_entry_t * entry;
+    LV_LL_READ(LV_GC_ROOT(_lv_grad_cache_ll), entry) {
+        if(entry->len == len &&
+           entry->main_color.full == style->body.main_color.full &&
+           entry->grad_color.full == style->body.grad_color.full &&
+           entry->main_color_stop == style->body.main_color_stop &&
+           entry->grad_color_stop == style->body.grad_color_stop) {
+            entry->last_use = ++grad_cache_use_cnt;
+            return entry;
+        }
+    }
+
+    uint32_t size = len * sizeof(lv_color_t);
+    if(size > LV_GRAD_CACHE_SIZE) return NULL;
+
+    /*Free the least recently used lines if required*/
+    while(grad_cache_mem_used + size > LV_GRAD_CACHE_SIZE) {
+        lv_grad_cache_entry_t * lru = NULL;
+        LV_LL_READ(LV_GC_ROOT(_lv_grad_cache_ll), entry) {
+            if(lru == NULL || entry->last_use < lru->last_use) lru = entry;
+        }
+        grad_cache_mem_used -= lru->len * sizeof(lv_color_t);
+        lv_mem_free(lru->buf);
+        lv_ll_remove(&LV_GC_ROOT(_lv_grad_cache_ll), lru);
+        lv_mem_free(lru);
+    }
+
+    entry = lv_ll_ins_head(&LV_GC_ROOT(_lv_grad_cache_ll));
+    if(entry == NULL) return NULL;
+
+    entry->buf = lv_mem_alloc(size);
+    if(entry->buf == NULL) {
+        lv_ll_remove(&LV_GC_ROOT(_lv_grad_cache_ll), entry);
+        lv_mem_free(entry);
+        return NULL;
+    }
+
+    entry->main_color      = style->body.main_color;
+    entry->grad_color      = style->body.grad_color;
+    entry->main_color_stop = style->body.main_color_stop;
+    entry->grad_color_stop = style->body.grad_color_stop;
+    entry->len             = len;
+    entry->last_use        = ++grad_cache_use_cnt;
+    grad_cache_mem_used += size;
+
+    lv_coord_t i;
+    for(i = 0; i < len; i++) {
+        entry->buf[i] = grad_get(style, len, i);
+    }
+
+    return entry;
+}
+#endif
+
 static void draw_shadow(const lv_area_t * coords, const lv_area_t * clip, const lv_style_t * style, lv_opa_t opa_scale)
 {
     /*Check whether the shadow is visible*/
@@ -556,7 +794,11 @@ static void draw_shadow(const lv_area_t * coords, const lv_area_t * clip, const
     lv_coord_t corner_size = sw  + r_sh;
 
     lv_opa_t * sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
+#if LV_USE_SHADOW_CACHE
+    shadow_cache_get_corner(&sh_rect_area, sh_buf, style->body.shadow.width, r_sh);
+#else
     shadow_draw_corner_buf(&sh_rect_area, (uint16_t *)sh_buf, style->body.shadow.width, r_sh);
+#endif
 
     bool simple_mode = true;
     if(lv_draw_mask_get_cnt() > 0) simple_mode = false;
@@ -1023,3 +1265,116 @@ static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups
     lv_mem_buf_release(sh_ups_blur_buf);
 }
 
+#if LV_USE_SHADOW_CACHE
+/**
+ * Get the blurred corner of a shadow from the cache or draw it and add it to the cache.
+ * Has the same result as `shadow_draw_corner_buf`.
+ * @param coords the coordinates of the shadow's rectangle
+ * @param sh_buf store the corner here (it's modified by `draw_shadow`)
+ * @param sw width of the shadow
+ * @param r radius of the shadow
+ */
+static void shadow_cache_get_corner(const lv_area_t * coords, lv_opa_t * sh_buf, lv_coord_t sw, lv_coord_t r)
+{
+    lv_coord_t size = sw + r;
+
+    /* The rectangle's right edge and top edge is at a fixed position in the corner.
+     * If the rectangle is so large that its left or bottom corners are out of the corner
+     * then its width or height doesn't matter.*/
+    lv_coord_t w_max = sw / 2 + r - 1 - (sw & 1 ? 0 : 1) + r;
+    lv_coord_t h_max = size + r - 1 - (sw / 2 + 1);
+    lv_coord_t w = LV_MATH_MIN(lv_area_get_width(coords), w_max);
+    lv_coord_t h = LV_MATH_MIN(lv_area_get_height(coords), h_max);
+
+    uint32_t buf_size = (uint32_t)size * size;
+
+    LV_DRAW_LOCK();
+    lv_shadow_cache_entry_t * entry = shadow_cache_find(sw, r, w, h);
+    if(entry) {
+        memcpy(sh_buf, entry->buf, buf_size);
+        shadow_cache_hit++;
+        LV_DRAW_UNLOCK();
+        return;
+    }
+    shadow_cache_miss++;
+    LV_DRAW_UNLOCK();
+
+    shadow_draw_corner_buf(coords, (uint16_t *)sh_buf, sw, r);
+
+    if(buf_size > LV_SHADOW_CACHE_SIZE) return;
+
+    LV_DRAW_LOCK();
+    /*An other drawing thread might have added it meanwhile*/
+    if(shadow_cache_find(sw, r, w, h)) {
+        LV_DRAW_UNLOCK();
+        return;
+    }
+
+    /*Free the least recently used corners if required*/
+    while(shadow_cache_mem_used + buf_size > LV_SHADOW_CACHE_SIZE) {
+        lv_shadow_cache_entry_t * lru = NULL;
+        LV_LL_READ(LV_GC_ROOT(_lv_shadow_cache_ll), entry) {
+            if(lru == NULL || entry->last_use < lru->last_use) lru = entry;
+        }
+        shadow_cache_free(lru);
+    }
+
+    entry = lv_ll_ins_head(&LV_GC_ROOT(_lv_shadow_cache_ll));
+    if(entry == NULL) {
+        LV_DRAW_UNLOCK();
+        return;
+    }
+
+    entry->buf = lv_mem_alloc(buf_size);
+    if(entry->buf == NULL) {
+        lv_ll_remove(&LV_GC_ROOT(_lv_shadow_cache_ll), entry);
+        lv_mem_free(entry);
+        LV_DRAW_UNLOCK();
+        return;
+    }
+
+    memcpy(entry->buf, sh_buf, buf_size);
+    entry->sw       = sw;
+    entry->r        = r;
+    entry->w        = w;
+    entry->h        = h;
+    entry->size     = buf_size;
+    entry->last_use = ++shadow_cache_use_cnt;
+    shadow_cache_mem_used += buf_size;
+
+    LV_DRAW_UNLOCK();
+}
+
+/**
+ * Find a corner in the shadow cache and mark it as used
+ * @param sw width of the shadow
+ * @param r radius of the shadow
+ * @param w limited width of the shadow's rectangle
+ * @param h limited height of the shadow's rectangle
+ * @return the cached corner or NULL if not found
+ */
+static lv_shadow_cache_entry_t * shadow_cache_find(lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h)
+{
+    lv_shadow_cache_entry_t * entry;
+    LV_LL_READ(LV_GC_ROOT(_lv_shadow_cache_ll), entry) {
+        if(entry->sw == sw && entry->r == r && entry->w == w && entry->h == h) {
+            entry->last_use = ++shadow_cache_use_cnt;
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Remove a corner from the shadow cache and free it
+ * @param entry pointer to a cached corner
+ */
+static void shadow_cache_free(lv_shadow_cache_entry_t * entry)
+{
+    shadow_cache_mem_used -= entry->size;
+    lv_mem_free(entry->buf);
+    lv_ll_remove(&LV_GC_ROOT(_lv_shadow_cache_ll), entry);
+    lv_mem_free(entry);
+}
+#endif
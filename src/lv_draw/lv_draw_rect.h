@@ -23,6 +23,17 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_SHADOW_CACHE
+/** Statistics of the shadow cache*/
+typedef struct
+{
+    uint32_t hit;       /**< Number of shadows drawn with a cached corner*/
+    uint32_t miss;      /**< Number of shadows whose corner had to be blurred*/
+    uint32_t mem_used;  /**< Memory used by the cached corners in bytes*/
+    uint16_t entry_cnt; /**< Number of cached corners*/
+} lv_draw_shadow_cache_stat_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -45,6 +56,46 @@ void lv_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_sty
  */
 void lv_draw_px(const lv_point_t * point, const lv_area_t * clip_area, const lv_style_t * style, lv_opa_t opa_scale);
 
+/**
+ * Get a part of the colors of a gradient
+ * @param style the style with the gradient's colors and stops
+ * @param len length of the gradient
+ * @param ofs index of the first color to get
+ * @param cnt number of colors to get
+ * @param buf store the colors here
+ */
+void lv_draw_grad_get_line(const lv_style_t * style, lv_coord_t len, lv_coord_t ofs, lv_coord_t cnt, lv_color_t * buf);
+
+#if LV_USE_SHADOW_CACHE
+/**
+ * Initialize the cache of the shadow corners
+ */
+void lv_draw_shadow_cache_init(void);
+
+/**
+ * Free all cached shadow corners
+ */
+void lv_draw_shadow_cache_clean(void);
+
+/**
+ * Get the statistics of the shadow cache
+ * @param stat store the statistics here
+ */
+void lv_draw_shadow_cache_get_stat(lv_draw_shadow_cache_stat_t * stat);
+
+/**
+ * Reset the hit and miss counters of the shadow cache
+ */
+void lv_draw_shadow_cache_reset_stat(void);
+#endif
+
+#if LV_USE_GRAD_CACHE
+/**
+ * Initialize the cache of the gradient colors
+ */
+void lv_draw_grad_cache_init(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -7,20 +7,38 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_triangle.h"
+#include "lv_draw_blend.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_mem.h"
 
 /*********************
  *      DEFINES
  *********************/
+/*Sample the edges on this many sub-lines in a pixel row (vertical anti-aliasing)*/
+#define POLYGON_SUBLINE_CNT     4
+#define POLYGON_SUBLINE_SHIFT   2
 
 /**********************
  *      TYPEDEFS
  **********************/
+/*A not horizontal edge of a polygon. The coordinates are in 1/256 pixel units.*/
+typedef struct
+{
+    int32_t y1;     /*Top (inclusive)*/
+    int32_t y2;     /*Bottom (exclusive)*/
+    int32_t x1;     /*X on the top*/
+    int32_t slope;  /*Change of x per 1 y in 1/65536 units*/
+    int32_t x;      /*X on the current sub-line*/
+    int8_t dir;     /*1: goes downward; -1: goes upward*/
+} lv_draw_polygon_edge_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void polygon_fill(const lv_point_t * points, uint16_t point_cnt, const lv_area_t * clip_area,
+                         const lv_style_t * style, lv_opa_t opa_scale, lv_draw_fill_rule_t rule, bool convex);
+static void add_span(int16_t * cov_buf, int32_t x_min, int32_t x_max, int32_t xl, int32_t xr, int32_t * used1,
+                     int32_t * used2);
 
 /**********************
  *  STATIC VARIABLES
@@ -35,7 +53,7 @@
  **********************/
 
 /**
- *
+ * Draw a triangle
  * @param points pointer to an array with 3 points
  * @param clip_area the triangle will be drawn only in this area
  * @param style style for of the triangle
@@ -76,6 +94,12 @@ void lv_draw_polygon(const lv_point_t * points, uint16_t point_cnt, const lv_are
     is_common = lv_area_intersect(&poly_mask, &poly_coords, clip_area);
     if(!is_common) return;
 
+    /*If only the body is drawn fill the polygon directly instead of drawing its bounding box under line masks*/
+    if(style->body.radius == 0 && style->body.border.width == 0 && style->body.shadow.width == 0) {
+        polygon_fill(points, point_cnt, clip_area, style, opa_scale, LV_DRAW_FILL_RULE_NON_ZERO, true);
+        return;
+    }
+
     /*Find the lowest point*/
     lv_coord_t y_min = points[0].y;
     int16_t y_min_i = 0;
@@ -163,6 +187,287 @@ void lv_draw_polygon(const lv_point_t * points, uint16_t point_cnt, const lv_are
 
 }
 
+/**
+ * Draw a polygon with a given fill rule. Concave and self-intersecting polygons are supported too.
+ * Unlike `lv_draw_polygon` the points are the top left corners of the pixels
+ * and only the body of the style is drawn (no border and shadow).
+ * @param points an array of points
+ * @param point_cnt number of points
+ * @param clip_area polygon will be drawn only in this area
+ * @param style style of the polygon (`body.main_color`, `body.grad_color`, `body.grad_dir` and `body.opa` are used)
+ * @param opa_scale scale down all opacities by the factor (0..255)
+ * @param rule an element of `lv_draw_fill_rule_t`
+ */
+void lv_draw_polygon_fill_rule(const lv_point_t * points, uint16_t point_cnt, const lv_area_t * clip_area,
+                               const lv_style_t * style, lv_opa_t opa_scale, lv_draw_fill_rule_t rule)
+{
+    polygon_fill(points, point_cnt, clip_area, style, opa_scale, rule, false);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Fill a polygon with the scanline rasterizer
+ * @param points an array of points
+ * @param point_cnt number of points
+ * @param clip_area polygon will be drawn only in this area
+ * @param style style of the polygon (only the body is drawn)
+ * @param opa_scale scale down all opacities by the factor (0..255)
+ * @param rule an element of `lv_draw_fill_rule_t`. Not used if `convex` is `true`.
+ * @param convex true: draw a convex polygon as `lv_draw_polygon` does: the pixels of the right and bottom most
+ *               points are covered too and the edges are continued until the bounding box (as line masks);
+ *               false: the points are the corners of the pixels (`lv_draw_polygon_fill_rule`)
+ */
+static void polygon_fill(const lv_point_t * points, uint16_t point_cnt, const lv_area_t * clip_area,
+                         const lv_style_t * style, lv_opa_t opa_scale, lv_draw_fill_rule_t rule, bool convex)
+{
+    if(point_cnt < 3) return;
+    if(points == NULL) return;
+
+    lv_opa_t opa = style->body.opa;
+    if(opa_scale != LV_OPA_COVER) opa = (opa * opa_scale) >> 8;
+    if(opa < LV_OPA_MIN) return;
+
+    uint16_t i;
+    lv_area_t poly_coords = {.x1 = LV_COORD_MAX, .y1 = LV_COORD_MAX, .x2 = LV_COORD_MIN, .y2 = LV_COORD_MIN};
+
+    for(i = 0; i < point_cnt; i++) {
+        poly_coords.x1 = LV_MATH_MIN(poly_coords.x1, points[i].x);
+        poly_coords.y1 = LV_MATH_MIN(poly_coords.y1, points[i].y);
+        poly_coords.x2 = LV_MATH_MAX(poly_coords.x2, points[i].x);
+        poly_coords.y2 = LV_MATH_MAX(poly_coords.y2, points[i].y);
+    }
+
+    /*The points are the corners of the pixels so the right and bottom most pixels are not covered*/
+    if(!convex) {
+        poly_coords.x2--;
+        poly_coords.y2--;
+        if(poly_coords.x2 < poly_coords.x1 || poly_coords.y2 < poly_coords.y1) return;
+    }
+
+    bool is_common;
+    lv_area_t draw_area;
+    is_common = lv_area_intersect(&draw_area, &poly_coords, clip_area);
+    if(!is_common) return;
+
+    /*Collect the not horizontal edges ordered by their top.
+     *The vertical edges of convex polygons are on the bounding box so they are not needed.*/
+    lv_draw_polygon_edge_t * edges = lv_mem_buf_get(sizeof(lv_draw_polygon_edge_t) * point_cnt);
+    uint16_t edge_cnt = 0;
+    int64_t area = 0;
+    for(i = 0; i < point_cnt; i++) {
+        const lv_point_t * p1 = &points[i];
+        const lv_point_t * p2 = &points[i + 1 < point_cnt ? i + 1 : 0];
+        area += (int64_t)p1->x * p2->y - (int64_t)p2->x * p1->y;
+        if(p1->y == p2->y) continue;
+        if(convex && p1->x == p2->x) continue;
+
+        lv_draw_polygon_edge_t e;
+        e.dir = p2->y > p1->y ? 1 : -1;
+        const lv_point_t * top = e.dir > 0 ? p1 : p2;
+        const lv_point_t * bottom = e.dir > 0 ? p2 : p1;
+        e.y1 = top->y << 8;
+        e.y2 = bottom->y << 8;
+        e.x1 = top->x << 8;
+        e.slope = (int32_t)(((int64_t)(bottom->x - top->x) << 16) / (bottom->y - top->y));
+        e.x = e.x1;
+
+        uint16_t j = edge_cnt;
+        while(j > 0 && edges[j - 1].y1 > e.y1) {
+            edges[j] = edges[j - 1];
+            j--;
+        }
+        edges[j] = e;
+        edge_cnt++;
+    }
+
+    lv_coord_t draw_area_w = lv_area_get_width(&draw_area);
+    lv_draw_polygon_edge_t ** active = lv_mem_buf_get(sizeof(lv_draw_polygon_edge_t *) * point_cnt);
+    int16_t * cov_buf = lv_mem_buf_get((draw_area_w + 1) * sizeof(int16_t));
+    lv_opa_t * mask_buf = lv_mem_buf_get(draw_area_w);
+
+    /*Get the colors of the gradient if any*/
+    lv_color_t * grad_map = NULL;
+    lv_color_t * grad_ver = NULL;
+    if(style->body.main_color.full != style->body.grad_color.full) {
+        if(style->body.grad_dir == LV_GRAD_DIR_HOR) {
+            grad_map = lv_mem_buf_get(draw_area_w * sizeof(lv_color_t));
+            lv_draw_grad_get_line(style, lv_area_get_width(&poly_coords), draw_area.x1 - poly_coords.x1, draw_area_w,
+                                  grad_map);
+        } else if(style->body.grad_dir == LV_GRAD_DIR_VER) {
+            grad_ver = lv_mem_buf_get(lv_area_get_height(&draw_area) * sizeof(lv_color_t));
+            lv_draw_grad_get_line(style, lv_area_get_height(&poly_coords), draw_area.y1 - poly_coords.y1,
+                                  lv_area_get_height(&draw_area), grad_ver);
+        }
+    }
+
+    int16_t other_mask_cnt = lv_draw_mask_get_cnt();
+    int32_t x_min = draw_area.x1 << 8;
+    int32_t x_max = (draw_area.x2 + 1) << 8;
+    uint16_t next_edge = 0;
+    uint16_t active_cnt = 0;
+
+    /*The inside of a convex polygon is on the left of its downward edges if the points are clockwise*/
+    int8_t right_dir = area >= 0 ? 1 : -1;
+    int32_t poly_x1 = poly_coords.x1 << 8;
+    int32_t poly_x2 = (poly_coords.x2 + 1) << 8;
+
+    lv_coord_t y;
+    for(y = draw_area.y1; y <= draw_area.y2; y++) {
+        /*The range of `cov_buf` used in this row. Cleared when extended.*/
+        int32_t used1 = 0;
+        int32_t used2 = -1;
+
+        uint8_t s;
+        for(s = 0; s < POLYGON_SUBLINE_CNT; s++) {
+            int32_t sy = (y << 8) + ((2 * s + 1) << 7) / POLYGON_SUBLINE_CNT;
+
+            /*The span of a convex polygon is on the inner side of all edges in the bounding box*/
+            if(convex) {
+                int32_t xl = poly_x1;
+                int32_t xr = poly_x2;
+                uint16_t k;
+                for(k = 0; k < edge_cnt; k++) {
+                    int32_t x = edges[k].x1 + (int32_t)(((int64_t)(sy - edges[k].y1) * edges[k].slope) >> 16);
+                    if(edges[k].dir == right_dir) xr = LV_MATH_MIN(xr, x);
+                    else xl = LV_MATH_MAX(xl, x);
+                }
+                add_span(cov_buf, x_min, x_max, xl, xr, &used1, &used2);
+                continue;
+            }
+
+            /*Activate the edges starting above the sub-line*/
+            while(next_edge < edge_cnt && edges[next_edge].y1 <= sy) {
+                active[active_cnt] = &edges[next_edge];
+                active_cnt++;
+                next_edge++;
+            }
+
+            /*Drop the edges ended above the sub-line and get where the others cross it*/
+            uint16_t k;
+            uint16_t cnt = 0;
+            for(k = 0; k < active_cnt; k++) {
+                lv_draw_polygon_edge_t * e = active[k];
+                if(e->y2 <= sy) continue;
+                e->x = e->x1 + (int32_t)(((int64_t)(sy - e->y1) * e->slope) >> 16);
+                active[cnt] = e;
+                cnt++;
+            }
+            active_cnt = cnt;
+
+            /*Order by the crossings. Insertion sort is fast because the order rarely changes between the sub-lines*/
+            for(k = 1; k < active_cnt; k++) {
+                lv_draw_polygon_edge_t * e = active[k];
+                uint16_t j = k;
+                while(j > 0 && active[j - 1]->x > e->x) {
+                    active[j] = active[j - 1];
+                    j--;
+                }
+                active[j] = e;
+            }
+
+            /*Add the spans which are inside according to the fill rule*/
+            int32_t winding = 0;
+            int32_t span_start = 0;
+            for(k = 0; k < active_cnt; k++) {
+                bool inside_prev = rule == LV_DRAW_FILL_RULE_EVEN_ODD ? (winding & 0x1) : winding != 0;
+                winding += active[k]->dir;
+                bool inside = rule == LV_DRAW_FILL_RULE_EVEN_ODD ? (winding & 0x1) : winding != 0;
+
+                if(!inside_prev && inside) span_start = active[k]->x;
+                else if(inside_prev && !inside) add_span(cov_buf, x_min, x_max, span_start, active[k]->x, &used1, &used2);
+            }
+        }
+
+        if(used1 > used2) continue;
+
+        /*Sum the coverage differences to get the opacity of the pixels*/
+        int32_t cov = 0;
+        int32_t px;
+        for(px = used1; px <= used2; px++) {
+            cov += cov_buf[px];
+            mask_buf[px] = (cov * 255) >> (8 + POLYGON_SUBLINE_SHIFT);
+        }
+
+        lv_area_t fill_area;
+        fill_area.x1 = draw_area.x1 + used1;
+        fill_area.x2 = draw_area.x1 + used2;
+        fill_area.y1 = y;
+        fill_area.y2 = y;
+
+        if(other_mask_cnt) {
+            lv_draw_mask_res_t mask_res;
+            mask_res = lv_draw_mask_apply(&mask_buf[used1], fill_area.x1, y, lv_area_get_width(&fill_area));
+            if(mask_res == LV_DRAW_MASK_RES_FULL_TRANSP) continue;
+        }
+
+        if(grad_map) {
+            lv_blend_map(clip_area, &fill_area, &grad_map[used1], &mask_buf[used1], LV_DRAW_MASK_RES_CHANGED, opa,
+                         style->body.blend_mode);
+        } else {
+            lv_color_t color = grad_ver ? grad_ver[y - draw_area.y1] : style->body.main_color;
+            lv_blend_fill(clip_area, &fill_area, color, &mask_buf[used1], LV_DRAW_MASK_RES_CHANGED, opa,
+                          style->body.blend_mode);
+        }
+    }
+
+    if(grad_map) lv_mem_buf_release(grad_map);
+    if(grad_ver) lv_mem_buf_release(grad_ver);
+    lv_mem_buf_release(mask_buf);
+    lv_mem_buf_release(cov_buf);
+    lv_mem_buf_release(active);
+    lv_mem_buf_release(edges);
+}
+
+/**
+ * Add the coverage of a span of a sub-line to the coverage differences of a row.
+ * Only the ends of the span are written so long spans are as cheap as short ones.
+ * @param cov_buf the differences between the coverages of the neighboring pixels. Index 0 is `x_min`.
+ *                The coverage of a pixel is the sum of the differences until it.
+ * @param x_min left end of the drawn area (1/256 units)
+ * @param x_max right end of the drawn area, exclusive (1/256 units)
+ * @param xl left end of the span (1/256 units)
+ * @param xr right end of the span, exclusive (1/256 units)
+ * @param used1 the first used pixel of `cov_buf`. Extended (and cleared) if required.
+ * @param used2 the last used pixel of `cov_buf`. Extended (and cleared) if required. `used1 > used2` if unused.
+ *              The difference after it is used too.
+ */
+static void add_span(int16_t * cov_buf, int32_t x_min, int32_t x_max, int32_t xl, int32_t xr, int32_t * used1,
+                     int32_t * used2)
+{
+    xl = LV_MATH_MAX(xl, x_min) - x_min;
+    xr = LV_MATH_MIN(xr, x_max) - x_min;
+    if(xl >= xr) return;
+
+    int32_t px1 = xl >> 8;
+    int32_t px2 = (xr - 1) >> 8;
+
+    if(*used1 > *used2) {
+        memset(&cov_buf[px1], 0, (px2 - px1 + 2) * sizeof(int16_t));
+        *used1 = px1;
+        *used2 = px2;
+    } else {
+        if(px1 < *used1) {
+            memset(&cov_buf[px1], 0, (*used1 - px1) * sizeof(int16_t));
+            *used1 = px1;
+        }
+        if(px2 > *used2) {
+            memset(&cov_buf[*used2 + 2], 0, (px2 - *used2) * sizeof(int16_t));
+            *used2 = px2;
+        }
+    }
+
+    if(px1 == px2) {
+        cov_buf[px1] += xr - xl;
+        cov_buf[px1 + 1] -= xr - xl;
+    } else {
+        int32_t cov1 = ((px1 + 1) << 8) - xl;
+        int32_t cov2 = xr - (px2 << 8);
+        cov_buf[px1] += cov1;
+        cov_buf[px1 + 1] += 256 - cov1;
+        cov_buf[px2] += cov2 - 256;
+        cov_buf[px2 + 1] -= cov2;
+    }
+}
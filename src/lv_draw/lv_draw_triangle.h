@@ -23,6 +23,13 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** Which parts of a self-intersecting (or multiple times wound) polygon to fill*/
+enum {
+    LV_DRAW_FILL_RULE_NON_ZERO,     /**< Fill where the edges wind around the point at least once*/
+    LV_DRAW_FILL_RULE_EVEN_ODD,     /**< Fill where a ray from the point crosses the edges odd times*/
+};
+typedef uint8_t lv_draw_fill_rule_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -48,6 +55,20 @@ void lv_draw_triangle(const lv_point_t * points, const lv_area_t * clip, const l
 void lv_draw_polygon(const lv_point_t * points, uint16_t point_cnt, const lv_area_t * mask, const lv_style_t * style,
                      lv_opa_t opa_scale);
 
+/**
+ * Draw a polygon with a given fill rule. Concave and self-intersecting polygons are supported too.
+ * Unlike `lv_draw_polygon` the points are the top left corners of the pixels
+ * and only the body of the style is drawn (no border and shadow).
+ * @param points an array of points
+ * @param point_cnt number of points
+ * @param clip_area polygon will be drawn only in this area
+ * @param style style of the polygon (`body.main_color`, `body.grad_color`, `body.grad_dir` and `body.opa` are used)
+ * @param opa_scale scale down all opacities by the factor (0..255)
+ * @param rule an element of `lv_draw_fill_rule_t`
+ */
+void lv_draw_polygon_fill_rule(const lv_point_t * points, uint16_t point_cnt, const lv_area_t * mask,
+                               const lv_style_t * style, lv_opa_t opa_scale, lv_draw_fill_rule_t rule);
+
 /**********************
  *      MACROS
  **********************/
@@ -25,7 +25,11 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static inline bool transform_px(lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys);
 static inline bool transform_anti_alias(lv_img_transform_dsc_t * dsc);
+static void transform_clip_span(int64_t acc, int32_t step, uint8_t shift, int32_t lo, int32_t hi, int32_t * first,
+                                int32_t * last);
+static int64_t div_floor(int64_t a, int64_t b);
 
 /**********************
  *  STATIC VARIABLES
@@ -420,8 +424,6 @@ void lv_img_buf_transform_init(lv_img_transform_dsc_t * dsc)
  */
 bool lv_img_buf_transform(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y)
 {
-    const uint8_t * src_u8 = dsc->cfg.src;
-
     /*Get the target point relative coordinates to the pivot*/
     int32_t xt = x - dsc->cfg.pivot_x;
     int32_t yt = y - dsc->cfg.pivot_y;
@@ -440,6 +442,131 @@ bool lv_img_buf_transform(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t
 
     }
 
+    return transform_px(dsc, xs, ys);
+}
+
+/**
+ * Transform a row of pixels. It has the same result as calling `lv_img_buf_transform` for every pixel
+ * but the source coordinates are only stepped from pixel to pixel and
+ * the pixels whose source is out of the image are skipped without computing them.
+ * @param dsc a descriptor initialized by `lv_img_buf_transform_init`
+ * @param x the coordinate of the first pixel of the row
+ * @param y the coordinate of the row
+ * @param len number of pixels in the row
+ * @param color_buf store the colors here (`len` elements)
+ * @param opa_buf store the opacities here (`len` elements). 0 if the pixel is out of the image.
+ */
+void lv_img_buf_transform_row(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                              lv_color_t * color_buf, lv_opa_t * opa_buf)
+{
+    /* `xs = (acc_x >> shift) + pivot_x_256` as in `lv_img_buf_transform`,
+     * where `acc_x` changes with `step_x` from pixel to pixel (and same for `ys`).
+     * The accumulators are 64 bit to not overflow on long rows with large zoom.*/
+    int32_t xt = x - dsc->cfg.pivot_x;
+    int32_t yt = y - dsc->cfg.pivot_y;
+    int64_t acc_x;
+    int64_t acc_y;
+    int32_t step_x;
+    int32_t step_y;
+    uint8_t shift;
+
+    if(dsc->cfg.zoom == LV_IMG_ZOOM_NONE) {
+        shift  = LV_TRIGO_SHIFT - 8;
+        step_x = dsc->tmp.cosma;
+        step_y = dsc->tmp.sinma;
+    } else {
+        shift  = LV_TRIGO_SHIFT;
+        xt *= dsc->tmp.zoom_inv;
+        yt *= dsc->tmp.zoom_inv;
+        step_x = dsc->tmp.cosma * dsc->tmp.zoom_inv;
+        step_y = dsc->tmp.sinma * dsc->tmp.zoom_inv;
+    }
+    acc_x = (int64_t)dsc->tmp.cosma * xt - (int64_t)dsc->tmp.sinma * yt;
+    acc_y = (int64_t)dsc->tmp.sinma * xt + (int64_t)dsc->tmp.cosma * yt;
+
+    /*Find the part of the row whose source pixels are in the image*/
+    int32_t first;
+    int32_t last;
+    int32_t first_y;
+    int32_t last_y;
+    transform_clip_span(acc_x, step_x, shift, -dsc->tmp.pivot_x_256, dsc->cfg.src_w * 256 - dsc->tmp.pivot_x_256, &first, &last);
+    transform_clip_span(acc_y, step_y, shift, -dsc->tmp.pivot_y_256, dsc->cfg.src_h * 256 - dsc->tmp.pivot_y_256, &first_y, &last_y);
+    first = LV_MATH_MAX(first, first_y);
+    last  = LV_MATH_MIN(last, last_y);
+    first = LV_MATH_MAX(first, 0);
+    last  = LV_MATH_MIN(last, len - 1);
+
+    if(first > last) {
+        memset(opa_buf, LV_OPA_TRANSP, len);
+        return;
+    }
+
+    if(first > 0) memset(opa_buf, LV_OPA_TRANSP, first);
+    if(last < len - 1) memset(&opa_buf[last + 1], LV_OPA_TRANSP, len - last - 1);
+
+    acc_x += (int64_t)step_x * first;
+    acc_y += (int64_t)step_y * first;
+
+    int32_t i;
+
+    /*Nearest pixel from a true color image without alpha: just copy the pixels*/
+    if(dsc->cfg.antialias == false && dsc->tmp.native_color && dsc->tmp.has_alpha == 0 && dsc->tmp.chroma_keyed == 0) {
+        const lv_color_t * src = dsc->cfg.src;
+        for(i = first; i <= last; i++) {
+            int32_t xs_int = ((int32_t)(acc_x >> shift) + dsc->tmp.pivot_x_256) >> 8;
+            int32_t ys_int = ((int32_t)(acc_y >> shift) + dsc->tmp.pivot_y_256) >> 8;
+            color_buf[i] = src[ys_int * dsc->cfg.src_w + xs_int];
+            opa_buf[i]   = LV_OPA_COVER;
+            acc_x += step_x;
+            acc_y += step_y;
+        }
+        return;
+    }
+
+    /*Nearest pixel from a true color image with alpha byte*/
+    if(dsc->cfg.antialias == false && dsc->tmp.native_color && dsc->tmp.has_alpha) {
+        const uint8_t * src_u8 = dsc->cfg.src;
+        for(i = first; i <= last; i++) {
+            int32_t xs_int = ((int32_t)(acc_x >> shift) + dsc->tmp.pivot_x_256) >> 8;
+            int32_t ys_int = ((int32_t)(acc_y >> shift) + dsc->tmp.pivot_y_256) >> 8;
+            const uint8_t * px = &src_u8[(ys_int * dsc->cfg.src_w + xs_int) * LV_IMG_PX_SIZE_ALPHA_BYTE];
+            memcpy(&color_buf[i], px, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+            opa_buf[i] = px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+            acc_x += step_x;
+            acc_y += step_y;
+        }
+        return;
+    }
+
+    /*Other formats and anti-aliasing: the same as `lv_img_buf_transform` pixel by pixel*/
+    for(i = first; i <= last; i++) {
+        if(transform_px(dsc, (int32_t)(acc_x >> shift) + dsc->tmp.pivot_x_256, (int32_t)(acc_y >> shift) + dsc->tmp.pivot_y_256)) {
+            color_buf[i] = dsc->res.color;
+            opa_buf[i]   = dsc->res.opa;
+        } else {
+            opa_buf[i] = LV_OPA_TRANSP;
+        }
+        acc_x += step_x;
+        acc_y += step_y;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the color and opacity of a source pixel
+ * @param dsc a descriptor initialized by `lv_img_buf_transform_init`
+ * @param xs the X coordinate on the source image in 1/256 pixel units
+ * @param ys the Y coordinate on the source image in 1/256 pixel units
+ * @return true: there is valid pixel on these x/y coordinates; false: it's out of the image or transparent
+ * @note the result is written back to `dsc->res_color` and `dsc->res_opa`
+ */
+static inline bool transform_px(lv_img_transform_dsc_t * dsc, int32_t xs, int32_t ys)
+{
+    const uint8_t * src_u8 = dsc->cfg.src;
+
     /*Get the integer part of the source pixel*/
     int xs_int = xs >> 8;
     int ys_int = ys >> 8;
@@ -497,9 +624,6 @@ bool lv_img_buf_transform(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t
     return ret;
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
 static inline bool transform_anti_alias(lv_img_transform_dsc_t * dsc)
 {
     const uint8_t * src_u8 = dsc->cfg.src;
@@ -584,12 +708,15 @@ static inline bool transform_anti_alias(lv_img_transform_dsc_t * dsc)
 
 
         if(a0 <= LV_OPA_MIN && a1 <= LV_OPA_MIN) return false;
+#if LV_COLOR_PREMULT == 0
+        /*Don't mix with the color of transparent pixels. (Premultiplied transparent pixels are black anyway.)*/
         if(a0 <= LV_OPA_MIN) yr = LV_OPA_TRANSP;
         if(a1 <= LV_OPA_MIN) yr = LV_OPA_COVER;
         if(a00 <= LV_OPA_MIN) xr0 = LV_OPA_TRANSP;
         if(a10 <= LV_OPA_MIN) xr0 = LV_OPA_COVER;
         if(a01 <= LV_OPA_MIN) xr1 = LV_OPA_TRANSP;
         if(a11 <= LV_OPA_MIN) xr1 = LV_OPA_COVER;
+#endif
 
     } else {
         xr0 = xr;
@@ -604,3 +731,49 @@ static inline bool transform_anti_alias(lv_img_transform_dsc_t * dsc)
 
     return true;
 }
+
+/**
+ * Find the pixels of a row where `lo <= (acc >> shift) < hi` if `acc` changes with `step` from pixel to pixel
+ * @param acc the accumulator at the first pixel
+ * @param step change of the accumulator from pixel to pixel
+ * @param shift the accumulator is shifted by this before comparing
+ * @param lo the lower limit (inclusive)
+ * @param hi the upper limit (exclusive)
+ * @param first store the index of the first pixel in the limits here
+ * @param last store the index of the last pixel in the limits here (`first > last` if there is no such pixel)
+ */
+static void transform_clip_span(int64_t acc, int32_t step, uint8_t shift, int32_t lo, int32_t hi, int32_t * first,
+                                int32_t * last)
+{
+    /*`(acc >> shift) >= lo` is the same as `acc >= (lo << shift)`*/
+    int64_t lo_acc = (int64_t)lo << shift;
+    int64_t hi_acc = ((int64_t)hi << shift) - 1;
+
+    int64_t f;
+    int64_t l;
+    if(step == 0) {
+        if(acc >= lo_acc && acc <= hi_acc) {
+            f = INT32_MIN;
+            l = INT32_MAX;
+        } else {
+            f = 0;
+            l = -1;
+        }
+    } else if(step > 0) {
+        f = -div_floor(acc - lo_acc, step);
+        l = div_floor(hi_acc - acc, step);
+    } else {
+        f = -div_floor(hi_acc - acc, -step);
+        l = div_floor(acc - lo_acc, -step);
+    }
+
+    *first = (int32_t)LV_MATH_MIN(LV_MATH_MAX(f, INT32_MIN), INT32_MAX);
+    *last = (int32_t)LV_MATH_MIN(LV_MATH_MAX(l, INT32_MIN), INT32_MAX);
+}
+
+static int64_t div_floor(int64_t a, int64_t b)
+{
+    int64_t d = a / b;
+    if((a % b != 0) && ((a < 0) != (b < 0))) d--;
+    return d;
+}
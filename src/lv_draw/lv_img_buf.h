@@ -77,9 +77,10 @@ enum {
     LV_IMG_CF_ALPHA_4BIT, /**< Can have one color but 16 different alpha value*/
     LV_IMG_CF_ALPHA_8BIT, /**< Can have one color but 256 different alpha value*/
 
-    LV_IMG_CF_RESERVED_15,              /**< Reserved for further use. */
-    LV_IMG_CF_RESERVED_16,              /**< Reserved for further use. */
-    LV_IMG_CF_RESERVED_17,              /**< Reserved for further use. */
+    LV_IMG_CF_RLE_TRUE_COLOR,              /**< `LV_IMG_CF_TRUE_COLOR` compressed row by row with RLE*/
+    LV_IMG_CF_RLE_TRUE_COLOR_ALPHA,        /**< `LV_IMG_CF_TRUE_COLOR_ALPHA` compressed row by row with RLE*/
+    LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED, /**< `LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED` compressed row by row with RLE*/
+
     LV_IMG_CF_RESERVED_18,              /**< Reserved for further use. */
     LV_IMG_CF_RESERVED_19,              /**< Reserved for further use. */
     LV_IMG_CF_RESERVED_20,              /**< Reserved for further use. */
@@ -269,6 +270,20 @@ void lv_img_buf_transform_init(lv_img_transform_dsc_t * dsc);
  */
 bool lv_img_buf_transform(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y);
 
+/**
+ * Transform a row of pixels. It has the same result as calling `lv_img_buf_transform` for every pixel
+ * but the source coordinates are only stepped from pixel to pixel and
+ * the pixels whose source is out of the image are skipped without computing them.
+ * @param dsc a descriptor initialized by `lv_img_buf_transform_init`
+ * @param x the coordinate of the first pixel of the row
+ * @param y the coordinate of the row
+ * @param len number of pixels in the row
+ * @param color_buf store the colors here (`len` elements)
+ * @param opa_buf store the opacities here (`len` elements). 0 if the pixel is out of the image.
+ */
+void lv_img_buf_transform_row(lv_img_transform_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                              lv_color_t * color_buf, lv_opa_t * opa_buf);
+
 
 /**********************
  *      MACROS
@@ -12,6 +12,11 @@
 #include "lv_draw_img.h"
 #include "../lv_hal/lv_hal_tick.h"
 #include "../lv_misc/lv_gc.h"
+#if LV_IMG_CACHE_ASYNC
+#include "../lv_core/lv_refr.h"
+#include "../lv_misc/lv_task.h"
+#include "../lv_misc/lv_ll.h"
+#endif
 
 #if defined(LV_GC_INCLUDE)
 #include LV_GC_INCLUDE
@@ -19,9 +24,6 @@
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value in every open*/
-#define LV_IMG_CACHE_AGING 1
-
 /*Boost life by this factor (multiply time_to_open with this value)*/
 #define LV_IMG_CACHE_LIFE_GAIN 1
 
@@ -29,22 +31,79 @@
  * "die" from very high values */
 #define LV_IMG_CACHE_LIFE_LIMIT 1000
 
+/*Marks the end of a hash bucket's chain*/
+#define LV_IMG_CACHE_NONE   0xFFFF
+
 #if LV_IMG_CACHE_DEF_SIZE < 1
 #error "LV_IMG_CACHE_DEF_SIZE must be >= 1. See lv_conf.h"
 #endif
 
+#if LV_IMG_CACHE_ASYNC && LV_USE_PARALLEL_DRAW == 0
+#error "LV_IMG_CACHE_ASYNC requires the lock (and the thread-safe allocator) of LV_USE_PARALLEL_DRAW. See lv_conf.h"
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_IMG_CACHE_ASYNC
+/*States of the images opened in the background*/
+enum {
+    REQ_QUEUED,     /*Waiting for the worker thread*/
+    REQ_BUSY,       /*Being opened by the worker thread. Not removed until it's finished.*/
+    REQ_READY,      /*Opened and added to the cache. Removed after the redraw is requested.*/
+    REQ_FAILED,     /*Couldn't be opened. Kept until the source is invalidated to not try it on every redraw.*/
+};
+typedef uint8_t req_state_t;
+
+/*An image waiting to be opened in the background.
+ *Everything used by the worker thread is copied because the drawn object might be deleted meanwhile.*/
+typedef struct
+{
+    const void * src;               /*The image source. The file names are copied.*/
+    lv_img_src_t src_type;
+    const lv_style_t * style_key;   /*The style the image was drawn with. Only compared, never dereferenced.*/
+    lv_style_t style;               /*Copy of the style to open the image with*/
+    lv_disp_t * disp;               /*The display where the image was drawn. Only compared to the existing displays.*/
+    lv_area_t area;                 /*The area where the image was drawn. Invalidated when the image is opened.*/
+    req_state_t state;
+    uint8_t redraw : 1;             /*1: the image is opened (or failed), `area` needs to be invalidated*/
+    uint8_t canceled : 1;           /*1: invalidated while it's being opened. Removed by the worker thread.*/
+} lv_img_cache_async_req_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_img_cache_entry_t * find_entry(const void * src, lv_img_src_t src_type, uint32_t hash,
+                                         const lv_style_t * style);
+static uint32_t src_hash(const void * src, lv_img_src_t src_type, const lv_style_t * style);
+static uint32_t ptr_hash(uint32_t h, const void * p);
+static bool src_match(const lv_img_cache_entry_t * entry, const void * src, lv_img_src_t src_type);
+static uint32_t get_mem_size(const lv_img_decoder_dsc_t * dsc);
+static lv_img_cache_entry_t * find_victim(const lv_img_cache_entry_t * except, bool unused_only, bool mem_only);
+static lv_img_cache_entry_t * entry_get_free(void);
+static void entry_add(lv_img_cache_entry_t * entry, uint32_t hash);
+static void entry_close(lv_img_cache_entry_t * entry);
+static void invalidate_src(const void * src);
+#if LV_IMG_CACHE_ASYNC
+static bool need_async(const void * src, lv_img_src_t src_type);
+static lv_img_cache_async_req_t * find_req(const void * src, lv_img_src_t src_type, const lv_style_t * style);
+static bool req_match(const lv_img_cache_async_req_t * req, const void * src, lv_img_src_t src_type);
+static void req_remove(lv_img_cache_async_req_t * req);
+static bool disp_exists(const lv_disp_t * disp);
+static void async_task(lv_task_t * task);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint16_t entry_cnt;
+static uint16_t * buckets;              /*The first entry of the hash buckets. Allocated after the entries.*/
+static uint16_t bucket_mask;            /*Number of buckets - 1*/
+static uint32_t mem_max = LV_IMG_CACHE_MEM_SIZE;
+static uint32_t use_cnt;                /*Incremented on every open to find the least recently used entry*/
+static uint32_t frame_act = 1;          /*Counts the frames to know which images are used now*/
+static lv_img_cache_stats_t cache_stats;
 
 /**********************
  *      MACROS
@@ -58,6 +117,7 @@ static uint16_t entry_cnt;
  * Open an image using the image decoder interface and cache it.
  * The image will be left open meaning if the image decoder open callback allocated memory then it will remain.
  * The image is closed if a new image is opened and the new image takes its place in the cache.
+ * Should be called in `LV_DRAW_LOCK`.
  * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
  * @param style style of the image
  * @return pointer to the cache entry or NULL if can open the image
@@ -69,83 +129,232 @@ lv_img_cache_entry_t * lv_img_cache_open(const void * src, const lv_style_t * st
         return NULL;
     }
 
-    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
-    }
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    uint32_t hash = src_hash(src, src_type, style);
+    use_cnt++;
 
     /*Is the image cached?*/
-    lv_img_cache_entry_t * cached_src = NULL;
-    for(i = 0; i < entry_cnt; i++) {
-        bool match = false;
-        lv_img_src_t src_type = lv_img_src_get_type(cache[i].dec_dsc.src);
-        if(src_type == LV_IMG_SRC_VARIABLE) {
-            if(cache[i].dec_dsc.src == src && cache[i].dec_dsc.style == style) match = true;
-        } else if(src_type == LV_IMG_SRC_FILE) {
-            if(strcmp(cache[i].dec_dsc.src, src) == 0) match = true;
-        }
-
-        if(match) {
-            /* If opened increment its life.
-             * Image difficult to open should live longer to keep avoid frequent their recaching.
-             * Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
-            LV_LOG_TRACE("image draw: image found in the cache");
-            break;
-        }
+    lv_img_cache_entry_t * entry = find_entry(src, src_type, hash, style);
+    if(entry) {
+        /* Image difficult to open should live longer to keep avoid frequent their recaching.
+         * Therefore add `time_to_open` to `life`*/
+        uint32_t bonus = entry->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
+        if(bonus > LV_IMG_CACHE_LIFE_LIMIT) bonus = LV_IMG_CACHE_LIFE_LIMIT;
+        entry->life       = use_cnt + bonus;
+        entry->last_frame = frame_act;
+        cache_stats.hit_cnt++;
+        LV_LOG_TRACE("image draw: image found in the cache");
+        return entry;
     }
 
+    cache_stats.miss_cnt++;
+
     /*The image is not cached then cache it now*/
+    lv_img_cache_entry_t * cached_src = entry_get_free();
     if(cached_src == NULL) {
-        /*Find an entry to reuse. Select the entry with the least life*/
-        cached_src = &cache[0];
-        for(i = 1; i < entry_cnt; i++) {
-            if(cache[i].life < cached_src->life) {
-                cached_src = &cache[i];
-            }
-        }
+        LV_LOG_WARN("lv_img_cache_open: all the cached images are being drawn");
+        return NULL;
+    }
 
-        /*Close the decoder to reuse if it was opened (has a valid source)*/
-        if(cached_src->dec_dsc.src) {
-            lv_img_decoder_close(&cached_src->dec_dsc);
-            LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
-        } else {
-            LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
-        }
+    /*Open the image and measure the time to open*/
+    uint32_t t_start;
+    t_start                          = lv_tick_get();
+    cached_src->dec_dsc.time_to_open = 0;
+    lv_res_t open_res                = lv_img_decoder_open(&cached_src->dec_dsc, src, style);
+    if(open_res == LV_RES_INV) {
+        LV_LOG_WARN("Image draw cannot open the image resource");
+        lv_img_decoder_close(&cached_src->dec_dsc);
+        memset(cached_src, 0, sizeof(lv_img_cache_entry_t));
+        return NULL;
+    }
+
+    /*If `time_to_open` was not set in the open function set it here*/
+    if(cached_src->dec_dsc.time_to_open == 0) {
+        cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
+    }
+
+    if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
 
-        /*Open the image and measure the time to open*/
-        uint32_t t_start;
-        t_start                          = lv_tick_get();
-        cached_src->dec_dsc.time_to_open = 0;
-        lv_res_t open_res                = lv_img_decoder_open(&cached_src->dec_dsc, src, style);
-        if(open_res == LV_RES_INV) {
-            LV_LOG_WARN("Image draw cannot open the image resource");
-            lv_img_decoder_close(&cached_src->dec_dsc);
-            memset(&cached_src->dec_dsc, 0, sizeof(lv_img_decoder_dsc_t));
-            memset(cached_src, 0, sizeof(lv_img_cache_entry_t));
-            cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its use  */
+    entry_add(cached_src, hash);
+
+    return cached_src;
+}
+
+#if LV_IMG_CACHE_ASYNC
+/**
+ * Initialize the queue of the images opened in the background
+ */
+void lv_img_cache_async_init(void)
+{
+    lv_ll_init(&LV_GC_ROOT(_lv_img_cache_async_ll), sizeof(lv_img_cache_async_req_t));
+
+    /*Redraw the images opened by the worker thread. `lv_inv_area` can be called only here, on the UI thread.*/
+    lv_task_create(async_task, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_LOW, NULL);
+}
+
+/**
+ * Get an image from the cache without waiting for it to open.
+ * If the image is not cached yet it's queued to be opened by `lv_img_cache_async_work` on a worker thread
+ * and `area` will be invalidated when it's ready.
+ * Images which are opened quickly (true color and alpha `lv_img_dsc_t` variables) are opened immediately.
+ * Should be called in `LV_DRAW_LOCK`.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param style style of the image
+ * @param area the area where the image is drawn (typically the clip area). Invalidated on the refreshing display.
+ * @param pending store `true` here if the image is being opened, `false` if it is opened or failed to open
+ * @return pointer to the cache entry or NULL if the image is not opened yet or can't be opened
+ */
+lv_img_cache_entry_t * lv_img_cache_open_async(const void * src, const lv_style_t * style, const lv_area_t * area,
+                                               bool * pending)
+{
+    *pending = false;
+
+    if(entry_cnt == 0) {
+        LV_LOG_WARN("lv_img_cache_open_async: the cache size is 0");
+        return NULL;
+    }
+
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(need_async(src, src_type) == false) return lv_img_cache_open(src, style);
+
+    /*Already opened? (`lv_img_cache_open` updates the life of the entry too)*/
+    if(find_entry(src, src_type, src_hash(src, src_type, style), style)) return lv_img_cache_open(src, style);
+
+    /*Already queued? Invalidate this area too when it's ready.*/
+    lv_img_cache_async_req_t * req = find_req(src, src_type, style);
+    if(req) {
+        if(req->state == REQ_FAILED) return NULL;
+
+        lv_area_join(&req->area, &req->area, area);
+        *pending = true;
+        return NULL;
+    }
+
+    req = lv_ll_ins_tail(&LV_GC_ROOT(_lv_img_cache_async_ll));
+    LV_ASSERT_MEM(req);
+    if(req == NULL) return NULL;
+
+    if(src_type == LV_IMG_SRC_FILE) {
+        char * fn = lv_mem_alloc(strlen(src) + 1);
+        LV_ASSERT_MEM(fn);
+        if(fn == NULL) {
+            lv_ll_remove(&LV_GC_ROOT(_lv_img_cache_async_ll), req);
+            lv_mem_free(req);
             return NULL;
         }
+        strcpy(fn, src);
+        req->src = fn;
+    } else {
+        req->src = src;
+    }
 
-        cached_src->life = 0;
+    req->src_type  = src_type;
+    req->style_key = style;
+    lv_style_copy(&req->style, style);
+    req->disp   = lv_refr_get_disp_refreshing();
+    req->state    = REQ_QUEUED;
+    req->redraw   = 0;
+    req->canceled = 0;
+    lv_area_copy(&req->area, area);
 
-        /*If `time_to_open` was not set in the open function set it here*/
-        if(cached_src->dec_dsc.time_to_open == 0) {
-            cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
-        }
+    LV_LOG_INFO("image draw: queued the image to open it in the background");
+    *pending = true;
+    return NULL;
+}
 
-        if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
+/**
+ * Check whether an image can be drawn now, i.e. `lv_img_cache_open_async` won't defer it.
+ * Should be called in `LV_DRAW_LOCK`.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param style style of the image
+ * @return true: the image is cached or opened immediately; false: the image is not opened yet
+ */
+bool lv_img_cache_is_ready(const void * src, const lv_style_t * style)
+{
+    if(entry_cnt == 0) return false;
+
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(need_async(src, src_type) == false) return true;
+
+    return find_entry(src, src_type, src_hash(src, src_type, style), style) ? true : false;
+}
+
+/**
+ * Open the next queued image and add it to the cache.
+ * Call it from a worker thread, e.g. in a loop with a short sleep if it returns `false`.
+ * The image is opened without holding the lock, so the rendering is not blocked meanwhile.
+ * The decoders and the file system drivers need to be thread-safe.
+ * @return true: an image was processed; false: there was nothing to open (or no free entry for it)
+ */
+bool lv_img_cache_async_work(void)
+{
+    LV_DRAW_LOCK();
+    lv_img_cache_async_req_t * req;
+    LV_LL_READ(LV_GC_ROOT(_lv_img_cache_async_ll), req) {
+        if(req->state == REQ_QUEUED) break;
     }
 
-    return cached_src;
+    if(req == NULL) {
+        LV_DRAW_UNLOCK();
+        return false;
+    }
+
+    /*Busy requests are not removed so `req` remains valid without the lock*/
+    req->state = REQ_BUSY;
+    LV_DRAW_UNLOCK();
+
+    lv_img_decoder_dsc_t dsc;
+    memset(&dsc, 0, sizeof(dsc));
+    uint32_t t_start = lv_tick_get();
+    lv_res_t open_res = lv_img_decoder_open(&dsc, req->src, &req->style);
+    if(open_res == LV_RES_INV) {
+        LV_LOG_WARN("image draw: can't open the queued image");
+        lv_img_decoder_close(&dsc);
+    } else {
+        if(dsc.time_to_open == 0) dsc.time_to_open = lv_tick_elaps(t_start);
+        if(dsc.time_to_open == 0) dsc.time_to_open = 1;
+
+        /*Identify the entry with the original style (the copy is freed with the request)*/
+        dsc.style = req->style_key;
+    }
+
+    LV_DRAW_LOCK();
+    /*The image was invalidated meanwhile so drop it*/
+    if(req->canceled) {
+        if(open_res != LV_RES_INV) lv_img_decoder_close(&dsc);
+        req_remove(req);
+        LV_DRAW_UNLOCK();
+        return true;
+    }
+
+    if(open_res == LV_RES_INV || entry_cnt == 0) {
+        if(open_res != LV_RES_INV) lv_img_decoder_close(&dsc);
+        req->state = REQ_FAILED;
+    } else {
+        uint32_t hash = src_hash(req->src, req->src_type, req->style_key);
+        lv_img_cache_entry_t * entry = NULL;
+        if(find_entry(req->src, req->src_type, hash, req->style_key) == NULL) entry = entry_get_free();
+
+        if(entry) {
+            use_cnt++;
+            entry->dec_dsc = dsc;
+            entry_add(entry, hash);
+            req->state = REQ_READY;
+        } else {
+            /*Opened meanwhile by `lv_img_cache_open` or all the entries are being drawn*/
+            lv_img_decoder_close(&dsc);
+            req->state = find_entry(req->src, req->src_type, hash, req->style_key) ? REQ_READY : REQ_QUEUED;
+        }
+    }
+
+    /*Retry later if it couldn't be added*/
+    bool done = req->state != REQ_QUEUED;
+    if(done) req->redraw = 1;
+    LV_DRAW_UNLOCK();
+
+    return done;
 }
+#endif
 
 /**
  * Set the number of images to be cached.
@@ -155,52 +364,477 @@ lv_img_cache_entry_t * lv_img_cache_open(const void * src, const lv_style_t * st
  */
 void lv_img_cache_set_size(uint16_t new_entry_cnt)
 {
+    LV_DRAW_LOCK();
     if(LV_GC_ROOT(_lv_img_cache_array) != NULL) {
         /*Clean the cache before free it*/
-        lv_img_cache_invalidate_src(NULL);
+        invalidate_src(NULL);
         lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
     }
 
-    /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt);
+    if(new_entry_cnt >= LV_IMG_CACHE_NONE) new_entry_cnt = LV_IMG_CACHE_NONE - 1;
+
+    /*Use at least as many hash buckets as entries*/
+    uint32_t bucket_cnt = 1;
+    while(bucket_cnt < new_entry_cnt) bucket_cnt <<= 1;
+
+    /*Reallocate the cache. The buckets are stored after the entries.*/
+    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(lv_img_cache_entry_t) * new_entry_cnt +
+                                                   sizeof(uint16_t) * bucket_cnt);
     LV_ASSERT_MEM(LV_GC_ROOT(_lv_img_cache_array));
     if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
         entry_cnt = 0;
+        buckets = NULL;
+        LV_DRAW_UNLOCK();
         return;
     }
-    entry_cnt = new_entry_cnt;
+    entry_cnt   = new_entry_cnt;
+    buckets     = (uint16_t *)&LV_GC_ROOT(_lv_img_cache_array)[entry_cnt];
+    bucket_mask = bucket_cnt - 1;
 
     /*Clean the cache*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        memset(&LV_GC_ROOT(_lv_img_cache_array)[i].dec_dsc, 0, sizeof(lv_img_decoder_dsc_t));
-        memset(&LV_GC_ROOT(_lv_img_cache_array)[i], 0, sizeof(lv_img_cache_entry_t));
+    memset(LV_GC_ROOT(_lv_img_cache_array), 0, sizeof(lv_img_cache_entry_t) * entry_cnt);
+    memset(buckets, 0xFF, sizeof(uint16_t) * bucket_cnt);
+    cache_stats.mem_used   = 0;
+    cache_stats.entry_used = 0;
+    cache_stats.entry_cnt  = entry_cnt;
+    LV_DRAW_UNLOCK();
+}
+
+/**
+ * Set the max. size of the decoded images in the cache.
+ * If the new images don't fit the least recently used images are closed.
+ * The images opened in the current frame are not closed so the limit can be exceeded temporarily.
+ * @param size size in bytes. 0: no limit (only the number of images is limited)
+ */
+void lv_img_cache_set_mem_size(uint32_t size)
+{
+    LV_DRAW_LOCK();
+    mem_max = size;
+
+    while(mem_max && cache_stats.mem_used > mem_max) {
+        lv_img_cache_entry_t * victim = find_victim(NULL, true, true);
+        if(victim == NULL) break;
+        entry_close(victim);
+        cache_stats.evict_cnt++;
     }
+    LV_DRAW_UNLOCK();
+}
+
+/**
+ * Start a new frame. The images opened in the current frame are not closed to free memory.
+ * Call it before refreshing a display.
+ */
+void lv_img_cache_new_frame(void)
+{
+    LV_DRAW_LOCK();
+    frame_act++;
+    LV_DRAW_UNLOCK();
+}
+
+/**
+ * Get the statistics of the image cache
+ * @param stats the statistics will be stored here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats)
+{
+    LV_DRAW_LOCK();
+    *stats = cache_stats;
+    LV_DRAW_UNLOCK();
 }
 
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
+ * With `LV_IMG_CACHE_ASYNC` the queued requests are removed too, and if the worker thread is opening the image
+ * the result is dropped. The decoder reads `lv_img_dsc_t` variables while opening them so these are waited for
+ * (see `LV_IMG_CACHE_ASYNC_WAIT`), and the variable can be freed after this function.
  * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * `NULL` to invalidate all images.
  */
 void lv_img_cache_invalidate_src(const void * src)
 {
+    LV_DRAW_LOCK();
+    invalidate_src(src);
+    LV_DRAW_UNLOCK();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Close the entries and remove the requests of an image source. Should be called in `LV_DRAW_LOCK`.
+ * @param src an image source or `NULL` for all images
+ */
+static void invalidate_src(const void * src)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    lv_img_src_t src_type = src ? lv_img_src_get_type(src) : LV_IMG_SRC_UNKNOWN;
+
+#if LV_IMG_CACHE_ASYNC
+    /*The worker thread drops the images it's opening when it's finished (and removes their requests).
+     *It still reads the variables until then so wait for them to let the caller free them.*/
+    lv_img_cache_async_req_t * req;
+    bool wait;
+    do {
+        wait = false;
+        LV_LL_READ(LV_GC_ROOT(_lv_img_cache_async_ll), req) {
+            if(req->state != REQ_BUSY || req_match(req, src, src_type) == false) continue;
+
+            req->canceled = 1;
+            if(req->src_type == LV_IMG_SRC_VARIABLE) wait = true;
+        }
+
+        if(wait) {
+            LV_DRAW_UNLOCK();
+            LV_IMG_CACHE_ASYNC_WAIT();
+            LV_DRAW_LOCK();
+        }
+    } while(wait);
+
+    /*Forget the queued and failed requests too*/
+    req = lv_ll_get_head(&LV_GC_ROOT(_lv_img_cache_async_ll));
+    while(req) {
+        lv_img_cache_async_req_t * req_next = lv_ll_get_next(&LV_GC_ROOT(_lv_img_cache_async_ll), req);
+        if(req->state != REQ_BUSY && req_match(req, src, src_type)) req_remove(req);
+        req = req_next;
+    }
+#endif
+
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        if(cache[i].dec_dsc.src == NULL) continue;
+        if(src == NULL || src_match(&cache[i], src, src_type)) {
+            entry_close(&cache[i]);
+        }
+    }
+}
+
+/**
+ * Find an opened entry
+ * @param src the image source
+ * @param src_type type of `src`
+ * @param hash hash of `src` and `style`
+ * @param style the style of the image
+ * @return the entry or NULL if the image is not cached
+ */
+static lv_img_cache_entry_t * find_entry(const void * src, lv_img_src_t src_type, uint32_t hash,
+                                         const lv_style_t * style)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+
+    uint16_t i;
+    for(i = buckets[hash & bucket_mask]; i != LV_IMG_CACHE_NONE; i = cache[i].next) {
+        lv_img_cache_entry_t * entry = &cache[i];
+        if(entry->hash != hash || entry->dec_dsc.style != style) continue;
+        if(src_match(entry, src, src_type) == false) continue;
+
+        return entry;
+    }
+
+    return NULL;
+}
+
+/**
+ * Get the hash of an image source and style
+ * @param src the image source
+ * @param src_type type of `src`
+ * @param style the style of the image
+ * @return the hash
+ */
+static uint32_t src_hash(const void * src, lv_img_src_t src_type, const lv_style_t * style)
+{
+    uint32_t h = 2166136261u;
+
+    /*Variables are identified by their address and the other sources by their text*/
+    if(src_type == LV_IMG_SRC_VARIABLE) {
+        h = ptr_hash(h, src);
+    } else {
+        const uint8_t * txt = src;
+        while(*txt) {
+            h ^= *txt;
+            h *= 16777619u;
+            txt++;
+        }
+    }
+
+    return ptr_hash(h, style);
+}
+
+/**
+ * Add a pointer to a FNV-1a hash
+ * @param h the hash so far
+ * @param p the pointer
+ * @return the new hash
+ */
+static uint32_t ptr_hash(uint32_t h, const void * p)
+{
+    uintptr_t v = (uintptr_t)p;
+    uint8_t i;
+    for(i = 0; i < sizeof(uintptr_t); i++) {
+        h ^= v & 0xFF;
+        h *= 16777619u;
+        v >>= 8;
+    }
+
+    return h;
+}
+
+/**
+ * Check whether an entry was opened from a given image source
+ * @param entry pointer to an opened entry
+ * @param src the image source
+ * @param src_type type of `src`
+ * @return true: the sources are the same
+ */
+static bool src_match(const lv_img_cache_entry_t * entry, const void * src, lv_img_src_t src_type)
+{
+    if(entry->dec_dsc.src_type != src_type) return false;
+
+    /*The file names are copied by the decoder so compare the texts*/
+    if(src_type == LV_IMG_SRC_VARIABLE) return entry->dec_dsc.src == src;
+    else return strcmp(entry->dec_dsc.src, src) == 0;
+}
+
+/**
+ * Get the size of the decoded image of an opened image
+ * @param dsc pointer to an opened decoder descriptor
+ * @return size of the image data allocated by the decoder in bytes
+ */
+static uint32_t get_mem_size(const lv_img_decoder_dsc_t * dsc)
+{
+    /*The image is read line by line or the decoder uses the data of the variable directly*/
+    if(dsc->img_data == NULL) return 0;
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE && dsc->img_data == ((const lv_img_dsc_t *)dsc->src)->data) return 0;
+    if(dsc->img_data_mapped) return 0;
+
+    uint32_t px_size = lv_img_cf_get_px_size(dsc->header.cf);
+    if(px_size == 0) px_size = LV_IMG_PX_SIZE_ALPHA_BYTE * 8;
 
+    return ((uint32_t)dsc->header.w * dsc->header.h * px_size) >> 3;
+}
+
+/**
+ * Find the opened entry which should be reused or closed first: the one with the least life.
+ * @param except don't return this entry (can be NULL)
+ * @param unused_only true: only consider the entries which were not used in the current frame
+ * @param mem_only true: only consider the entries which have allocated image data
+ * @return the entry or NULL if there is no suitable entry
+ */
+static lv_img_cache_entry_t * find_victim(const lv_img_cache_entry_t * except, bool unused_only, bool mem_only)
+{
     lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    lv_img_cache_entry_t * victim = NULL;
 
     uint16_t i;
     for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].dec_dsc.src == src || src == NULL) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
+        lv_img_cache_entry_t * entry = &cache[i];
+        if(entry == except || entry->dec_dsc.src == NULL) continue;
+        if(unused_only && entry->last_frame == frame_act) continue;
+        if(mem_only && entry->mem_size == 0) continue;
+#if LV_USE_PARALLEL_DRAW
+        if(entry->draw_cnt) continue;
+#endif
+
+        /*The difference handles the overflow of `use_cnt`*/
+        if(victim == NULL || (int32_t)(entry->life - victim->life) < 0) victim = entry;
+    }
+
+    return victim;
+}
+
+/**
+ * Get an entry for a new image: an empty entry or the least recently used one, which is closed.
+ * Prefer the entries not used in this frame.
+ * @return pointer to an empty entry or NULL if all the entries are being drawn
+ */
+static lv_img_cache_entry_t * entry_get_free(void)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        if(cache[i].dec_dsc.src == NULL) {
+            LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
+            return &cache[i];
+        }
+    }
+
+    lv_img_cache_entry_t * entry = find_victim(NULL, true, false);
+    if(entry == NULL) entry = find_victim(NULL, false, false);
+    if(entry == NULL) return NULL;
+
+    /*Close the decoder to reuse the entry*/
+    entry_close(entry);
+    cache_stats.evict_cnt++;
+    LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
+
+    return entry;
+}
+
+/**
+ * Add an entry with a just opened image to the cache.
+ * Close the least recently used images if the decoded images need too much memory.
+ * @param entry pointer to an entry with an opened `dec_dsc`
+ * @param hash hash of the source and the style
+ */
+static void entry_add(lv_img_cache_entry_t * entry, uint32_t hash)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+
+    entry->life       = use_cnt;
+    entry->last_frame = frame_act;
+    entry->hash       = hash;
+    entry->mem_size   = get_mem_size(&entry->dec_dsc);
+    entry->next       = buckets[hash & bucket_mask];
+    buckets[hash & bucket_mask] = entry - cache;
+
+    cache_stats.mem_used += entry->mem_size;
+    cache_stats.entry_used++;
+
+    if(mem_max) {
+        while(cache_stats.mem_used > mem_max) {
+            lv_img_cache_entry_t * victim = find_victim(entry, true, true);
+            if(victim == NULL) {
+                LV_LOG_INFO("image draw: the images of the frame don't fit into the cache");
+                break;
             }
+            entry_close(victim);
+            cache_stats.evict_cnt++;
+        }
+    }
+}
+
+/**
+ * Close the image of an entry and remove it from its hash bucket
+ * @param entry pointer to an opened entry
+ */
+static void entry_close(lv_img_cache_entry_t * entry)
+{
+    lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint16_t id = entry - cache;
 
-            memset(&cache[i].dec_dsc, 0, sizeof(lv_img_decoder_dsc_t));
-            memset(&cache[i], 0, sizeof(lv_img_cache_entry_t));
+    uint16_t * link = &buckets[entry->hash & bucket_mask];
+    while(*link != LV_IMG_CACHE_NONE) {
+        if(*link == id) {
+            *link = entry->next;
+            break;
         }
+        link = &cache[*link].next;
     }
+
+    cache_stats.mem_used -= entry->mem_size;
+    cache_stats.entry_used--;
+
+    lv_img_decoder_close(&entry->dec_dsc);
+    memset(entry, 0, sizeof(lv_img_cache_entry_t));
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
+#if LV_IMG_CACHE_ASYNC
+/**
+ * Check whether an image source might be slow to open and should be opened in the background
+ * @param src the image source
+ * @param src_type type of `src`
+ * @return true: open it in the background; false: open it immediately
+ */
+static bool need_async(const void * src, lv_img_src_t src_type)
+{
+    if(src_type == LV_IMG_SRC_FILE) return true;
+    if(src_type != LV_IMG_SRC_VARIABLE) return false;
+
+    /*The pixels of these variables are used directly*/
+    lv_img_cf_t cf = ((const lv_img_dsc_t *)src)->header.cf;
+    if(cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_TRUE_COLOR_ALPHA || cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED ||
+       cf == LV_IMG_CF_ALPHA_1BIT || cf == LV_IMG_CF_ALPHA_2BIT || cf == LV_IMG_CF_ALPHA_4BIT ||
+       cf == LV_IMG_CF_ALPHA_8BIT) {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Find the request of an image in the background queue
+ * @param src the image source
+ * @param src_type type of `src`
+ * @param style the style of the image
+ * @return the request or NULL if the image is not queued
+ */
+static lv_img_cache_async_req_t * find_req(const void * src, lv_img_src_t src_type, const lv_style_t * style)
+{
+    lv_img_cache_async_req_t * req;
+    LV_LL_READ(LV_GC_ROOT(_lv_img_cache_async_ll), req) {
+        if(req->canceled) continue;    /*Just waiting to be removed by the worker thread*/
+        if(req->style_key == style && req_match(req, src, src_type)) return req;
+    }
+
+    return NULL;
+}
+
+/**
+ * Check whether a request is for a given image source
+ * @param req pointer to a request
+ * @param src the image source or `NULL` to match any source
+ * @param src_type type of `src`
+ * @return true: the sources are the same
+ */
+static bool req_match(const lv_img_cache_async_req_t * req, const void * src, lv_img_src_t src_type)
+{
+    if(src == NULL) return true;
+    if(req->src_type != src_type) return false;
+
+    if(src_type == LV_IMG_SRC_VARIABLE) return req->src == src;
+    else return strcmp(req->src, src) == 0;
+}
+
+/**
+ * Remove a request from the background queue
+ * @param req pointer to a request
+ */
+static void req_remove(lv_img_cache_async_req_t * req)
+{
+    if(req->src_type == LV_IMG_SRC_FILE) lv_mem_free(req->src);
+
+    lv_ll_remove(&LV_GC_ROOT(_lv_img_cache_async_ll), req);
+    lv_mem_free(req);
+}
+
+/**
+ * Check whether a display still exists
+ * @param disp pointer to a display. Not dereferenced.
+ * @return true: `disp` is a registered display
+ */
+static bool disp_exists(const lv_disp_t * disp)
+{
+    lv_disp_t * d;
+    for(d = lv_disp_get_next(NULL); d != NULL; d = lv_disp_get_next(d)) {
+        if(d == disp) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Redraw the areas of the images opened (or failed) by the worker thread
+ * @param task pointer to the task
+ */
+static void async_task(lv_task_t * task)
+{
+    (void)task; /*Unused*/
+
+    LV_DRAW_LOCK();
+    lv_img_cache_async_req_t * req = lv_ll_get_head(&LV_GC_ROOT(_lv_img_cache_async_ll));
+    while(req) {
+        lv_img_cache_async_req_t * req_next = lv_ll_get_next(&LV_GC_ROOT(_lv_img_cache_async_ll), req);
+        if(req->redraw) {
+            /*The display might have been removed since the image was drawn*/
+            if(disp_exists(req->disp)) lv_inv_area(req->disp, &req->area);
+            req->redraw = 0;
+
+            /*Keep the failed requests to not try them on every redraw*/
+            if(req->state == REQ_READY) req_remove(req);
+        }
+        req = req_next;
+    }
+    LV_DRAW_UNLOCK();
+}
+#endif
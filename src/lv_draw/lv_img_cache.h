@@ -32,12 +32,42 @@ typedef struct
 {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information */
 
-    /** Count the cache entries's life. Add `time_tio_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused */
-    int32_t life;
+    /** The value of an internal counter (incremented on every open) when the entry was last used.
+     * Images difficult to open get `time_to_open` extra life.
+     * The entry with the least life is reused first. */
+    uint32_t life;
+
+    /** The frame when the entry was last used. The entries used in the current frame are not closed
+     * to free memory. */
+    uint32_t last_frame;
+
+    /** Size of the decoded image in bytes. 0 if `img_data` is not allocated by the decoder
+     * (e.g. it points to the data of an `lv_img_dsc_t` variable or the image is read line by line). */
+    uint32_t mem_size;
+
+    /** Hash of the source and the style to find the entry quickly*/
+    uint32_t hash;
+
+    /** Index of the next entry with the same hash bucket*/
+    uint16_t next;
+
+#if LV_USE_PARALLEL_DRAW
+    /** Number of threads drawing the image now. Such entries are not closed.*/
+    uint16_t draw_cnt;
+#endif
 } lv_img_cache_entry_t;
 
+/** Statistics of the image cache. The counters are incremented since `lv_init`*/
+typedef struct
+{
+    uint32_t hit_cnt;       /**< Number of opens served from the cache*/
+    uint32_t miss_cnt;      /**< Number of opens which needed to open the image with a decoder*/
+    uint32_t evict_cnt;     /**< Number of images closed to make place for an other image*/
+    uint32_t mem_used;      /**< Size of the decoded images currently in the cache in bytes*/
+    uint16_t entry_used;    /**< Number of images currently in the cache*/
+    uint16_t entry_cnt;     /**< Max. number of images in the cache*/
+} lv_img_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -46,12 +76,53 @@ typedef struct
  * Open an image using the image decoder interface and cache it.
  * The image will be left open meaning if the image decoder open callback allocated memory then it will remain.
  * The image is closed if a new image is opened and the new image takes its place in the cache.
+ * Should be called in `LV_DRAW_LOCK`.
  * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
  * @param style style of the image
  * @return pointer to the cache entry or NULL if can open the image
  */
 lv_img_cache_entry_t * lv_img_cache_open(const void * src, const lv_style_t * style);
 
+#if LV_IMG_CACHE_ASYNC
+/**
+ * Initialize the queue of the images opened in the background
+ */
+void lv_img_cache_async_init(void);
+
+/**
+ * Get an image from the cache without waiting for it to open.
+ * If the image is not cached yet it's queued to be opened by `lv_img_cache_async_work` on a worker thread
+ * and `area` will be invalidated when it's ready.
+ * Images which are opened quickly (true color and alpha `lv_img_dsc_t` variables) are opened immediately.
+ * Should be called in `LV_DRAW_LOCK`.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param style style of the image
+ * @param area the area where the image is drawn (typically the clip area). Invalidated on the refreshing display.
+ * @param pending store `true` here if the image is being opened, `false` if it is opened or failed to open
+ * @return pointer to the cache entry or NULL if the image is not opened yet or can't be opened
+ */
+lv_img_cache_entry_t * lv_img_cache_open_async(const void * src, const lv_style_t * style, const lv_area_t * area,
+                                               bool * pending);
+
+/**
+ * Check whether an image can be drawn now, i.e. `lv_img_cache_open_async` won't defer it.
+ * Should be called in `LV_DRAW_LOCK`.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param style style of the image
+ * @return true: the image is cached or opened immediately; false: the image is not opened yet
+ */
+bool lv_img_cache_is_ready(const void * src, const lv_style_t * style);
+
+/**
+ * Open the next queued image and add it to the cache.
+ * Call it from a worker thread, e.g. in a loop with a short sleep if it returns `false`.
+ * The image is opened without holding the lock, so the rendering is not blocked meanwhile.
+ * The decoders and the file system drivers need to be thread-safe.
+ * @return true: an image was processed; false: there was nothing to open (or no free entry for it)
+ */
+bool lv_img_cache_async_work(void);
+#endif
+
 /**
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
@@ -60,10 +131,34 @@ lv_img_cache_entry_t * lv_img_cache_open(const void * src, const lv_style_t * st
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Set the max. size of the decoded images in the cache.
+ * If the new images don't fit the least recently used images are closed.
+ * The images opened in the current frame are not closed so the limit can be exceeded temporarily.
+ * @param size size in bytes. 0: no limit (only the number of images is limited)
+ */
+void lv_img_cache_set_mem_size(uint32_t size);
+
+/**
+ * Start a new frame. The images opened in the current frame are not closed to free memory.
+ * Call it before refreshing a display.
+ */
+void lv_img_cache_new_frame(void);
+
+/**
+ * Get the statistics of the image cache
+ * @param stats the statistics will be stored here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
+ * With `LV_IMG_CACHE_ASYNC` the queued requests are removed too, and if the worker thread is opening the image
+ * the result is dropped. The decoder reads `lv_img_dsc_t` variables while opening them so these are waited for
+ * (see `LV_IMG_CACHE_ASYNC_WAIT`), and the variable can be freed after this function.
  * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * `NULL` to invalidate all images.
  */
 void lv_img_cache_invalidate_src(const void * src);
 
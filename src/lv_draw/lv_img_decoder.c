@@ -12,6 +12,7 @@
 #include "../lv_misc/lv_ll.h"
 #include "../lv_misc/lv_color.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_math.h"
 
 #if defined(LV_GC_INCLUDE)
 #include LV_GC_INCLUDE
@@ -21,7 +22,7 @@
  *      DEFINES
  *********************/
 #define CF_BUILT_IN_FIRST LV_IMG_CF_TRUE_COLOR
-#define CF_BUILT_IN_LAST LV_IMG_CF_ALPHA_8BIT
+#define CF_BUILT_IN_LAST LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED
 
 /**********************
  *      TYPEDEFS
@@ -30,9 +31,16 @@ typedef struct
 {
 #if LV_USE_FILESYSTEM
     lv_fs_file_t * f;
+    /*The content of the file (without the header) if the file system driver could map it*/
+    const uint8_t * map;
+    uint32_t map_size;
 #endif
     lv_color_t * palette;
     lv_opa_t * opa;
+#if LV_IMG_DECODE_TO_NATIVE
+    /*The decoded image or the content of the file (without the header) for alpha only images*/
+    uint8_t * data;
+#endif
 } lv_img_decoder_built_in_data_t;
 
 /**********************
@@ -44,6 +52,22 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
                                                    lv_coord_t len, uint8_t * buf);
 static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                      lv_coord_t len, uint8_t * buf);
+static lv_res_t lv_img_decoder_built_in_line_rle(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                 lv_coord_t len, uint8_t * buf);
+#if LV_IMG_CF_RLE
+static lv_res_t rle_decode_line(const uint8_t * in, uint32_t in_size, uint8_t px_size, lv_coord_t x, lv_coord_t len,
+                                uint8_t * buf);
+static uint32_t rle_read_index(const uint8_t * p);
+#endif
+#if LV_IMG_CF_ALPHA || LV_IMG_CF_INDEXED || LV_IMG_CF_RLE
+static const uint8_t * lv_img_decoder_built_in_get_data(lv_img_decoder_dsc_t * dsc);
+#endif
+#if LV_USE_FILESYSTEM
+static bool map_check(const lv_img_header_t * header, const uint8_t * map, uint32_t map_size);
+#endif
+#if LV_IMG_DECODE_TO_NATIVE
+static void lv_img_decoder_built_in_to_native(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -142,9 +166,10 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, const
         res = d->info_cb(d, src, &dsc->header);
         if(res != LV_RES_OK) continue;
 
-        dsc->error_msg = NULL;
-        dsc->img_data  = NULL;
-        dsc->decoder   = d;
+        dsc->error_msg       = NULL;
+        dsc->img_data        = NULL;
+        dsc->img_data_mapped = false;
+        dsc->decoder         = d;
 
         res = d->open_cb(d, dsc);
 
@@ -349,6 +374,19 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 
         memcpy(user_data->f, &f, sizeof(f));
 
+        /*Use the content of the file directly if the driver can map it*/
+        const void * map;
+        uint32_t map_size;
+        if(lv_fs_map(user_data->f, &map, &map_size) == LV_FS_RES_OK && map_size > 4) {
+            /*Later the data is read from the mapping without checks so it must contain everything*/
+            if(map_check(&dsc->header, (const uint8_t *)map + 4, map_size - 4)) {
+                user_data->map      = (const uint8_t *)map + 4; /*Skip the header*/
+                user_data->map_size = map_size - 4;
+            } else {
+                LV_LOG_WARN("Built-in image decoder: the mapped file is too short or invalid. Read it with lv_fs_read.");
+            }
+        }
+
 #else
         LV_LOG_WARN("Image built-in decoder cannot read file because LV_USE_FILESYSTEM = 0");
         return LV_RES_INV;
@@ -369,8 +407,20 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             dsc->img_data = ((lv_img_dsc_t *)dsc->src)->data;
             return LV_RES_OK;
         } else {
+#if LV_USE_FILESYSTEM
+            /*Draw the mapped files as variables*/
+            lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+            if(user_data->map) {
+                dsc->img_data        = user_data->map;
+                dsc->img_data_mapped = true;
+                return LV_RES_OK;
+            }
+#endif
             /*If it's a file it need to be read line by line later*/
             dsc->img_data = NULL;
+#if LV_IMG_DECODE_TO_NATIVE
+            lv_img_decoder_built_in_to_native(decoder, dsc);
+#endif
             return LV_RES_OK;
         }
     }
@@ -402,7 +452,8 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 #endif
         }
 
-        if(dsc->src_type == LV_IMG_SRC_FILE) {
+        const uint8_t * data_tmp = lv_img_decoder_built_in_get_data(dsc);
+        if(data_tmp == NULL) {
             /*Read the palette from file*/
 #if LV_USE_FILESYSTEM
             lv_fs_seek(user_data->f, 4); /*Skip the header*/
@@ -418,8 +469,8 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             return LV_RES_INV;
 #endif
         } else {
-            /*The palette begins in the beginning of the image data. Just point to it.*/
-            lv_color32_t * palette_p = (lv_color32_t *)((lv_img_dsc_t *)dsc->src)->data;
+            /*The palette begins in the beginning of the image data (variable or mapped file). Just point to it.*/
+            lv_color32_t * palette_p = (lv_color32_t *)data_tmp;
 
 
             uint32_t i;
@@ -429,7 +480,18 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             }
         }
 
+#if LV_COLOR_PREMULT
+        /*The decoded pixels should be premultiplied*/
+        uint32_t i;
+        for(i = 0; i < palette_size; i++) {
+            user_data->palette[i] = lv_color_premult(user_data->palette[i], user_data->opa[i]);
+        }
+#endif
+
         dsc->img_data = NULL;
+#if LV_IMG_DECODE_TO_NATIVE
+        lv_img_decoder_built_in_to_native(decoder, dsc);
+#endif
         return LV_RES_OK;
 #else
         LV_LOG_WARN("Indexed (palette) images are not enabled in lv_conf.h. See LV_IMG_CF_INDEXED");
@@ -441,10 +503,28 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             cf == LV_IMG_CF_ALPHA_8BIT) {
 #if LV_IMG_CF_ALPHA
         dsc->img_data = NULL;
+#if LV_IMG_DECODE_TO_NATIVE
+        lv_img_decoder_built_in_to_native(decoder, dsc);
+#endif
         return LV_RES_OK; /*Nothing to process*/
 #else
         LV_LOG_WARN("Alpha indexed images are not enabled in lv_conf.h. See LV_IMG_CF_ALPHA");
         return LV_RES_INV;
+#endif
+    }
+    /*RLE compressed true color images. They are decompressed line by line.*/
+    else if(cf == LV_IMG_CF_RLE_TRUE_COLOR || cf == LV_IMG_CF_RLE_TRUE_COLOR_ALPHA ||
+            cf == LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED) {
+#if LV_IMG_CF_RLE
+        dsc->img_data = NULL;
+#if LV_IMG_DECODE_TO_NATIVE
+        lv_img_decoder_built_in_to_native(decoder, dsc);
+#endif
+        return LV_RES_OK;
+#else
+        lv_img_decoder_built_in_close(decoder, dsc);
+        LV_LOG_WARN("RLE compressed images are not enabled in lv_conf.h. See LV_IMG_CF_RLE");
+        return LV_RES_INV;
 #endif
     }
     /*Unknown format. Can't decode it.*/
@@ -489,6 +569,9 @@ lv_res_t lv_img_decoder_built_in_read_line(lv_img_decoder_t * decoder, lv_img_de
     } else if(dsc->header.cf == LV_IMG_CF_INDEXED_1BIT || dsc->header.cf == LV_IMG_CF_INDEXED_2BIT ||
               dsc->header.cf == LV_IMG_CF_INDEXED_4BIT || dsc->header.cf == LV_IMG_CF_INDEXED_8BIT) {
         res = lv_img_decoder_built_in_line_indexed(dsc, x, y, len, buf);
+    } else if(dsc->header.cf == LV_IMG_CF_RLE_TRUE_COLOR || dsc->header.cf == LV_IMG_CF_RLE_TRUE_COLOR_ALPHA ||
+              dsc->header.cf == LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED) {
+        res = lv_img_decoder_built_in_line_rle(dsc, x, y, len, buf);
     } else {
         LV_LOG_WARN("Built-in image decoder read not supports the color format");
         return LV_RES_INV;
@@ -516,6 +599,9 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
 #endif
         if(user_data->palette) lv_mem_free(user_data->palette);
         if(user_data->opa) lv_mem_free(user_data->opa);
+#if LV_IMG_DECODE_TO_NATIVE
+        if(user_data->data) lv_mem_free(user_data->data);
+#endif
 
         lv_mem_free(user_data);
 
@@ -626,11 +712,9 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
     uint8_t * fs_buf = lv_mem_buf_get(w);
 #endif
 
-    const uint8_t * data_tmp = NULL;
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        const lv_img_dsc_t * img_dsc = dsc->src;
-
-        data_tmp = img_dsc->data + ofs;
+    const uint8_t * data_tmp = lv_img_decoder_built_in_get_data(dsc);
+    if(data_tmp) {
+        data_tmp += ofs;
     } else {
 #if LV_USE_FILESYSTEM
         lv_fs_seek(user_data->f, ofs + 4); /*+4 to skip the header*/
@@ -648,8 +732,14 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
     for(i = 0; i < len; i++) {
         val_act = (data_tmp[byte_act] & (mask << pos)) >> pos;
 
+#if LV_COLOR_PREMULT
+        /*Premultiply the color with the alpha (`lv_color_premult` sets the alpha byte too)*/
+        lv_color_t * px = (lv_color_t *)&buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE];
+        *px = lv_color_premult(bg_color, dsc->header.cf == LV_IMG_CF_ALPHA_8BIT ? val_act : opa_table[val_act]);
+#else
         buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] =
             dsc->header.cf == LV_IMG_CF_ALPHA_8BIT ? val_act : opa_table[val_act];
+#endif
 
         pos -= px_size;
         if(pos < 0) {
@@ -714,10 +804,9 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
 #if LV_USE_FILESYSTEM
     uint8_t * fs_buf = lv_mem_buf_get(w);
 #endif
-    const uint8_t * data_tmp = NULL;
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        const lv_img_dsc_t * img_dsc = dsc->src;
-        data_tmp                     = img_dsc->data + ofs;
+    const uint8_t * data_tmp = lv_img_decoder_built_in_get_data(dsc);
+    if(data_tmp) {
+        data_tmp += ofs;
     } else {
 #if LV_USE_FILESYSTEM
         lv_fs_seek(user_data->f, ofs + 4); /*+4 to skip the header*/
@@ -764,3 +853,312 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
     return LV_RES_INV;
 #endif
 }
+
+static lv_res_t lv_img_decoder_built_in_line_rle(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                 lv_coord_t len, uint8_t * buf)
+{
+#if LV_IMG_CF_RLE
+    uint8_t px_size     = lv_img_cf_get_px_size(dsc->header.cf) >> 3;
+    uint32_t index_size = ((uint32_t)dsc->header.h + 1) * sizeof(uint32_t);
+    uint32_t row_start;
+    uint32_t row_end;
+    const uint8_t * row;
+
+#if LV_USE_FILESYSTEM
+    uint8_t * fs_buf = NULL;
+#endif
+    const uint8_t * data_tmp = lv_img_decoder_built_in_get_data(dsc);
+    if(data_tmp) {
+        row_start = rle_read_index(&data_tmp[y * sizeof(uint32_t)]);
+        row_end   = rle_read_index(&data_tmp[(y + 1) * sizeof(uint32_t)]);
+        row       = data_tmp + index_size + row_start;
+        if(row_end < row_start) {
+            LV_LOG_WARN("Built-in image decoder: invalid RLE row index");
+            return LV_RES_INV;
+        }
+    } else {
+#if LV_USE_FILESYSTEM
+        lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+        uint8_t index[2 * sizeof(uint32_t)];
+        uint32_t br = 0;
+        lv_fs_seek(user_data->f, y * sizeof(uint32_t) + 4); /*+4 to skip the header*/
+        lv_fs_read(user_data->f, index, sizeof(index), &br);
+        if(br != sizeof(index)) {
+            LV_LOG_WARN("Built-in image decoder read failed");
+            return LV_RES_INV;
+        }
+
+        row_start = rle_read_index(&index[0]);
+        row_end   = rle_read_index(&index[sizeof(uint32_t)]);
+
+        /*A row can't be longer than if all its pixels were literals*/
+        uint32_t row_max = (uint32_t)dsc->header.w * px_size + (dsc->header.w + 127) / 128;
+        if(row_end < row_start || row_end - row_start > row_max) {
+            LV_LOG_WARN("Built-in image decoder: invalid RLE row index");
+            return LV_RES_INV;
+        }
+
+        fs_buf = lv_mem_buf_get(row_end - row_start);
+        lv_fs_seek(user_data->f, index_size + row_start + 4);
+        lv_fs_read(user_data->f, fs_buf, row_end - row_start, &br);
+        if(br != row_end - row_start) {
+            LV_LOG_WARN("Built-in image decoder read failed");
+            lv_mem_buf_release(fs_buf);
+            return LV_RES_INV;
+        }
+        row = fs_buf;
+#else
+        LV_LOG_WARN("Image built-in RLE line reader can't read file because LV_USE_FILESYSTEM = 0");
+        return LV_RES_INV;
+#endif
+    }
+
+    lv_res_t res = rle_decode_line(row, row_end - row_start, px_size, x, len, buf);
+    if(res != LV_RES_OK) LV_LOG_WARN("Built-in image decoder: invalid RLE data");
+
+#if LV_USE_FILESYSTEM
+    if(fs_buf) lv_mem_buf_release(fs_buf);
+#endif
+    return res;
+#else
+    LV_LOG_WARN("Image built-in RLE line reader failed because LV_IMG_CF_RLE is 0 in lv_conf.h");
+    return LV_RES_INV;
+#endif
+}
+
+#if LV_IMG_CF_RLE
+/**
+ * Decompress `len` pixels of an RLE compressed row starting from `x`.
+ * The row is a series of packets. The first byte of a packet tells its type and length:
+ * - `0x80 | (n - 1)`: a run. `n` times the pixel stored after the byte
+ * - `n - 1`: literals. `n` different pixels stored after the byte
+ * @param in pointer to the first packet of the row
+ * @param in_size size of the compressed row in bytes
+ * @param px_size size of a pixel in bytes
+ * @param x index of the first pixel to decompress
+ * @param len number of pixels to decompress
+ * @param buf store the decompressed pixels here
+ * @return LV_RES_OK: ok; LV_RES_INV: the data ended before `x + len` pixels
+ */
+static lv_res_t rle_decode_line(const uint8_t * in, uint32_t in_size, uint8_t px_size, lv_coord_t x, lv_coord_t len,
+                                uint8_t * buf)
+{
+    const uint8_t * in_end = in + in_size;
+    uint32_t skip = x;
+    uint32_t left = len;
+
+    while(left > 0) {
+        if(in >= in_end) return LV_RES_INV;
+
+        uint8_t ctrl = *in;
+        in++;
+        bool run = ctrl & 0x80 ? true : false;
+        uint32_t cnt = (ctrl & 0x7F) + 1;
+        uint32_t data_size = run ? px_size : cnt * px_size;
+        if((uint32_t)(in_end - in) < data_size) return LV_RES_INV;
+
+        /*The packet is before the first required pixel*/
+        if(skip >= cnt) {
+            skip -= cnt;
+            in += data_size;
+            continue;
+        }
+
+        uint32_t n = LV_MATH_MIN(cnt - skip, left);
+        if(run) {
+            uint32_t i;
+            for(i = 0; i < n; i++) {
+                memcpy(buf, in, px_size);
+                buf += px_size;
+            }
+        } else {
+            memcpy(buf, in + skip * px_size, n * px_size);
+            buf += n * px_size;
+        }
+
+        in += data_size;
+        left -= n;
+        skip = 0;
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Read an item of the row index of an RLE compressed image.
+ * The index is stored in little endian and might be unaligned.
+ * @param p pointer to the item
+ * @return the offset of a row
+ */
+static uint32_t rle_read_index(const uint8_t * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+#endif
+
+#if LV_USE_FILESYSTEM
+/**
+ * Check if the mapped content of a file contains all the data of an image
+ * @param header header of the image
+ * @param map the content of the file after the header
+ * @param map_size size of `map` in bytes
+ * @return true: every palette item and line (and RLE row) is inside `map`; false: the file is too short or invalid
+ */
+static bool map_check(const lv_img_header_t * header, const uint8_t * map, uint32_t map_size)
+{
+    lv_img_cf_t cf = header->cf;
+    if(cf == LV_IMG_CF_RLE_TRUE_COLOR || cf == LV_IMG_CF_RLE_TRUE_COLOR_ALPHA ||
+       cf == LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED) {
+#if LV_IMG_CF_RLE
+        /*The row index needs to be in the mapping and the rows need to follow each other until its end*/
+        uint32_t index_size = ((uint32_t)header->h + 1) * sizeof(uint32_t);
+        if(map_size < index_size) return false;
+
+        uint32_t ofs_prev = 0;
+        uint32_t y;
+        for(y = 0; y <= header->h; y++) {
+            uint32_t ofs = rle_read_index(&map[y * sizeof(uint32_t)]);
+            if(ofs < ofs_prev) return false;
+            ofs_prev = ofs;
+        }
+        return ofs_prev <= map_size - index_size;
+#else
+        return false;
+#endif
+    }
+
+    /*The palette of the indexed images is followed by the lines. Every line starts on a new byte.*/
+    uint8_t px_size       = lv_img_cf_get_px_size(cf);
+    uint32_t palette_size = 0;
+    if(cf == LV_IMG_CF_INDEXED_1BIT || cf == LV_IMG_CF_INDEXED_2BIT || cf == LV_IMG_CF_INDEXED_4BIT ||
+       cf == LV_IMG_CF_INDEXED_8BIT) {
+        palette_size = (1 << px_size) * sizeof(lv_color32_t);
+    }
+
+    uint32_t line_size = ((uint32_t)header->w * px_size + 7) >> 3;
+    return palette_size + line_size * header->h <= map_size;
+}
+#endif
+
+#if LV_IMG_CF_ALPHA || LV_IMG_CF_INDEXED || LV_IMG_CF_RLE
+/**
+ * Get the data of a built-in image if it's in the memory
+ * @param dsc pointer to decoder descriptor
+ * @return pointer to the data after the header (the palette, the row index or the pixels) or NULL if the image
+ * needs to be read from a file
+ */
+static const uint8_t * lv_img_decoder_built_in_get_data(lv_img_decoder_dsc_t * dsc)
+{
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
+        const lv_img_dsc_t * img_dsc = dsc->src;
+        return img_dsc->data;
+    }
+
+#if LV_USE_FILESYSTEM
+    /*Mapped files or files loaded into the memory*/
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+    if(user_data) {
+        if(user_data->map) return user_data->map;
+#if LV_IMG_DECODE_TO_NATIVE
+        if(user_data->data) return user_data->data;
+#endif
+    }
+#endif
+
+    return NULL;
+}
+#endif
+
+#if LV_IMG_DECODE_TO_NATIVE
+/**
+ * Convert a just opened image to the native color format to draw it without decoding lines later.
+ * - files are read into the memory and closed
+ * - true color images from files are used directly
+ * - indexed images are converted to `LV_IMG_CF_TRUE_COLOR_ALPHA`
+ * - RLE compressed images are decompressed to the matching true color format
+ * - alpha only images are kept as they are because their color comes from the style
+ * If there is not enough memory the image remains in its original form.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor of an opened image
+ */
+static void lv_img_decoder_built_in_to_native(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    lv_img_cf_t cf = dsc->header.cf;
+    bool indexed = (cf >= LV_IMG_CF_INDEXED_1BIT && cf <= LV_IMG_CF_INDEXED_8BIT) ? true : false;
+    bool rle = (cf >= LV_IMG_CF_RLE_TRUE_COLOR && cf <= LV_IMG_CF_RLE_TRUE_COLOR_CHROMA_KEYED) ? true : false;
+
+    /*Nothing to do with variables which are not encoded*/
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE && indexed == false && rle == false) return;
+
+    /*Compressed variables have no user data yet*/
+    if(dsc->user_data == NULL) {
+        dsc->user_data = lv_mem_alloc(sizeof(lv_img_decoder_built_in_data_t));
+        if(dsc->user_data == NULL) return;
+        memset(dsc->user_data, 0, sizeof(lv_img_decoder_built_in_data_t));
+    }
+    lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+
+#if LV_USE_FILESYSTEM
+    /*Read the whole file to the memory if it's not mapped*/
+    if(dsc->src_type == LV_IMG_SRC_FILE && user_data->map == NULL) {
+        uint32_t size = 0;
+        lv_fs_size(user_data->f, &size);
+        if(size <= 4) return;
+        size -= 4;  /*Skip the header*/
+
+        uint8_t * data = lv_mem_alloc(size);
+        if(data == NULL) {
+            LV_LOG_INFO("Built-in image decoder: no memory to load the file. Read it line by line.");
+            return;
+        }
+
+        uint32_t br = 0;
+        lv_fs_seek(user_data->f, 4);
+        lv_fs_read(user_data->f, data, size, &br);
+        if(br != size) {
+            LV_LOG_WARN("Built-in image decoder: can't read the file");
+            lv_mem_free(data);
+            return;
+        }
+
+        /*The file is not required anymore*/
+        lv_fs_close(user_data->f);
+        lv_mem_free(user_data->f);
+        user_data->f = NULL;
+        user_data->data = data;
+
+        /*The pixels of true color images are already in the native format*/
+        if(cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_TRUE_COLOR_ALPHA || cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
+            dsc->img_data = user_data->data;
+            return;
+        }
+    }
+#endif
+
+    if(indexed == false && rle == false) return;
+
+    /*Decode all the lines of indexed and compressed images*/
+    lv_img_cf_t native_cf = indexed ? LV_IMG_CF_TRUE_COLOR_ALPHA : cf - LV_IMG_CF_RLE_TRUE_COLOR + LV_IMG_CF_TRUE_COLOR;
+    uint32_t line_size = ((uint32_t)dsc->header.w * lv_img_cf_get_px_size(native_cf)) >> 3;
+    uint8_t * native = lv_mem_alloc(line_size * dsc->header.h);
+    if(native == NULL) {
+        LV_LOG_INFO("Built-in image decoder: no memory to decode the image. Decode it line by line.");
+        return;
+    }
+
+    lv_coord_t y;
+    for(y = 0; y < dsc->header.h; y++) {
+        lv_res_t res = lv_img_decoder_built_in_read_line(decoder, dsc, 0, y, dsc->header.w, &native[y * line_size]);
+        if(res != LV_RES_OK) {
+            lv_mem_free(native);
+            return;
+        }
+    }
+
+    /*Only the decoded image is required*/
+    if(user_data->data) lv_mem_free(user_data->data);
+    user_data->data = native;
+    dsc->img_data = native;
+    dsc->header.cf = native_cf;
+}
+#endif
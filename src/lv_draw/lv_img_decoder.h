@@ -118,6 +118,10 @@ typedef struct _lv_img_decoder_dsc
      *  MUST be set in `open` function*/
     const uint8_t * img_data;
 
+    /** `img_data` is not allocated for the image but points to existing data (e.g. a memory mapped file).
+     *  Such images don't use memory in the image cache. Can be set in `open` function*/
+    bool img_data_mapped;
+
     /** How much time did it take to open the image. [ms]
      *  If not set `lv_img_cache` will measure and set the time to open*/
     uint32_t time_to_open;
@@ -49,12 +49,12 @@ static uint8_t rle_next(void);
  *  STATIC VARIABLES
  **********************/
 
-static uint32_t rle_rdp;
-static const uint8_t * rle_in;
-static uint8_t rle_bpp;
-static uint8_t rle_prev_v;
-static uint8_t rle_cnt;
-static rle_state_t rle_state;
+static LV_THREAD_LOCAL uint32_t rle_rdp;
+static LV_THREAD_LOCAL const uint8_t * rle_in;
+static LV_THREAD_LOCAL uint8_t rle_bpp;
+static LV_THREAD_LOCAL uint8_t rle_prev_v;
+static LV_THREAD_LOCAL uint8_t rle_cnt;
+static LV_THREAD_LOCAL rle_state_t rle_state;
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -90,7 +90,7 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     /*Handle compressed bitmap*/
     else
     {
-        static uint8_t * buf = NULL;
+        static LV_THREAD_LOCAL uint8_t * buf = NULL;
 
         uint32_t gsize = gdsc->box_w * gdsc->box_h;
         if(gsize == 0) return NULL;
@@ -177,8 +177,10 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
-    /*Check the cache first*/
+#if LV_USE_PARALLEL_DRAW == 0
+    /*Check the cache first. (It's shared by the drawing threads so can't be used with parallel drawing)*/
     if(letter == fdsc->last_letter) return fdsc->last_glyph_id;
+#endif
 
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
@@ -214,14 +216,18 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             }
         }
 
+#if LV_USE_PARALLEL_DRAW == 0
         /*Update the cache*/
         fdsc->last_letter = letter;
         fdsc->last_glyph_id = glyph_id;
+#endif
         return glyph_id;
     }
 
+#if LV_USE_PARALLEL_DRAW == 0
     fdsc->last_letter = letter;
     fdsc->last_glyph_id = 0;
+#endif
     return 0;
 
 }
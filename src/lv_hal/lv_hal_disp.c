@@ -33,6 +33,9 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#ifndef LV_ATOMIC_XCHG_U8
+static uint8_t xchg_u8(volatile uint8_t * p, uint8_t v);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -42,6 +45,12 @@ static lv_disp_t * disp_def;
 /**********************
  *      MACROS
  **********************/
+/*Set `flushing` and return its old value*/
+#ifdef LV_ATOMIC_XCHG_U8
+#define FLUSHING_XCHG(vdb, v) LV_ATOMIC_XCHG_U8(&(vdb)->flushing, v)
+#else
+#define FLUSHING_XCHG(vdb, v) xchg_u8(&(vdb)->flushing, v)
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -81,7 +90,23 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
     driver->user_data = NULL;
 #endif
 
-    driver->set_px_cb = NULL;
+    driver->set_px_cb  = NULL;
+    driver->wait_cb    = NULL;
+    driver->buf_age_cb = NULL;
+
+#if LV_USE_VSYNC
+    driver->vsync_ext    = 0;
+    driver->vsync_period = LV_DISP_DEF_REFR_PERIOD;
+#endif
+
+#if LV_USE_PARALLEL_DRAW
+    driver->parallel_cb = NULL;
+    driver->slice_cnt   = 1;
+#endif
+
+#if LV_USE_DRAW_BACKEND
+    driver->draw_backend = NULL;
+#endif
 }
 
 /**
@@ -107,6 +132,38 @@ void lv_disp_buf_init(lv_disp_buf_t * disp_buf, void * buf1, void * buf2, uint32
     disp_buf->buf2    = buf2;
     disp_buf->buf_act = disp_buf->buf1;
     disp_buf->size    = size_in_px_cnt;
+    disp_buf->front_id = LV_DISP_BUF_FRONT_NONE;
+
+    disp_buf->slot[0].buf = buf1;
+    disp_buf->buf_cnt     = 1;
+    if(buf2) {
+        disp_buf->slot[1].buf = buf2;
+        disp_buf->buf_cnt     = 2;
+    }
+}
+
+/**
+ * Add one more buffer to an initialized display buffer.
+ * With more buffers more rendered parts can wait for flushing while the next part is being rendered.
+ * Useful if the flushing time varies.
+ * @param disp_buf pointer to an initialized `lv_disp_buf_t` variable
+ * @param buf a buffer with the same size as `buf1` given in `lv_disp_buf_init()`
+ * @return true: the buffer is added; false: `LV_DISP_BUF_MAX_NUM` buffers are already added
+ */
+bool lv_disp_buf_add(lv_disp_buf_t * disp_buf, void * buf)
+{
+    if(disp_buf->buf_cnt >= LV_DISP_BUF_MAX_NUM) {
+        LV_LOG_WARN("lv_disp_buf_add: no more buffers can be added. Increase LV_DISP_BUF_MAX_NUM.");
+        return false;
+    }
+
+    /*Keep `buf2` meaningful for the double buffered checks*/
+    if(disp_buf->buf_cnt == 1) disp_buf->buf2 = buf;
+
+    disp_buf->slot[disp_buf->buf_cnt].buf = buf;
+    disp_buf->buf_cnt++;
+
+    return true;
 }
 
 /**
@@ -124,8 +181,8 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
     }
 
     memcpy(&disp->driver, driver, sizeof(lv_disp_drv_t));
-    memset(&disp->inv_area_joined, 0, sizeof(disp->inv_area_joined));
     memset(&disp->inv_areas, 0, sizeof(disp->inv_areas));
+    memset(&disp->inv_history_cnt, 0, sizeof(disp->inv_history_cnt));
     lv_ll_init(&disp->scr_ll, sizeof(lv_obj_t));
 
     if(disp_def == NULL) disp_def = disp;
@@ -141,6 +198,19 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
     disp->inv_p = 0;
     disp->last_activity_time = 0;
 
+#if LV_USE_VSYNC
+    disp->vsync_cnt   = 0;
+    disp->vsync_last  = 0;
+    disp->vsync_frame = 0;
+    disp->vsync_time  = lv_tick_get();
+    disp->fast_cnt    = 0;
+    memset(&disp->frame_stat, 0, sizeof(disp->frame_stat));
+    disp->frame_stat.interval = 1;
+
+    /*The refresh task polls the vsyncs and renders only if a new frame is due*/
+    lv_task_set_period(disp->refr_task, 1);
+#endif
+
     disp->act_scr   = lv_obj_create(NULL, NULL); /*Create a default screen on the display*/
     disp->top_layer = lv_obj_create(NULL, NULL); /*Create top layer on the display*/
     disp->sys_layer = lv_obj_create(NULL, NULL); /*Create sys layer on the display*/
@@ -165,6 +235,13 @@ void lv_disp_drv_update(lv_disp_t * disp, lv_disp_drv_t * new_drv)
 {
     memcpy(&disp->driver, new_drv, sizeof(lv_disp_drv_t));
 
+    /*The content of the buffers is unknown for the new driver*/
+    uint8_t i;
+    for(i = 0; i < disp->driver.buffer->buf_cnt; i++) {
+        disp->driver.buffer->slot[i].age = 0;
+    }
+    memset(&disp->inv_history_cnt, 0, sizeof(disp->inv_history_cnt));
+
     lv_obj_t * scr;
     LV_LL_READ(disp->scr_ll, scr)
     {
@@ -263,21 +340,97 @@ bool lv_disp_get_antialiasing(lv_disp_t * disp)
 }
 
 /**
- * Call in the display driver's `flush_cb` function when the flushing is finished
+ * Call in the display driver's `flush_cb` function when the flushing is finished.
+ * Can be called from an interrupt or an other thread.
+ * If the next part is already rendered `flush_cb` is called from here to start flushing it.
  * @param disp_drv pointer to display driver in `flush_cb` where this function is called
  */
 LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv)
 {
+    lv_disp_buf_t * vdb = disp_drv->buffer;
+    if(vdb->flushing == 0) return;
+
+    lv_disp_buf_slot_t * slot = &vdb->slot[vdb->flush_id];
+
     /*If the screen is transparent initialize it when the flushing is ready*/
 #if LV_COLOR_SCREEN_TRANSP
     if(disp_drv->screen_transp) {
-        memset(disp_drv->buffer->buf_act, 0x00, disp_drv->buffer->size * sizeof(lv_color32_t));
+        memset(slot->buf, 0x00, vdb->size * sizeof(lv_color32_t));
+        slot->age = 0;
     }
 #endif
 
-    disp_drv->buffer->flushing = 0;
+    /*The buffer can be rendered again*/
+    slot->queued = 0;
+
+    /*With screen sized buffers the flushed buffer is displayed now (and the previous one is free)*/
+    vdb->front_id = vdb->flush_id;
+
+    vdb->flush_id++;
+    if(vdb->flush_id >= vdb->buf_cnt) vdb->flush_id = 0;
+
+    FLUSHING_XCHG(vdb, 0);
+
+    /*Don't wait for the refresher if the next part is already rendered*/
+    lv_disp_flush_next(disp_drv);
 }
 
+/**
+ * Start flushing the next rendered part if the display is not busy with an other one.
+ * Called by the library when a new part is rendered and by `lv_disp_flush_ready()`.
+ * @param disp_drv pointer to display driver
+ */
+LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_next(lv_disp_drv_t * disp_drv)
+{
+    lv_disp_buf_t * vdb = disp_drv->buffer;
+    lv_disp_buf_slot_t * slot;
+
+    /*The refresher and `lv_disp_flush_ready` (in an interrupt or an other thread) can get here at the same time.
+     *Only the one which sets `flushing` starts the flush.*/
+    while(1) {
+        if(FLUSHING_XCHG(vdb, 1)) return;
+
+        slot = &vdb->slot[vdb->flush_id];
+        if(slot->queued) break;
+
+        /*Nothing to flush. If a part was queued meanwhile its `lv_disp_flush_next` saw `flushing` set
+         *so check it again after releasing.*/
+        FLUSHING_XCHG(vdb, 0);
+        if(slot->queued == 0) return;
+    }
+
+    if(disp_drv->flush_cb) disp_drv->flush_cb(disp_drv, &slot->area, slot->buf);
+    else lv_disp_flush_ready(disp_drv);
+}
+
+#if LV_USE_VSYNC
+/**
+ * Call on every vertical blanking of the display if `disp_drv.vsync_ext` is set.
+ * Can be called from an interrupt.
+ * @param disp pointer to a display
+ */
+LV_ATTRIBUTE_FLUSH_READY void lv_disp_vsync(lv_disp_t * disp)
+{
+    disp->vsync_cnt++;
+}
+
+/**
+ * Get statistics about the frames rendered on vsync
+ * @param disp pointer to a display (NULL to use the default display)
+ * @param stat store the statistics here
+ */
+void lv_disp_get_frame_stat(lv_disp_t * disp, lv_disp_frame_stat_t * stat)
+{
+    if(disp == NULL) disp = lv_disp_get_default();
+    if(disp == NULL) {
+        memset(stat, 0, sizeof(lv_disp_frame_stat_t));
+        return;
+    }
+
+    memcpy(stat, &disp->frame_stat, sizeof(lv_disp_frame_stat_t));
+}
+#endif
+
 /**
  * Get the next display.
  * @param disp pointer to the current display. NULL to initialize.
@@ -337,8 +490,8 @@ bool lv_disp_is_double_buf(lv_disp_t * disp)
 }
 
 /**
- * Check the driver configuration if it's TRUE double buffered (both `buf1` and `buf2` are set and
- * `size` is screen sized)
+ * Check the driver configuration if it's TRUE double buffered (both `buf1` and `buf2` are set
+ * and `size` is screen sized). Further buffers added with `lv_disp_buf_add()` are screen sized too.
  * @param disp pointer to to display to check
  * @return true: double buffered; false: not double buffered
  */
@@ -356,3 +509,18 @@ bool lv_disp_is_true_double_buf(lv_disp_t * disp)
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#ifndef LV_ATOMIC_XCHG_U8
+/**
+ * Exchange a value. Not atomic: used only if `LV_ATOMIC_XCHG_U8` is not available.
+ * @param p pointer to the value
+ * @param v the new value
+ * @return the old value
+ */
+static uint8_t xchg_u8(volatile uint8_t * p, uint8_t v)
+{
+    uint8_t old = *p;
+    *p = v;
+    return old;
+}
+#endif
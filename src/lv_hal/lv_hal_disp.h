@@ -30,6 +30,16 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas */
 #endif
 
+#ifndef LV_INV_HISTORY_SIZE
+#define LV_INV_HISTORY_SIZE 8 /*Max. number of areas to remember from a frame for screen sized buffers*/
+#endif
+
+#define LV_DISP_BUF_FRONT_NONE 0xFF
+
+#if LV_DISP_BUF_MAX_NUM < 2
+#error "LV_DISP_BUF_MAX_NUM should be at least 2 (for `buf1` and `buf2`)"
+#endif
+
 #ifndef LV_ATTRIBUTE_FLUSH_READY
 #define LV_ATTRIBUTE_FLUSH_READY
 #endif
@@ -40,6 +50,18 @@ extern "C" {
 
 struct _disp_t;
 struct _disp_drv_t;
+struct _lv_draw_backend_t;
+
+/**
+ * A buffer of the flush pipeline and the area rendered into it.
+ */
+typedef struct
+{
+    void * buf;                 /*The buffer itself*/
+    lv_area_t area;             /*Area rendered into the buffer*/
+    volatile uint8_t queued;    /*1: rendered and waiting for or being under flushing*/
+    uint8_t age;                /*Screen sized buffers: number of frames since the buffer was rendered. 0: unknown*/
+} lv_disp_buf_slot_t;
 
 /**
  * Structure for holding display buffer information.
@@ -53,9 +75,28 @@ typedef struct
     void * buf_act;
     uint32_t size; /*In pixel count*/
     lv_area_t area;
-    volatile uint32_t flushing : 1;
+    volatile uint8_t flushing;  /*1: a part is being flushed. Set with `LV_ATOMIC_XCHG_U8`.*/
+
+    lv_disp_buf_slot_t slot[LV_DISP_BUF_MAX_NUM]; /*The buffers in the order of rendering and flushing*/
+    uint8_t buf_cnt;            /*Number of buffers in `slot`*/
+    uint8_t buf_act_id;         /*Index of `buf_act` in `slot`*/
+    volatile uint8_t flush_id;  /*Index of the slot being flushed or flushed next*/
+    volatile uint8_t front_id;  /*Screen sized buffers: index of the slot being displayed*/
 } lv_disp_buf_t;
 
+#if LV_USE_VSYNC
+/**
+ * Statistics about the frames rendered in sync with vsync
+ */
+typedef struct
+{
+    uint32_t frame_cnt;     /*Number of rendered frames*/
+    uint32_t miss_cnt;      /*Number of frames which were not ready until their deadline (the next frame's vsync)*/
+    uint32_t render_time;   /*Time of rendering the last frame [ms]*/
+    uint8_t interval;       /*Current number of vsyncs per frame. Increased if the frames miss their deadline.*/
+} lv_disp_frame_stat_t;
+#endif
+
 /**
  * Display Driver structure to be registered by HAL
  */
@@ -80,8 +121,18 @@ typedef struct _disp_drv_t
     uint32_t screen_transp : 1;
 #endif
 
+#if LV_USE_VSYNC
+    /**1: the driver calls `lv_disp_vsync()` on every vertical blanking; 0: simulate vsync with `vsync_period`*/
+    uint32_t vsync_ext : 1;
+
+    /**Time between two vsyncs [ms]. Used to simulate vsync and to calculate the frames' deadline.*/
+    uint16_t vsync_period;
+#endif
+
     /** MANDATORY: Write the internal buffer (VDB) to the display. 'lv_disp_flush_ready()' has to be
-     * called when finished */
+     * called when finished.
+     * If an other part is already rendered it's called from `lv_disp_flush_ready()`,
+     * i.e. from the interrupt or thread where the flushing is finished.*/
     void (*flush_cb)(struct _disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
 
     /** OPTIONAL: Extend the invalidated areas to match with the display drivers requirements
@@ -98,6 +149,31 @@ typedef struct _disp_drv_t
      * number of flushed pixels */
     void (*monitor_cb)(struct _disp_drv_t * disp_drv, uint32_t time, uint32_t px);
 
+    /** OPTIONAL: Called periodically while LittlevGL waits for a buffer to be flushed.
+     * Sleep or yield the task here instead of busy waiting for `lv_disp_flush_ready()`*/
+    void (*wait_cb)(struct _disp_drv_t * disp_drv);
+
+    /** OPTIONAL: With screen sized buffers tell how many frames ago `buf` was rendered (e.g. EGL buffer age).
+     * Return 0 if its content is unknown to redraw the whole screen.
+     * If not set LittlevGL counts the age of the buffers itself.*/
+    uint8_t (*buf_age_cb)(struct _disp_drv_t * disp_drv, void * buf);
+
+#if LV_USE_PARALLEL_DRAW
+    /** OPTIONAL: Call `job_cb` with every element of `slices` in parallel (e.g. on a thread pool)
+     * and return when all of them are ready. */
+    void (*parallel_cb)(struct _disp_drv_t * disp_drv, void (*job_cb)(const lv_area_t * slice),
+                        const lv_area_t * slices, uint16_t slice_cnt);
+
+    /** Number of horizontal slices to render in parallel with `parallel_cb`. (E.g. number of CPU cores)*/
+    uint8_t slice_cnt;
+#endif
+
+#if LV_USE_DRAW_BACKEND
+    /** OPTIONAL: Draw rectangles, images, labels, lines and arcs with this backend (e.g. a GPU).
+     * The drawings are recorded and executed band by band. See `lv_draw_backend.h`*/
+    struct _lv_draw_backend_t * draw_backend;
+#endif
+
 #if LV_USE_GPU
     /** OPTIONAL: Blend two memories using opacity (GPU only)*/
     void (*gpu_blend_cb)(struct _disp_drv_t * disp_drv, lv_color_t * dest, const lv_color_t * src, uint32_t length,
@@ -138,11 +214,24 @@ typedef struct _disp_t
     struct _lv_obj_t * top_layer; /**< @see lv_disp_get_layer_top */
     struct _lv_obj_t * sys_layer; /**< @see lv_disp_get_layer_sys */
 
-    /** Invalidated (marked to redraw) areas*/
+    /** Invalidated (marked to redraw) areas. They are made disjoint before refreshing.*/
     lv_area_t inv_areas[LV_INV_BUF_SIZE];
-    uint8_t inv_area_joined[LV_INV_BUF_SIZE];
     uint32_t inv_p : 10;
 
+    /** The refreshed areas of the last frames with screen sized buffers.
+     * `[0]` is the last frame. Used to bring older buffers up to date.*/
+    lv_area_t inv_history[LV_DISP_BUF_MAX_NUM - 1][LV_INV_HISTORY_SIZE];
+    uint8_t inv_history_cnt[LV_DISP_BUF_MAX_NUM - 1];
+
+#if LV_USE_VSYNC
+    volatile uint32_t vsync_cnt; /**< Number of vsyncs (signaled by the driver or simulated)*/
+    uint32_t vsync_last;         /**< `vsync_cnt` when the refresh task last checked it*/
+    uint32_t vsync_frame;        /**< `vsync_cnt` when the last frame was rendered*/
+    uint32_t vsync_time;         /**< Time of the last simulated vsync*/
+    uint8_t fast_cnt;            /**< Number of frames in a row which were fast enough for a shorter interval*/
+    lv_disp_frame_stat_t frame_stat;
+#endif
+
     /*Miscellaneous data*/
     uint32_t last_activity_time; /**< Last time there was activity on this display */
 } lv_disp_t;
@@ -176,6 +265,16 @@ void lv_disp_drv_init(lv_disp_drv_t * driver);
  */
 void lv_disp_buf_init(lv_disp_buf_t * disp_buf, void * buf1, void * buf2, uint32_t size_in_px_cnt);
 
+/**
+ * Add one more buffer to an initialized display buffer.
+ * With more buffers more rendered parts can wait for flushing while the next part is being rendered.
+ * Useful if the flushing time varies.
+ * @param disp_buf pointer to an initialized `lv_disp_buf_t` variable
+ * @param buf a buffer with the same size as `buf1` given in `lv_disp_buf_init()`
+ * @return true: the buffer is added; false: `LV_DISP_BUF_MAX_NUM` buffers are already added
+ */
+bool lv_disp_buf_add(lv_disp_buf_t * disp_buf, void * buf);
+
 /**
  * Register an initialized display driver.
  * Automatically set the first display as active.
@@ -233,13 +332,38 @@ bool lv_disp_get_antialiasing(lv_disp_t * disp);
 //! @cond Doxygen_Suppress
 
 /**
- * Call in the display driver's `flush_cb` function when the flushing is finished
+ * Call in the display driver's `flush_cb` function when the flushing is finished.
+ * Can be called from an interrupt or an other thread.
+ * If the next part is already rendered `flush_cb` is called from here to start flushing it.
  * @param disp_drv pointer to display driver in `flush_cb` where this function is called
  */
 LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv);
 
+/**
+ * Start flushing the next rendered part if the display is not busy with an other one.
+ * Called by the library when a new part is rendered and by `lv_disp_flush_ready()`.
+ * @param disp_drv pointer to display driver
+ */
+LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_next(lv_disp_drv_t * disp_drv);
+
 //! @endcond
 
+#if LV_USE_VSYNC
+/**
+ * Call on every vertical blanking of the display if `disp_drv.vsync_ext` is set.
+ * Can be called from an interrupt.
+ * @param disp pointer to a display
+ */
+LV_ATTRIBUTE_FLUSH_READY void lv_disp_vsync(lv_disp_t * disp);
+
+/**
+ * Get statistics about the frames rendered on vsync
+ * @param disp pointer to a display (NULL to use the default display)
+ * @param stat store the statistics here
+ */
+void lv_disp_get_frame_stat(lv_disp_t * disp, lv_disp_frame_stat_t * stat);
+#endif
+
 /**
  * Get the next display.
  * @param disp pointer to the current display. NULL to initialize.
@@ -274,8 +398,8 @@ void lv_disp_pop_from_inv_buf(lv_disp_t * disp, uint16_t num);
 bool lv_disp_is_double_buf(lv_disp_t * disp);
 
 /**
- * Check the driver configuration if it's TRUE double buffered (both `buf1` and `buf2` are set and
- * `size` is screen sized)
+ * Check the driver configuration if it's TRUE double buffered (both `buf1` and `buf2` are set
+ * and `size` is screen sized). Further buffers added with `lv_disp_buf_add()` are screen sized too.
  * @param disp pointer to to display to check
  * @return true: double buffered; false: not double buffered
  */
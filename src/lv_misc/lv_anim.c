@@ -44,7 +44,9 @@ static bool anim_ready_handler(lv_anim_t * a);
  **********************/
 static uint32_t last_task_run;
 static bool anim_list_changed;
-static lv_task_t * _lv_anim_task;
+#if LV_USE_VSYNC == 0
+static lv_task_t * _lv_anim_task; /*With vsync the animations are evaluated by the displays' refresh tasks*/
+#endif
 
 /**********************
  *      MACROS
@@ -61,7 +63,9 @@ void lv_anim_core_init(void)
 {
     lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
     last_task_run = lv_tick_get();
+#if LV_USE_VSYNC == 0
     _lv_anim_task = lv_task_create(anim_task, LV_DISP_DEF_REFR_PERIOD, LV_ANIM_TASK_PRIO, NULL);
+#endif
 	anim_mark_list_change(); /*Turn off the animation task*/
 	anim_list_changed = false; /*The list has not actaully changed*/
 }
@@ -496,9 +500,12 @@ static bool anim_ready_handler(lv_anim_t * a)
 static void anim_mark_list_change(void)
 {
 	anim_list_changed = true;
+
+#if LV_USE_VSYNC == 0
 	if(lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL)
 		lv_task_set_prio(_lv_anim_task, LV_TASK_PRIO_OFF);
 	else
 		lv_task_set_prio(_lv_anim_task, LV_ANIM_TASK_PRIO);
+#endif
 }
 #endif
@@ -24,6 +24,10 @@ extern "C" {
 #error "LV_COLOR_SCREEN_TRANSP requires LV_COLOR_DEPTH == 32. Set it in lv_conf.h"
 #endif
 
+#if LV_COLOR_PREMULT != 0 && LV_COLOR_SCREEN_TRANSP == 0
+#error "LV_COLOR_PREMULT requires LV_COLOR_SCREEN_TRANSP == 1. Set it in lv_conf.h"
+#endif
+
 #if LV_COLOR_DEPTH != 16 && LV_COLOR_16_SWAP != 0
 #error "LV_COLOR_16_SWAP requires LV_COLOR_DEPTH == 16. Set it in lv_conf.h"
 #endif
@@ -74,6 +78,9 @@ enum {
 #define LV_OPA_MIN 5    /*Opacities below this will be transparent*/
 #define LV_OPA_MAX 250  /*Opacities above this will fully cover*/
 
+/*Divide by 255 without division. Exact for `x` <= 255 * 255*/
+#define LV_COLOR_DIV_255(x) (((x) * 0x8081U) >> 23)
+
 #if LV_COLOR_DEPTH == 1
 #define LV_COLOR_SIZE 8
 #elif LV_COLOR_DEPTH == 8
@@ -479,12 +486,12 @@ static inline void lv_color_mix_with_alpha(lv_color_t bg_color, lv_opa_t bg_opa,
     /*Both colors have alpha. Expensive calculation need to be applied*/
     else {
         /*Save the parameters and the result. If they will be asked again don't compute again*/
-        static lv_opa_t fg_opa_save     = 0;
-        static lv_opa_t bg_opa_save     = 0;
-        static lv_color_t fg_color_save = {{0}};
-        static lv_color_t bg_color_save = {{0}};
-        static lv_color_t res_color_saved = {{0}};
-        static lv_opa_t res_opa_saved = 0;
+        static LV_THREAD_LOCAL lv_opa_t fg_opa_save     = 0;
+        static LV_THREAD_LOCAL lv_opa_t bg_opa_save     = 0;
+        static LV_THREAD_LOCAL lv_color_t fg_color_save = {{0}};
+        static LV_THREAD_LOCAL lv_color_t bg_color_save = {{0}};
+        static LV_THREAD_LOCAL lv_color_t res_color_saved = {{0}};
+        static LV_THREAD_LOCAL lv_opa_t res_opa_saved = 0;
 
         if(fg_opa != fg_opa_save || bg_opa != bg_opa_save || fg_color.full != fg_color_save.full ||
                 bg_color.full != bg_color_save.full) {
@@ -509,6 +516,46 @@ static inline void lv_color_mix_with_alpha(lv_color_t bg_color, lv_opa_t bg_opa,
     }
 }
 
+#if LV_COLOR_PREMULT
+/**
+ * Multiply a color with an alpha value. The alpha is stored in the result too.
+ * @param color a color
+ * @param opa the alpha value
+ * @return the premultiplied color
+ */
+static inline lv_color_t lv_color_premult(lv_color_t color, lv_opa_t opa)
+{
+    color.ch.red   = LV_COLOR_DIV_255((uint32_t)color.ch.red * opa);
+    color.ch.green = LV_COLOR_DIV_255((uint32_t)color.ch.green * opa);
+    color.ch.blue  = LV_COLOR_DIV_255((uint32_t)color.ch.blue * opa);
+    color.ch.alpha = opa;
+
+    return color;
+}
+
+/**
+ * Blend a premultiplied color on an other ("source over"). Both colors have alpha value in `ch.alpha`.
+ * @param fg the premultiplied foreground color
+ * @param bg the premultiplied background color
+ * @param opa opacity of the foreground
+ * @return the premultiplied result color
+ */
+static inline lv_color_t lv_color_mix_premult(lv_color_t fg, lv_color_t bg, lv_opa_t opa)
+{
+    /*res = fg * opa + bg * (1 - fg_alpha * opa)*/
+    uint32_t a     = LV_COLOR_DIV_255((uint32_t)fg.ch.alpha * opa);
+    uint32_t a_inv = 255 - a;
+
+    lv_color_t ret;
+    ret.ch.red   = LV_COLOR_DIV_255((uint32_t)fg.ch.red * opa + (uint32_t)bg.ch.red * a_inv);
+    ret.ch.green = LV_COLOR_DIV_255((uint32_t)fg.ch.green * opa + (uint32_t)bg.ch.green * a_inv);
+    ret.ch.blue  = LV_COLOR_DIV_255((uint32_t)fg.ch.blue * opa + (uint32_t)bg.ch.blue * a_inv);
+    ret.ch.alpha = a + LV_COLOR_DIV_255((uint32_t)bg.ch.alpha * a_inv);
+
+    return ret;
+}
+#endif
+
 
 /**
  * Get the brightness of a color
@@ -314,6 +314,29 @@ lv_fs_res_t lv_fs_size(lv_fs_file_t * file_p, uint32_t * size)
     return res;
 }
 
+/**
+ * Get the content of a file in the memory without copying it (e.g. a memory mapped file).
+ * The data remains valid until the file is closed.
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param buf pointer to a pointer to store the address of the content
+ * @param size pointer to a variable to store the size of the content
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum. LV_FS_RES_NOT_IMP if the driver can't map files.
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** buf, uint32_t * size)
+{
+    if(file_p->drv == NULL) {
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    if(file_p->drv->map_cb == NULL) return LV_FS_RES_NOT_IMP;
+
+    if(buf == NULL || size == NULL) return LV_FS_RES_INV_PARAM;
+
+    lv_fs_res_t res = file_p->drv->map_cb(file_p->drv, file_p->file_d, buf, size);
+
+    return res;
+}
+
 /**
  * Rename a file
  * @param oldname path to the file
@@ -76,6 +76,8 @@ typedef struct _lv_fs_drv_t
     lv_fs_res_t (*tell_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
     lv_fs_res_t (*trunc_cb)(struct _lv_fs_drv_t * drv, void * file_p);
     lv_fs_res_t (*size_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+    /*Optional. Give the whole content of the file in the memory (e.g. with `mmap()`). Valid until the file is closed.*/
+    lv_fs_res_t (*map_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void ** buf_p, uint32_t * size_p);
     lv_fs_res_t (*rename_cb)(struct _lv_fs_drv_t * drv, const char * oldname, const char * newname);
     lv_fs_res_t (*free_space_cb)(struct _lv_fs_drv_t * drv, uint32_t * total_p, uint32_t * free_p);
 
@@ -214,6 +216,16 @@ lv_fs_res_t lv_fs_trunc(lv_fs_file_t * file_p);
  */
 lv_fs_res_t lv_fs_size(lv_fs_file_t * file_p, uint32_t * size);
 
+/**
+ * Get the content of a file in the memory without copying it (e.g. a memory mapped file).
+ * The data remains valid until the file is closed.
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param buf pointer to a pointer to store the address of the content
+ * @param size pointer to a variable to store the size of the content
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum. LV_FS_RES_NOT_IMP if the driver can't map files.
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** buf, uint32_t * size);
+
 /**
  * Rename a file
  * @param oldname path to the file
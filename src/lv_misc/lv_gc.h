@@ -34,8 +34,20 @@ extern "C" {
     f(lv_ll_t, _lv_group_ll)                                       \
     f(lv_ll_t, _lv_img_defoder_ll)                                 \
     f(lv_img_cache_entry_t*, _lv_img_cache_array)                  \
+    f(lv_ll_t, _lv_img_cache_async_ll)                             \
+    f(lv_ll_t, _lv_layer_cache_ll)                                 \
+    f(lv_ll_t, _lv_radius_cache_ll)                                \
+    f(lv_ll_t, _lv_shadow_cache_ll)                                \
+    f(lv_ll_t, _lv_grad_cache_ll)                                  \
     f(void*, _lv_task_act)                                         \
-    f(lv_mem_buf_arr_t , _lv_mem_buf)                              \
+    LV_ITERATE_MEM_BUF_ROOT(f)                                     \
+
+#if LV_USE_PARALLEL_DRAW
+/*The temporal buffers are thread local and defined in lv_mem.c*/
+#define LV_ITERATE_MEM_BUF_ROOT(f)
+#else
+#define LV_ITERATE_MEM_BUF_ROOT(f) f(lv_mem_buf_arr_t , _lv_mem_buf)
+#endif
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
 #define LV_ROOTS LV_ITERATE_ROOTS(LV_DEFINE_ROOT)
@@ -44,6 +56,9 @@ extern "C" {
 #if LV_MEM_CUSTOM != 1
 #error "GC requires CUSTOM_MEM"
 #endif /* LV_MEM_CUSTOM */
+#if LV_USE_PARALLEL_DRAW
+#error "GC can't be used with LV_USE_PARALLEL_DRAW"
+#endif /* LV_USE_PARALLEL_DRAW */
 #else  /* LV_ENABLE_GC */
 #define LV_GC_ROOT(x) x
 #define LV_EXTERN_ROOT(root_type, root_name) extern root_type root_name;
@@ -28,6 +28,10 @@
 #define LV_MEM_ADD_JUNK 0
 #endif
 
+#if LV_USE_PARALLEL_DRAW && LV_MEM_CUSTOM == 0
+#error "LV_USE_PARALLEL_DRAW requires a thread-safe allocator. Set LV_MEM_CUSTOM 1"
+#endif
+
 #ifdef LV_ARCH_64
 #define MEM_UNIT uint64_t
 #else
@@ -77,6 +81,11 @@ static uint8_t * work_mem;
 
 static uint32_t zero_mem; /*Give the address of this variable if 0 byte should be allocated*/
 
+#if LV_USE_PARALLEL_DRAW
+/*Every drawing thread has its own temporal buffers*/
+LV_THREAD_LOCAL lv_mem_buf_arr_t _lv_mem_buf;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -422,6 +431,9 @@ void * lv_mem_buf_get(uint32_t size)
             LV_GC_ROOT(_lv_mem_buf[i]).p = lv_mem_realloc(LV_GC_ROOT(_lv_mem_buf[i]).p, size);
             if(LV_GC_ROOT(_lv_mem_buf[i]).p == NULL) {
                 LV_LOG_ERROR("lv_mem_buf_get: Out of memory, can't allocate a new  buffer (increase your LV_MEM_SIZE/heap size)")
+                /*Don't hand out the failed buffer for smaller sizes too*/
+                LV_GC_ROOT(_lv_mem_buf[i]).used = 0;
+                LV_GC_ROOT(_lv_mem_buf[i]).size = 0;
             }
             return  LV_GC_ROOT(_lv_mem_buf[i]).p;
         }
@@ -53,7 +53,11 @@ typedef struct {
 }lv_mem_buf_t;
 
 typedef lv_mem_buf_t lv_mem_buf_arr_t[LV_MEM_BUF_MAX_NUM];
+#if LV_USE_PARALLEL_DRAW
+extern LV_THREAD_LOCAL lv_mem_buf_arr_t _lv_mem_buf;
+#else
 extern lv_mem_buf_arr_t _lv_mem_buf;
+#endif
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -14,6 +14,8 @@ CSRCS += lv_utils.c
 CSRCS += lv_async.c
 CSRCS += lv_printf.c
 CSRCS += lv_bidi.c
+CSRCS += lv_region.c
+CSRCS += lv_profiler.c
 
 DEPPATH += --dep-path $(LVGL_DIR)/$(LVGL_DIR_NAME)/src/lv_misc
 VPATH += :$(LVGL_DIR)/$(LVGL_DIR_NAME)/src/lv_misc
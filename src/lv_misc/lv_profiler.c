@@ -0,0 +1,280 @@
+/**
+ * @file lv_profiler.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_profiler.h"
+
+#if LV_USE_PROFILER
+
+#include <string.h>
+#include "lv_printf.h"
+#include "../lv_hal/lv_hal_tick.h"
+#include "../lv_draw/lv_draw.h"
+
+#if defined(LV_PROFILER_INCLUDE)
+#include LV_PROFILER_INCLUDE
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define EVENT_DURATION  'X'
+#define EVENT_COUNTER   'C'
+
+#if LV_USE_PARALLEL_DRAW
+#define RING_NUM        LV_PROFILER_THREAD_MAX
+#else
+#define RING_NUM        1
+#endif
+
+#define TID_NONE        0xFF    /*The thread has no ring buffer*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** An event in the ring buffer*/
+typedef struct
+{
+    const char * name;
+    uint32_t time;      /**< Start time [us]*/
+    uint32_t value;     /**< Duration [us] or the value of the counter*/
+    char type;          /**< `EVENT_DURATION` or `EVENT_COUNTER`*/
+} lv_profiler_event_t;
+
+/** The ring buffer of a thread. Only its thread writes it so no locking is required.*/
+typedef struct
+{
+    lv_profiler_event_t buf[LV_PROFILER_BUF_SIZE];
+    uint32_t next;      /**< Index of the next event to write*/
+    uint32_t cnt;       /**< Number of valid events in the buffer*/
+} lv_profiler_ring_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void event_add(const char * name, uint32_t time, uint32_t value, char type);
+static uint32_t event_get_end(const lv_profiler_event_t * e);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_profiler_ring_t rings[RING_NUM];
+static uint8_t ring_used;
+
+static uint32_t cnt_frame[_LV_PROFILER_CNT_NUM];
+static LV_THREAD_LOCAL uint32_t cnt_local[_LV_PROFILER_CNT_NUM];
+
+/*Index of the ring buffer of the thread + 1. 0: not assigned yet*/
+static LV_THREAD_LOCAL uint8_t tid_act;
+
+static const char * cnt_names[_LV_PROFILER_CNT_NUM] = {
+    "px_normal",
+    "px_additive",
+    "px_subtractive",
+    "mask_eval",
+    "blend_us",
+    "mask_us",
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the current time of the profiler
+ * @return the time in microseconds (from `LV_PROFILER_TIME_EXPR`)
+ */
+uint32_t lv_profiler_get_time(void)
+{
+    return (uint32_t)(LV_PROFILER_TIME_EXPR);
+}
+
+/**
+ * Add a duration event to the ring buffer of the calling thread which lasted from `start` until now
+ * @param name name of the event. Only the pointer is saved so it should be a static string.
+ * @param start start time returned by `lv_profiler_get_time`
+ */
+void lv_profiler_add(const char * name, uint32_t start)
+{
+    event_add(name, start, lv_profiler_get_time() - start, EVENT_DURATION);
+}
+
+/**
+ * Increment a counter of the current frame
+ * @param cnt the counter to increment (element of `LV_PROFILER_CNT_...`)
+ * @param value add this value to the counter
+ */
+void lv_profiler_count(lv_profiler_cnt_t cnt, uint32_t value)
+{
+    /*Count locally to not lock on every blending. `lv_profiler_collect` sums them up.*/
+    if(cnt < _LV_PROFILER_CNT_NUM) cnt_local[cnt] += value;
+}
+
+/**
+ * Add the counters of the calling thread to the counters of the current frame.
+ * Should be called when a drawing thread finished its job.
+ */
+void lv_profiler_collect(void)
+{
+    LV_DRAW_LOCK();
+    uint8_t i;
+    for(i = 0; i < _LV_PROFILER_CNT_NUM; i++) {
+        cnt_frame[i] += cnt_local[i];
+    }
+    LV_DRAW_UNLOCK();
+
+    memset(cnt_local, 0, sizeof(cnt_local));
+}
+
+/**
+ * Close the current frame: add its counters to the ring buffer of the calling thread and reset them
+ */
+void lv_profiler_frame(void)
+{
+    lv_profiler_collect();
+
+    uint32_t t = lv_profiler_get_time();
+    uint8_t i;
+    for(i = 0; i < _LV_PROFILER_CNT_NUM; i++) {
+        event_add(cnt_names[i], t, cnt_frame[i], EVENT_COUNTER);
+    }
+
+    memset(cnt_frame, 0, sizeof(cnt_frame));
+}
+
+/**
+ * Remove all events from the ring buffers.
+ * The drawing threads shouldn't add events meanwhile.
+ */
+void lv_profiler_clear(void)
+{
+    LV_DRAW_LOCK();
+    uint8_t r;
+    for(r = 0; r < ring_used; r++) {
+        rings[r].next = 0;
+        rings[r].cnt  = 0;
+    }
+    LV_DRAW_UNLOCK();
+}
+
+/**
+ * Print the events of the ring buffers in Chrome trace JSON format (for `chrome://tracing`).
+ * The events of the threads are merged in the order they ended.
+ * The drawing threads shouldn't add events meanwhile.
+ * @param print_cb called with the parts of the JSON text
+ */
+void lv_profiler_dump(lv_profiler_print_cb_t print_cb)
+{
+    if(print_cb == NULL) return;
+
+    char buf[128];
+
+    LV_DRAW_LOCK();
+    print_cb("{\"traceEvents\":[\n");
+
+    /*Start with the oldest event of every ring buffer*/
+    uint32_t pos[RING_NUM];
+    uint32_t total = 0;
+    uint8_t r;
+    for(r = 0; r < ring_used; r++) {
+        pos[r] = 0;
+        total += rings[r].cnt;
+    }
+
+    uint32_t i;
+    for(i = 0; i < total; i++) {
+        /*Take the earliest of the oldest not printed events*/
+        lv_profiler_event_t * e = NULL;
+        uint8_t tid = 0;
+        for(r = 0; r < ring_used; r++) {
+            lv_profiler_ring_t * ring = &rings[r];
+            if(pos[r] >= ring->cnt) continue;
+
+            uint32_t id = (ring->next + LV_PROFILER_BUF_SIZE - ring->cnt + pos[r]) % LV_PROFILER_BUF_SIZE;
+            lv_profiler_event_t * e_ring = &ring->buf[id];
+            if(e == NULL || (int32_t)(event_get_end(e_ring) - event_get_end(e)) < 0) {
+                e = e_ring;
+                tid = r;
+            }
+        }
+        pos[tid]++;
+
+        const char * sep = i + 1 < total ? "," : "";
+        if(e->type == EVENT_DURATION) {
+            lv_snprintf(buf, sizeof(buf),
+                        "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":0,\"tid\":%d}%s\n",
+                        e->name, (unsigned long)e->time, (unsigned long)e->value, tid + 1, sep);
+        } else {
+            lv_snprintf(buf, sizeof(buf),
+                        "{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%lu,\"pid\":0,\"tid\":%d,\"args\":{\"value\":%lu}}%s\n",
+                        e->name, (unsigned long)e->time, tid + 1, (unsigned long)e->value, sep);
+        }
+        print_cb(buf);
+    }
+
+    print_cb("]}\n");
+    LV_DRAW_UNLOCK();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Write an event into the ring buffer of the calling thread.
+ * The oldest event is overwritten if the buffer is full.
+ * @param name name of the event
+ * @param time start time of the event [us]
+ * @param value duration or value of the counter
+ * @param type `EVENT_DURATION` or `EVENT_COUNTER`
+ */
+static void event_add(const char * name, uint32_t time, uint32_t value, char type)
+{
+    /*Give a ring buffer to the thread to not lock on every event.
+     *Its index is the ID of the thread to show its events on a separate track.*/
+    if(tid_act == 0) {
+        LV_DRAW_LOCK();
+        if(ring_used < RING_NUM) {
+            ring_used++;
+            tid_act = ring_used;
+        } else {
+            tid_act = TID_NONE;
+        }
+        LV_DRAW_UNLOCK();
+    }
+
+    if(tid_act == TID_NONE) return;
+
+    lv_profiler_ring_t * ring = &rings[tid_act - 1];
+    lv_profiler_event_t * e = &ring->buf[ring->next];
+    e->name  = name;
+    e->time  = time;
+    e->value = value;
+    e->type  = type;
+
+    ring->next++;
+    if(ring->next >= LV_PROFILER_BUF_SIZE) ring->next = 0;
+    if(ring->cnt < LV_PROFILER_BUF_SIZE) ring->cnt++;
+}
+
+/**
+ * Get the time when an event was added. The events of a thread are ordered by it.
+ * @param e pointer to an event
+ * @return the end of a duration or the time of a counter [us]
+ */
+static uint32_t event_get_end(const lv_profiler_event_t * e)
+{
+    if(e->type == EVENT_DURATION) return e->time + e->value;
+    else return e->time;
+}
+
+#endif /*LV_USE_PROFILER*/
@@ -0,0 +1,120 @@
+/**
+ * @file lv_profiler.h
+ * Record the duration of the refreshing phases and count the drawing operations
+ */
+
+#ifndef LV_PROFILER_H
+#define LV_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** Counters summed up for every frame*/
+enum {
+    LV_PROFILER_CNT_PX_NORMAL,          /**< Pixels blended with `LV_BLEND_MODE_NORMAL`*/
+    LV_PROFILER_CNT_PX_ADDITIVE,        /**< Pixels blended with `LV_BLEND_MODE_ADDITIVE`*/
+    LV_PROFILER_CNT_PX_SUBTRACTIVE,     /**< Pixels blended with `LV_BLEND_MODE_SUBTRACTIVE`*/
+    LV_PROFILER_CNT_MASK_EVAL,          /**< Number of mask evaluations (a line of a mask)*/
+    LV_PROFILER_CNT_BLEND_TIME,         /**< Time spent with blending [us]*/
+    LV_PROFILER_CNT_MASK_TIME,          /**< Time spent with applying the masks [us]*/
+    _LV_PROFILER_CNT_NUM
+};
+typedef uint8_t lv_profiler_cnt_t;
+
+/** Profiler print function. Receives a part of the JSON text.*/
+typedef void (*lv_profiler_print_cb_t)(const char * txt);
+
+#if LV_USE_PROFILER
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the current time of the profiler
+ * @return the time in microseconds (from `LV_PROFILER_TIME_EXPR`)
+ */
+uint32_t lv_profiler_get_time(void);
+
+/**
+ * Add a duration event to the ring buffer of the calling thread which lasted from `start` until now
+ * @param name name of the event. Only the pointer is saved so it should be a static string.
+ * @param start start time returned by `lv_profiler_get_time`
+ */
+void lv_profiler_add(const char * name, uint32_t start);
+
+/**
+ * Increment a counter of the current frame
+ * @param cnt the counter to increment (element of `LV_PROFILER_CNT_...`)
+ * @param value add this value to the counter
+ */
+void lv_profiler_count(lv_profiler_cnt_t cnt, uint32_t value);
+
+/**
+ * Add the counters of the calling thread to the counters of the current frame.
+ * Should be called when a drawing thread finished its job.
+ */
+void lv_profiler_collect(void);
+
+/**
+ * Close the current frame: add its counters to the ring buffer of the calling thread and reset them
+ */
+void lv_profiler_frame(void);
+
+/**
+ * Remove all events from the ring buffers.
+ * The drawing threads shouldn't add events meanwhile.
+ */
+void lv_profiler_clear(void);
+
+/**
+ * Print the events of the ring buffers in Chrome trace JSON format (for `chrome://tracing`).
+ * The events of the threads are merged in the order they ended.
+ * The drawing threads shouldn't add events meanwhile.
+ * @param print_cb called with the parts of the JSON text
+ */
+void lv_profiler_dump(lv_profiler_print_cb_t print_cb);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define LV_PROFILER_BEGIN(t)            uint32_t t = lv_profiler_get_time()
+#define LV_PROFILER_END(name, t)        lv_profiler_add(name, t)
+#define LV_PROFILER_COUNT(cnt, value)   lv_profiler_count(cnt, value)
+#define LV_PROFILER_COUNT_TIME(cnt, t)  lv_profiler_count(cnt, lv_profiler_get_time() - (t))
+#define LV_PROFILER_COLLECT()           lv_profiler_collect()
+#define LV_PROFILER_FRAME()             lv_profiler_frame()
+
+#else /*LV_USE_PROFILER*/
+
+/*Do nothing if `LV_USE_PROFILER` is disabled*/
+#define LV_PROFILER_BEGIN(t)
+#define LV_PROFILER_END(name, t)
+#define LV_PROFILER_COUNT(cnt, value)
+#define LV_PROFILER_COUNT_TIME(cnt, t)
+#define LV_PROFILER_COLLECT()
+#define LV_PROFILER_FRAME()
+
+#endif /*LV_USE_PROFILER*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_PROFILER_H*/
@@ -0,0 +1,404 @@
+/**
+ * @file lv_region.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_region.h"
+#include "lv_math.h"
+#include "lv_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint8_t area_diff(lv_area_t res[], const lv_area_t * a_p, const lv_area_t * b_p);
+static void area_absorb(lv_region_t * reg, lv_area_t * area_p);
+static void area_remove(lv_region_t * reg, uint16_t id);
+static uint32_t get_cost(const lv_area_t * area_p, lv_region_cost_cb_t cost_cb, void * user_data);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize an empty region
+ * @param reg pointer to a region to initialize
+ * @param buf an array of areas to store the region's areas. Should be kept while the region is used.
+ * @param max number of areas in `buf`
+ */
+void lv_region_init(lv_region_t * reg, lv_area_t * buf, uint16_t max)
+{
+    reg->areas = buf;
+    reg->max   = max;
+    reg->cnt   = 0;
+}
+
+/**
+ * Remove all areas from a region
+ * @param reg pointer to a region
+ */
+void lv_region_clear(lv_region_t * reg)
+{
+    reg->cnt = 0;
+}
+
+/**
+ * Add an area to a region.
+ * If the uncovered parts of `area_p` don't fit into the buffer, `area_p` is enlarged to cover
+ * the areas it's on, and they are replaced by it.
+ * @param reg pointer to a region
+ * @param area_p pointer to an area to add
+ * @return true: the area is added; false: there was no room for it even after joining
+ *         (the region is not changed)
+ */
+bool lv_region_union(lv_region_t * reg, const lv_area_t * area_p)
+{
+    uint16_t i;
+
+    /*Nothing to do if the area is already covered*/
+    for(i = 0; i < reg->cnt; i++) {
+        if(lv_area_is_in(area_p, &reg->areas[i])) return true;
+    }
+
+    /*The areas covered by the new area are not required anymore*/
+    for(i = 0; i < reg->cnt;) {
+        if(lv_area_is_in(&reg->areas[i], area_p)) area_remove(reg, i);
+        else i++;
+    }
+
+    /*Cut the new area into pieces which are out of the existing areas.
+     *The pieces are collected after the existing areas.*/
+    uint16_t start = reg->cnt;
+    if(start >= reg->max) goto join;
+
+    reg->areas[reg->cnt] = *area_p;
+    reg->cnt++;
+
+    lv_area_t res[4];
+    for(i = 0; i < start; i++) {
+        uint16_t p = start;
+        while(p < reg->cnt) {
+            if(lv_area_is_on(&reg->areas[p], &reg->areas[i]) == false) {
+                p++;
+                continue;
+            }
+
+            uint8_t res_cnt = area_diff(res, &reg->areas[p], &reg->areas[i]);
+            if(reg->cnt - 1 + res_cnt > reg->max) {
+                /*Drop the pieces and add the new area in one piece instead*/
+                reg->cnt = start;
+                goto join;
+            }
+
+            /*The piece is fully covered*/
+            if(res_cnt == 0) {
+                area_remove(reg, p);
+                continue;
+            }
+
+            /*Replace the piece with its parts and add the others to the end. They are checked
+             *against the current area again but they are not on it anymore.*/
+            reg->areas[p] = res[0];
+            uint8_t r;
+            for(r = 1; r < res_cnt; r++) {
+                reg->areas[reg->cnt] = res[r];
+                reg->cnt++;
+            }
+            p++;
+        }
+    }
+
+    return true;
+
+join:
+    {
+        lv_area_t joined = *area_p;
+        area_absorb(reg, &joined);
+        if(reg->cnt >= reg->max) return false;
+
+        reg->areas[reg->cnt] = joined;
+        reg->cnt++;
+    }
+    return true;
+}
+
+/**
+ * Remove an area from a region
+ * @param reg pointer to a region
+ * @param area_p pointer to an area to remove
+ * @return true: the area is removed; false: there was no room for all the remaining parts so
+ *         some parts of `area_p` are still in the region
+ */
+bool lv_region_subtract(lv_region_t * reg, const lv_area_t * area_p)
+{
+    bool ret = true;
+    lv_area_t res[4];
+    uint16_t i = 0;
+    while(i < reg->cnt) {
+        if(lv_area_is_on(&reg->areas[i], area_p) == false) {
+            i++;
+            continue;
+        }
+
+        uint8_t res_cnt = area_diff(res, &reg->areas[i], area_p);
+        if(reg->cnt - 1 + res_cnt > reg->max) {
+            /*Keep the area as it is*/
+            ret = false;
+            i++;
+            continue;
+        }
+
+        if(res_cnt == 0) {
+            area_remove(reg, i);
+            continue;
+        }
+
+        reg->areas[i] = res[0];
+        uint8_t r;
+        for(r = 1; r < res_cnt; r++) {
+            reg->areas[reg->cnt] = res[r];
+            reg->cnt++;
+        }
+        i++;
+    }
+
+    return ret;
+}
+
+/**
+ * Keep only the parts of a region which are on an area
+ * @param reg pointer to a region
+ * @param area_p pointer to an area
+ */
+void lv_region_intersect(lv_region_t * reg, const lv_area_t * area_p)
+{
+    uint16_t i = 0;
+    while(i < reg->cnt) {
+        if(lv_area_intersect(&reg->areas[i], &reg->areas[i], area_p)) i++;
+        else area_remove(reg, i);
+    }
+}
+
+/**
+ * Check if an area is fully covered by a region
+ * @param reg pointer to a region
+ * @param area_p pointer to an area
+ * @return true: `area_p` is fully covered
+ */
+bool lv_region_is_in(const lv_region_t * reg, const lv_area_t * area_p)
+{
+    /*The areas are disjoint so `area_p` is covered if the covered parts give its size*/
+    uint32_t covered = 0;
+    uint16_t i;
+    lv_area_t com;
+    for(i = 0; i < reg->cnt; i++) {
+        if(lv_area_intersect(&com, &reg->areas[i], area_p)) covered += lv_area_get_size(&com);
+    }
+
+    return covered == lv_area_get_size(area_p) ? true : false;
+}
+
+/**
+ * Get the number of pixels in a region
+ * @param reg pointer to a region
+ * @return the total size of the areas
+ */
+uint32_t lv_region_get_size(const lv_region_t * reg)
+{
+    uint32_t size = 0;
+    uint16_t i;
+    for(i = 0; i < reg->cnt; i++) {
+        size += lv_area_get_size(&reg->areas[i]);
+    }
+
+    return size;
+}
+
+/**
+ * Merge the areas of a region where it reduces the total cost.
+ * Two areas are merged by replacing them (and the areas on their bounding box) with their bounding box.
+ * @param reg pointer to a region
+ * @param max_cnt merge the cheapest areas anyway while the region has more areas than this
+ * @param cost_cb tells the cost of an area. NULL to use the size of the areas.
+ * @param user_data passed to `cost_cb`
+ */
+void lv_region_optimize(lv_region_t * reg, uint16_t max_cnt, lv_region_cost_cb_t cost_cb, void * user_data)
+{
+    /*The cost of the areas are used for every pair so calculate them only once per merge*/
+    uint32_t * costs = lv_mem_buf_get(sizeof(uint32_t) * reg->cnt);
+
+    while(reg->cnt > 1) {
+        int32_t best_gain = INT32_MIN;
+        lv_area_t best_area = {0};
+        uint16_t i;
+        uint16_t j;
+        uint16_t k;
+
+        /*Merging can't gain more than the cost of all the areas minus the cost of the bounding box.
+         *It quickly rules out the distant pairs.*/
+        int32_t cost_sum = 0;
+        for(k = 0; k < reg->cnt; k++) {
+            uint32_t cost = get_cost(&reg->areas[k], cost_cb, user_data);
+            if(costs) costs[k] = cost;
+            cost_sum += cost;
+        }
+
+        for(i = 0; i < reg->cnt; i++) {
+            for(j = i + 1; j < reg->cnt; j++) {
+                lv_area_t joined;
+                lv_area_join(&joined, &reg->areas[i], &reg->areas[j]);
+
+                int32_t gain_limit = reg->cnt > max_cnt ? best_gain : LV_MATH_MAX(best_gain, 0);
+                int32_t joined_cost = get_cost(&joined, cost_cb, user_data);
+                if(cost_sum - joined_cost <= gain_limit) continue;
+
+                /*Enlarge the bounding box until it doesn't cut any areas.
+                 *Meanwhile sum the cost of the areas it replaces.*/
+                int32_t replaced_cost;
+                bool enlarged = false;
+                bool changed;
+                do {
+                    changed = false;
+                    replaced_cost = 0;
+                    for(k = 0; k < reg->cnt; k++) {
+                        if(lv_area_is_on(&joined, &reg->areas[k]) == false) continue;
+
+                        if(lv_area_is_in(&reg->areas[k], &joined)) {
+                            replaced_cost += costs ? costs[k] : get_cost(&reg->areas[k], cost_cb, user_data);
+                        } else {
+                            lv_area_join(&joined, &joined, &reg->areas[k]);
+                            changed  = true;
+                            enlarged = true;
+                        }
+                    }
+                } while(changed);
+
+                if(enlarged) joined_cost = get_cost(&joined, cost_cb, user_data);
+
+                /*Compare the cost of the replaced areas with the bounding box's*/
+                int32_t gain = replaced_cost - joined_cost;
+                if(gain > best_gain) {
+                    best_gain = gain;
+                    best_area = joined;
+                }
+            }
+        }
+
+        /*Stop if merging is not worth it and the number of areas is fine*/
+        if(best_gain <= 0 && reg->cnt <= max_cnt) break;
+
+        area_absorb(reg, &best_area);
+        reg->areas[reg->cnt] = best_area;
+        reg->cnt++;
+    }
+
+    if(costs) lv_mem_buf_release(costs);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the parts of `a_p` which are not on `b_p`.
+ * The parts are: a band above and below `b_p` and the parts on the left and right of it.
+ * @param res store the parts here (max. 4)
+ * @param a_p pointer to an area
+ * @param b_p pointer to an area to cut out from `a_p`
+ * @return number of parts in `res` (0 if `a_p` is fully covered by `b_p`)
+ */
+static uint8_t area_diff(lv_area_t res[], const lv_area_t * a_p, const lv_area_t * b_p)
+{
+    if(lv_area_is_on(a_p, b_p) == false) {
+        res[0] = *a_p;
+        return 1;
+    }
+
+    uint8_t cnt = 0;
+    lv_area_t rest = *a_p;
+    if(b_p->y1 > rest.y1) {
+        res[cnt] = rest;
+        res[cnt].y2 = b_p->y1 - 1;
+        rest.y1 = b_p->y1;
+        cnt++;
+    }
+
+    if(b_p->y2 < rest.y2) {
+        res[cnt] = rest;
+        res[cnt].y1 = b_p->y2 + 1;
+        rest.y2 = b_p->y2;
+        cnt++;
+    }
+
+    if(b_p->x1 > rest.x1) {
+        res[cnt] = rest;
+        res[cnt].x2 = b_p->x1 - 1;
+        cnt++;
+    }
+
+    if(b_p->x2 < rest.x2) {
+        res[cnt] = rest;
+        res[cnt].x1 = b_p->x2 + 1;
+        cnt++;
+    }
+
+    return cnt;
+}
+
+/**
+ * Enlarge an area to cover all the areas of a region it's on, and remove these areas.
+ * @param reg pointer to a region
+ * @param area_p pointer to an area to enlarge
+ */
+static void area_absorb(lv_region_t * reg, lv_area_t * area_p)
+{
+    bool changed;
+    do {
+        changed = false;
+        uint16_t i = 0;
+        while(i < reg->cnt) {
+            if(lv_area_is_on(area_p, &reg->areas[i])) {
+                lv_area_join(area_p, area_p, &reg->areas[i]);
+                area_remove(reg, i);
+                changed = true;
+            } else {
+                i++;
+            }
+        }
+    } while(changed);
+}
+
+/**
+ * Remove an area from a region. The last area is moved to its place.
+ * @param reg pointer to a region
+ * @param id index of the area to remove
+ */
+static void area_remove(lv_region_t * reg, uint16_t id)
+{
+    reg->cnt--;
+    reg->areas[id] = reg->areas[reg->cnt];
+}
+
+static uint32_t get_cost(const lv_area_t * area_p, lv_region_cost_cb_t cost_cb, void * user_data)
+{
+    if(cost_cb) return cost_cb(area_p, user_data);
+    else return lv_area_get_size(area_p);
+}
@@ -0,0 +1,125 @@
+/**
+ * @file lv_region.h
+ * A region is a set of non-overlapping areas stored in a fixed size buffer
+ */
+
+#ifndef LV_REGION_H
+#define LV_REGION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lv_area.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Describes a region as a list of disjoint areas.
+ * The areas are stored in a buffer given by the user.
+ */
+typedef struct
+{
+    lv_area_t * areas;  /**< The disjoint areas of the region*/
+    uint16_t cnt;       /**< Number of areas in `areas`*/
+    uint16_t max;       /**< Size of the `areas` buffer*/
+} lv_region_t;
+
+/**
+ * Tells the "cost" of processing an area. Used to decide which areas should be merged.
+ * E.g. the number of pixels plus some constant overhead for every area.
+ */
+typedef uint32_t (*lv_region_cost_cb_t)(const lv_area_t * area, void * user_data);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize an empty region
+ * @param reg pointer to a region to initialize
+ * @param buf an array of areas to store the region's areas. Should be kept while the region is used.
+ * @param max number of areas in `buf`
+ */
+void lv_region_init(lv_region_t * reg, lv_area_t * buf, uint16_t max);
+
+/**
+ * Remove all areas from a region
+ * @param reg pointer to a region
+ */
+void lv_region_clear(lv_region_t * reg);
+
+/**
+ * Add an area to a region.
+ * If the uncovered parts of `area_p` don't fit into the buffer, `area_p` is enlarged to cover
+ * the areas it's on, and they are replaced by it.
+ * @param reg pointer to a region
+ * @param area_p pointer to an area to add
+ * @return true: the area is added; false: there was no room for it even after joining
+ *         (the region is not changed)
+ */
+bool lv_region_union(lv_region_t * reg, const lv_area_t * area_p);
+
+/**
+ * Remove an area from a region
+ * @param reg pointer to a region
+ * @param area_p pointer to an area to remove
+ * @return true: the area is removed; false: there was no room for all the remaining parts so
+ *         some parts of `area_p` are still in the region
+ */
+bool lv_region_subtract(lv_region_t * reg, const lv_area_t * area_p);
+
+/**
+ * Keep only the parts of a region which are on an area
+ * @param reg pointer to a region
+ * @param area_p pointer to an area
+ */
+void lv_region_intersect(lv_region_t * reg, const lv_area_t * area_p);
+
+/**
+ * Check if an area is fully covered by a region
+ * @param reg pointer to a region
+ * @param area_p pointer to an area
+ * @return true: `area_p` is fully covered
+ */
+bool lv_region_is_in(const lv_region_t * reg, const lv_area_t * area_p);
+
+/**
+ * Get the number of pixels in a region
+ * @param reg pointer to a region
+ * @return the total size of the areas
+ */
+uint32_t lv_region_get_size(const lv_region_t * reg);
+
+/**
+ * Merge the areas of a region where it reduces the total cost.
+ * Two areas are merged by replacing them (and the areas on their bounding box) with their bounding box.
+ * @param reg pointer to a region
+ * @param max_cnt merge the cheapest areas anyway while the region has more areas than this
+ * @param cost_cb tells the cost of an area. NULL to use the size of the areas.
+ * @param user_data passed to `cost_cb`
+ */
+void lv_region_optimize(lv_region_t * reg, uint16_t max_cnt, lv_region_cost_cb_t cost_cb, void * user_data);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_REGION_H*/
@@ -685,6 +685,12 @@ void lv_canvas_fill_bg(lv_obj_t * canvas, lv_color_t color, lv_opa_t opa)
 
     uint32_t x = dsc->header.w * dsc->header.h;
     uint32_t y;
+
+#if LV_COLOR_PREMULT
+    /*The images with alpha channel store premultiplied colors*/
+    if(lv_img_cf_has_alpha(dsc->header.cf)) color = lv_color_premult(color, opa);
+#endif
+
     for(y = 0; y < dsc->header.h; y++) {
         for(x = 0; x < dsc->header.w; x++) {
             lv_img_buf_set_px_color(dsc, x, y, color);
@@ -1056,6 +1062,72 @@ void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t * points, uint32
     lv_obj_invalidate(canvas);
 }
 
+/**
+ * Draw a polygon on the canvas with a given fill rule. Concave and self-intersecting polygons are supported too.
+ * The points are the top left corners of the pixels and no border and shadow is drawn (see `lv_draw_polygon_fill_rule`).
+ * @param canvas pointer to a canvas object
+ * @param points point of the polygon
+ * @param point_cnt number of points
+ * @param style style of the polygon (`body.main_color`, `body.grad_color`, `body.grad_dir` and `body.opa` are used)
+ * @param rule an element of `lv_draw_fill_rule_t`
+ */
+void lv_canvas_draw_polygon_fill_rule(lv_obj_t * canvas, const lv_point_t * points, uint32_t point_cnt,
+                                      const lv_style_t * style, lv_draw_fill_rule_t rule)
+{
+    LV_ASSERT_OBJ(canvas, LV_OBJX_NAME);
+    LV_ASSERT_NULL(style);
+
+    lv_img_dsc_t * dsc = lv_canvas_get_img(canvas);
+
+    if(dsc->header.cf >= LV_IMG_CF_INDEXED_1BIT && dsc->header.cf <= LV_IMG_CF_INDEXED_8BIT) {
+        LV_LOG_WARN("lv_canvas_draw_polygon_fill_rule: can't raw to LV_IMG_CF_INDEXED canvas");
+        return;
+    }
+
+    /* Create a dummy display to fool the lv_draw function.
+     * It will think it draws to real screen. */
+    lv_area_t mask;
+    mask.x1 = 0;
+    mask.x2 = dsc->header.w - 1;
+    mask.y1 = 0;
+    mask.y2 = dsc->header.h - 1;
+
+    lv_disp_t disp;
+    memset(&disp, 0, sizeof(lv_disp_t));
+
+    lv_disp_buf_t disp_buf;
+    lv_disp_buf_init(&disp_buf, (void *)dsc->data, NULL, dsc->header.w * dsc->header.h);
+    lv_area_copy(&disp_buf.area, &mask);
+
+    lv_disp_drv_init(&disp.driver);
+
+    disp.driver.buffer  = &disp_buf;
+    disp.driver.hor_res = dsc->header.w;
+    disp.driver.ver_res = dsc->header.h;
+
+    set_set_px_cb(&disp.driver, dsc->header.cf);
+
+#if LV_ANTIALIAS
+    /*Disable anti-aliasing if drawing with transparent color to chroma keyed canvas*/
+    lv_color_t ctransp = LV_COLOR_TRANSP;
+    if(dsc->header.cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED &&
+        style->body.main_color.full == ctransp.full &&
+        style->body.grad_color.full == ctransp.full)
+    {
+        disp.driver.antialiasing = 0;
+    }
+#endif
+
+    lv_disp_t * refr_ori = lv_refr_get_disp_refreshing();
+    lv_refr_set_disp_refreshing(&disp);
+
+    lv_draw_polygon_fill_rule(points, point_cnt, &mask, style, LV_OPA_COVER, rule);
+
+    lv_refr_set_disp_refreshing(refr_ori);
+
+    lv_obj_invalidate(canvas);
+}
+
 /**
  * Draw an arc on the canvas
  * @param canvas pointer to a canvas object
@@ -1239,6 +1311,13 @@ static void set_px_true_color_alpha(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_
     (void) disp_drv; /*Unused*/
 
     if(opa <= LV_OPA_MIN) return;
+
+#if LV_COLOR_PREMULT
+    /*The buffer is premultiplied ARGB8888 so simply blend on the pixel*/
+    lv_color_t * px = (lv_color_t *)&buf[(y * buf_w + x) * LV_IMG_PX_SIZE_ALPHA_BYTE];
+    color.ch.alpha = LV_OPA_COVER;
+    *px = lv_color_mix_premult(color, *px, opa);
+#else
     lv_img_dsc_t d;
     d.data = buf;
     d.header.always_zero = 0;
@@ -1257,6 +1336,7 @@ static void set_px_true_color_alpha(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_
 
     lv_img_buf_set_px_alpha(&d, x, y, res_opa);
     lv_img_buf_set_px_color(&d, x, y, res_color);
+#endif
 }
 
 #endif
@@ -239,6 +239,18 @@ void lv_canvas_draw_line(lv_obj_t * canvas, const lv_point_t * points, uint32_t
  */
 void lv_canvas_draw_polygon(lv_obj_t * canvas, const lv_point_t * points, uint32_t point_cnt, const lv_style_t * style);
 
+/**
+ * Draw a polygon on the canvas with a given fill rule. Concave and self-intersecting polygons are supported too.
+ * The points are the top left corners of the pixels and no border and shadow is drawn (see `lv_draw_polygon_fill_rule`).
+ * @param canvas pointer to a canvas object
+ * @param points point of the polygon
+ * @param point_cnt number of points
+ * @param style style of the polygon (`body.main_color`, `body.grad_color`, `body.grad_dir` and `body.opa` are used)
+ * @param rule an element of `lv_draw_fill_rule_t`
+ */
+void lv_canvas_draw_polygon_fill_rule(lv_obj_t * canvas, const lv_point_t * points, uint32_t point_cnt,
+                                      const lv_style_t * style, lv_draw_fill_rule_t rule);
+
 /**
  * Draw an arc on the canvas
  * @param canvas pointer to a canvas object
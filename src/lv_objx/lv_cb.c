@@ -282,18 +282,34 @@ static lv_design_res_t lv_bullet_design(lv_obj_t * bullet, const lv_area_t * cli
         lv_obj_t * bg                 = lv_obj_get_parent(bullet);
         const lv_style_t * style_page = lv_obj_get_style(bg);
         lv_group_t * g                = lv_obj_get_group(bg);
+#if LV_USE_PARALLEL_DRAW
+        lv_style_t style_draw;
+        bool style_act = false;
+#endif
         if(style_page->body.opa == LV_OPA_TRANSP) { /*Is the Background visible?*/
             if(lv_group_get_focused(g) == bg) {
                 lv_style_t * style_mod;
                 style_mod       = lv_group_mod_style(g, style_ori);
+#if LV_USE_PARALLEL_DRAW
+                /*The other drawing threads read `style_p` so set the style only for this thread.
+                 *Copy it because the children's `lv_obj_get_style` can overwrite `style_mod`.*/
+                lv_style_copy(&style_draw, style_mod);
+                lv_obj_set_draw_style(bullet, &style_draw);
+                style_act = true;
+#else
                 bullet->style_p = style_mod; /*Temporally change the style to the activated */
+#endif
             }
         }
 #endif
         ancestor_bullet_design(bullet, clip_area, mode);
 
 #if LV_USE_GROUP
+#if LV_USE_PARALLEL_DRAW
+        if(style_act) lv_obj_set_draw_style(NULL, NULL); /*Revert the style*/
+#else
         bullet->style_p = style_ori; /*Revert the style*/
+#endif
 #endif
     } else if(mode == LV_DESIGN_DRAW_POST) {
         ancestor_bullet_design(bullet, clip_area, mode);
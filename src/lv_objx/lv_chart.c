@@ -44,6 +44,18 @@ typedef struct {
     uint8_t is_reverse_iter;
 } lv_chart_label_iterator_t;
 
+/*Calculates the points of a run of valid points of a series for `lv_draw_polyline_cb`*/
+typedef struct {
+    const lv_chart_ext_t * ext;
+    const lv_chart_series_t * ser;
+    uint16_t start_point;   /*Index of the data of the left most point*/
+    uint16_t first;         /*Index of the first point of the run from the left*/
+    lv_coord_t w;
+    lv_coord_t h;
+    lv_coord_t x_ofs;
+    lv_coord_t y_ofs;
+} lv_chart_line_dsc_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -51,6 +63,7 @@ static lv_design_res_t lv_chart_design(lv_obj_t * chart, const lv_area_t * clip_
 static lv_res_t lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param);
 static void lv_chart_draw_div(lv_obj_t * chart, const lv_area_t * mask);
 static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask);
+static void lv_chart_line_point_cb(const void * user_data, uint16_t id, uint16_t cnt, lv_point_t * points);
 static void lv_chart_draw_points(lv_obj_t * chart, const lv_area_t * mask);
 static void lv_chart_draw_cols(lv_obj_t * chart, const lv_area_t * mask);
 static void lv_chart_draw_vertical_lines(lv_obj_t * chart, const lv_area_t * mask);
@@ -857,14 +870,6 @@ static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask)
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
 
     uint16_t i;
-    lv_point_t p1;
-    lv_point_t p2;
-    lv_coord_t w     = lv_obj_get_width(chart);
-    lv_coord_t h     = lv_obj_get_height(chart);
-    lv_coord_t x_ofs = chart->coords.x1;
-    lv_coord_t y_ofs = chart->coords.y1;
-    int32_t y_tmp;
-    lv_coord_t p_prev;
     lv_coord_t p_act;
     lv_chart_series_t * ser;
     lv_opa_t opa_scale = lv_obj_get_opa_scale(chart);
@@ -873,38 +878,90 @@ static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask)
     style.line.opa   = ext->series.opa;
     style.line.width = ext->series.width;
 
+    lv_chart_line_dsc_t dsc;
+    dsc.ext   = ext;
+    dsc.w     = lv_obj_get_width(chart);
+    dsc.h     = lv_obj_get_height(chart);
+    dsc.x_ofs = chart->coords.x1;
+    dsc.y_ofs = chart->coords.y1;
+
+    /*Only the points around the mask's x range can be visible. The x coordinates increase with the index.*/
+    uint16_t i_start = 0;
+    uint16_t i_end   = ext->point_cnt - 1;
+    if(ext->point_cnt > 1 && dsc.w > 0) {
+        lv_coord_t pad = (ext->series.width >> 1) + 3;
+        int32_t x_min = mask->x1 - pad - dsc.x_ofs;
+        int32_t x_max = mask->x2 + pad - dsc.x_ofs;
+        if(x_min >= dsc.w) i_start = ext->point_cnt - 1;
+        else if(x_min > 0) i_start = (x_min * (ext->point_cnt - 1)) / dsc.w;
+
+        if(x_max <= 0) i_end = 0;
+        else if(x_max < dsc.w) i_end = (x_max * (ext->point_cnt - 1) + dsc.w - 1) / dsc.w;
+    }
+
     /*Go through all data lines*/
     LV_LL_READ_BACK(ext->series_ll, ser)
     {
         style.line.color = ser->color;
 
-        lv_coord_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
-
-        p1.x = 0 + x_ofs;
-        p2.x = 0 + x_ofs;
-
-        p_prev = start_point;
-        y_tmp  = (int32_t)((int32_t)ser->points[p_prev] - ext->ymin) * h;
-        y_tmp  = y_tmp / (ext->ymax - ext->ymin);
-        p2.y   = h - y_tmp + y_ofs;
+        dsc.ser         = ser;
+        dsc.start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
 
-        for(i = 1; i < ext->point_cnt; i++) {
-            p1.x = p2.x;
-            p1.y = p2.y;
-
-            p2.x = ((w * i) / (ext->point_cnt - 1)) + x_ofs;
-
-            p_act = (start_point + i) % ext->point_cnt;
+        /*Draw the consecutive valid points as a polyline. Their coordinates are calculated on demand.*/
+        dsc.first = i_start;
+        for(i = i_start; i <= i_end; i++) {
+            p_act = (dsc.start_point + i) % ext->point_cnt;
+            if(ser->points[p_act] == LV_CHART_POINT_DEF) {
+                lv_draw_polyline_cb(lv_chart_line_point_cb, &dsc, i - dsc.first, mask, &style, opa_scale);
+                dsc.first = i + 1;
+            }
+        }
 
-            y_tmp = (int32_t)((int32_t)ser->points[p_act] - ext->ymin) * h;
-            y_tmp = y_tmp / (ext->ymax - ext->ymin);
-            p2.y  = h - y_tmp + y_ofs;
+        lv_draw_polyline_cb(lv_chart_line_point_cb, &dsc, i_end + 1 - dsc.first, mask, &style, opa_scale);
+    }
+}
 
-            if(ser->points[p_prev] != LV_CHART_POINT_DEF && ser->points[p_act] != LV_CHART_POINT_DEF)
-                lv_draw_line(&p1, &p2, mask, &style, opa_scale);
+/**
+ * Calculate the points of a data line. The point callback of `lv_draw_polyline_cb`
+ * @param user_data pointer to an `lv_chart_line_dsc_t`
+ * @param id index of the first point in the run
+ * @param cnt number of points to calculate
+ * @param points store the points here
+ */
+static void lv_chart_line_point_cb(const void * user_data, uint16_t id, uint16_t cnt, lv_point_t * points)
+{
+    const lv_chart_line_dsc_t * dsc = user_data;
+    const lv_chart_ext_t * ext      = dsc->ext;
+    uint32_t i                      = dsc->first + id;
+    uint32_t p_act                  = (dsc->start_point + i) % ext->point_cnt;
+    int32_t y_tmp;
 
-            p_prev = p_act;
+    /*Step the x coordinate with its remainder instead of dividing for every point.
+     *The same as `(w * i) / (point_cnt - 1)`. The points are got again for every chunk of the polyline.*/
+    int32_t x_mul  = ext->point_cnt > 1 ? dsc->w : 0;
+    int32_t x_div  = ext->point_cnt > 1 ? ext->point_cnt - 1 : 1;
+    int32_t x      = (x_mul * (int32_t)i) / x_div;
+    int32_t x_rem  = (x_mul * (int32_t)i) % x_div;
+    int32_t x_step = x_mul / x_div;
+    int32_t x_step_rem = x_mul % x_div;
+
+    uint16_t k;
+    for(k = 0; k < cnt; k++) {
+        points[k].x = x + dsc->x_ofs;
+
+        y_tmp       = (int32_t)((int32_t)dsc->ser->points[p_act] - ext->ymin) * dsc->h;
+        y_tmp       = y_tmp / (ext->ymax - ext->ymin);
+        points[k].y = dsc->h - y_tmp + dsc->y_ofs;
+
+        x     += x_step;
+        x_rem += x_step_rem;
+        if(x_rem >= x_div) {
+            x_rem -= x_div;
+            x++;
         }
+
+        p_act++;
+        if(p_act == ext->point_cnt) p_act = 0;
     }
 }
 
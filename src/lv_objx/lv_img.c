@@ -17,6 +17,7 @@
 #include "../lv_core/lv_debug.h"
 #include "../lv_themes/lv_theme.h"
 #include "../lv_draw/lv_img_decoder.h"
+#include "../lv_draw/lv_img_cache.h"
 #include "../lv_misc/lv_fs.h"
 #include "../lv_misc/lv_txt.h"
 #include "../lv_misc/lv_math.h"
@@ -499,6 +500,14 @@ static lv_design_res_t lv_img_design(lv_obj_t * img, const lv_area_t * clip_area
         lv_design_res_t cover = LV_DESIGN_RES_NOT_COVER;
         if(ext->src_type == LV_IMG_SRC_UNKNOWN || ext->src_type == LV_IMG_SRC_SYMBOL || ext->angle != 0) return LV_DESIGN_RES_NOT_COVER;
 
+#if LV_IMG_CACHE_ASYNC
+        /*Nothing is drawn while the image is opened in the background*/
+        LV_DRAW_LOCK();
+        bool ready = lv_img_cache_is_ready(ext->src, style);
+        LV_DRAW_UNLOCK();
+        if(ready == false) return LV_DESIGN_RES_NOT_COVER;
+#endif
+
         if(ext->cf == LV_IMG_CF_TRUE_COLOR || ext->cf == LV_IMG_CF_RAW) {
             cover = lv_area_is_in(clip_area, &img->coords) ? LV_DESIGN_RES_COVER : LV_DESIGN_RES_NOT_COVER;
         }
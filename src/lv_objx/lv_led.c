@@ -205,11 +205,6 @@ static lv_design_res_t lv_led_design(lv_obj_t * led, const lv_area_t * clip_area
         lv_led_ext_t * ext       = lv_obj_get_ext_attr(led);
         const lv_style_t * style = lv_obj_get_style(led);
 
-        /* Store the real pointer because of 'lv_group'
-         * If the object is in focus 'lv_obj_get_style()' will give a pointer to tmp style
-         * and to the real object style. It is important because of style change tricks below*/
-        const lv_style_t * style_ori_p = led->style_p;
-
         /*Create a temporal style*/
         lv_style_t leds_tmp;
         memcpy(&leds_tmp, style, sizeof(leds_tmp));
@@ -225,9 +220,9 @@ static lv_design_res_t lv_led_design(lv_obj_t * led, const lv_area_t * clip_area
         leds_tmp.body.shadow.width =
             ((bright_tmp - LV_LED_BRIGHT_OFF) * style->body.shadow.width) / (LV_LED_BRIGHT_ON - LV_LED_BRIGHT_OFF);
 
-        led->style_p = &leds_tmp;
-        ancestor_design(led, clip_area, mode);
-        led->style_p = style_ori_p; /*Restore the ORIGINAL style pointer*/
+        /*Draw with the temporal style directly instead of setting it to the object.
+         *This way the object is not modified while drawing.*/
+        lv_draw_rect(&led->coords, clip_area, &leds_tmp, lv_obj_get_opa_scale(led));
     }
     return LV_DESIGN_RES_OK;
 }
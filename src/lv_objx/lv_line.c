@@ -24,12 +24,20 @@
 /**********************
  *      TYPEDEFS
  **********************/
+/*Converts the points of a line to absolute coordinates for `lv_draw_polyline_cb`*/
+typedef struct {
+    const lv_line_ext_t * ext;
+    lv_coord_t x_ofs;
+    lv_coord_t y_ofs;
+    lv_coord_t h;
+} lv_line_point_dsc_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_design_res_t lv_line_design(lv_obj_t * line, const lv_area_t * clip_area, lv_design_mode_t mode);
 static lv_res_t lv_line_signal(lv_obj_t * line, lv_signal_t sign, void * param);
+static void lv_line_point_cb(const void * user_data, uint16_t id, uint16_t cnt, lv_point_t * points);
 
 /**********************
  *  STATIC VARIABLES
@@ -232,11 +240,11 @@ static lv_design_res_t lv_line_design(lv_obj_t * line, const lv_area_t * clip_ar
         lv_opa_t opa_scale       = lv_obj_get_opa_scale(line);
         lv_area_t area;
         lv_obj_get_coords(line, &area);
-        lv_coord_t x_ofs = area.x1;
-        lv_coord_t y_ofs = area.y1;
-        lv_point_t p1;
-        lv_point_t p2;
-        lv_coord_t h = lv_obj_get_height(line);
+        lv_line_point_dsc_t dsc;
+        dsc.ext   = ext;
+        dsc.x_ofs = area.x1;
+        dsc.y_ofs = area.y1;
+        dsc.h     = lv_obj_get_height(line);
         uint16_t i;
 
         lv_style_t circle_style_tmp; /*If rounded...*/
@@ -251,43 +259,45 @@ static lv_design_res_t lv_line_design(lv_obj_t * line, const lv_area_t * clip_ar
         lv_coord_t r = (style->line.width >> 1);
         lv_coord_t r_corr = (style->line.width & 1) ? 0 : 1;
 
-        /*Read all points and draw the lines*/
-        for(i = 0; i < ext->point_num - 1; i++) {
+        /*Draw the lines. The points are converted to absolute coordinates on demand.*/
+        lv_draw_polyline_cb(lv_line_point_cb, &dsc, ext->point_num, clip_area, style, opa_scale);
 
-            p1.x = ext->point_array[i].x + x_ofs;
-            p2.x = ext->point_array[i + 1].x + x_ofs;
-
-            if(ext->y_inv == 0) {
-                p1.y = ext->point_array[i].y + y_ofs;
-                p2.y = ext->point_array[i + 1].y + y_ofs;
-            } else {
-                p1.y = h - ext->point_array[i].y + y_ofs;
-                p2.y = h - ext->point_array[i + 1].y + y_ofs;
-            }
-            lv_draw_line(&p1, &p2, clip_area, style, opa_scale);
-
-            /*Draw circle on the joints if enabled*/
-            if(style->line.rounded) {
-                circle_area.x1 = p1.x - r;
-                circle_area.y1 = p1.y - r;
-                circle_area.x2 = p1.x + r - r_corr;
-                circle_area.y2 = p1.y + r - r_corr ;
+        /*Draw circle on the joints and the ends if enabled*/
+        if(style->line.rounded) {
+            lv_point_t p;
+            for(i = 0; i < ext->point_num; i++) {
+                lv_line_point_cb(&dsc, i, 1, &p);
+                circle_area.x1 = p.x - r;
+                circle_area.y1 = p.y - r;
+                circle_area.x2 = p.x + r - r_corr;
+                circle_area.y2 = p.y + r - r_corr;
                 lv_draw_rect(&circle_area, clip_area, &circle_style_tmp, opa_scale);
             }
         }
-
-        /*Draw circle on the last point too if enabled*/
-        if(style->line.rounded) {
-            circle_area.x1 = p2.x - r;
-            circle_area.y1 = p2.y - r;
-            circle_area.x2 = p2.x + r - r_corr;
-            circle_area.y2 = p2.y + r - r_corr;
-            lv_draw_rect(&circle_area, clip_area, &circle_style_tmp, opa_scale);
-        }
     }
     return LV_DESIGN_RES_OK;
 }
 
+/**
+ * Get points of a line in absolute coordinates. The point callback of `lv_draw_polyline_cb`
+ * @param user_data pointer to an `lv_line_point_dsc_t`
+ * @param id index of the first point
+ * @param cnt number of points to get
+ * @param points store the points here
+ */
+static void lv_line_point_cb(const void * user_data, uint16_t id, uint16_t cnt, lv_point_t * points)
+{
+    const lv_line_point_dsc_t * dsc = user_data;
+    const lv_point_t * src          = &dsc->ext->point_array[id];
+
+    uint16_t k;
+    for(k = 0; k < cnt; k++) {
+        points[k].x = src[k].x + dsc->x_ofs;
+        if(dsc->ext->y_inv == 0) points[k].y = src[k].y + dsc->y_ofs;
+        else points[k].y = dsc->h - src[k].y + dsc->y_ofs;
+    }
+}
+
 /**
  * Signal function of the line
  * @param line pointer to a line object
@@ -273,95 +273,110 @@ uint16_t lv_lmeter_get_angle_offset(lv_obj_t * lmeter)
     return ext->angle_ofs;
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
+/*=====================
+ * Other functions
+ *====================*/
 
 /**
- * Handle the drawing related tasks of the line meters
- * @param lmeter pointer to an object
- * @param clip_area the object will be drawn only in this area
- * @param mode LV_DESIGN_COVER_CHK: only check if the object fully covers the 'mask_p' area
- *                                  (return 'true' if yes)
- *             LV_DESIGN_DRAW: draw the object (always return 'true')
- *             LV_DESIGN_DRAW_POST: drawing after every children are drawn
- * @param return an element of `lv_design_res_t`
+ * Draw the scale lines of a line meter
+ * @param lmeter pointer to a line meter object
+ * @param clip_area the lines will be drawn only in this area
+ * @param style style of the lines (the object's style is not used)
+ * @param line_cnt number of lines to draw
  */
-static lv_design_res_t lv_lmeter_design(lv_obj_t * lmeter, const lv_area_t * clip_area, lv_design_mode_t mode)
+void lv_lmeter_draw_scale(lv_obj_t * lmeter, const lv_area_t * clip_area, const lv_style_t * style, uint16_t line_cnt)
 {
-    /*Return false if the object is not covers the mask_p area*/
-    if(mode == LV_DESIGN_COVER_CHK) {
-        return LV_DESIGN_RES_NOT_COVER;
-    }
-    /*Draw the object*/
-    else if(mode == LV_DESIGN_DRAW_MAIN) {
-        lv_lmeter_ext_t * ext    = lv_obj_get_ext_attr(lmeter);
-        const lv_style_t * style = lv_obj_get_style(lmeter);
-        lv_opa_t opa_scale       = lv_obj_get_opa_scale(lmeter);
-        lv_style_t style_tmp;
-        lv_style_copy(&style_tmp, style);
+    lv_lmeter_ext_t * ext = lv_obj_get_ext_attr(lmeter);
+    lv_opa_t opa_scale    = lv_obj_get_opa_scale(lmeter);
+    lv_style_t style_tmp;
+    lv_style_copy(&style_tmp, style);
 
 #if LV_USE_GROUP
-        lv_group_t * g = lv_obj_get_group(lmeter);
-        if(lv_group_get_focused(g) == lmeter) {
-            style_tmp.line.width += 1;
-        }
+    lv_group_t * g = lv_obj_get_group(lmeter);
+    if(lv_group_get_focused(g) == lmeter) {
+        style_tmp.line.width += 1;
+    }
 #endif
 
-        lv_coord_t r_out = lv_obj_get_width(lmeter) / 2;
-        lv_coord_t r_in  = r_out - style->body.padding.left;
-        if(r_in < 1) r_in = 1;
-
-        lv_coord_t x_ofs  = lv_obj_get_width(lmeter) / 2 + lmeter->coords.x1;
-        lv_coord_t y_ofs  = lv_obj_get_height(lmeter) / 2 + lmeter->coords.y1;
-        int16_t angle_ofs = ext->angle_ofs + 90 + (360 - ext->scale_angle) / 2;
-        int16_t level =
-            (int32_t)((int32_t)(ext->cur_value - ext->min_value) * ext->line_cnt) / (ext->max_value - ext->min_value);
-        uint8_t i;
+    lv_coord_t r_out = lv_obj_get_width(lmeter) / 2;
+    lv_coord_t r_in  = r_out - style->body.padding.left;
+    if(r_in < 1) r_in = 1;
 
-        style_tmp.line.color = style->body.main_color;
+    lv_coord_t x_ofs  = lv_obj_get_width(lmeter) / 2 + lmeter->coords.x1;
+    lv_coord_t y_ofs  = lv_obj_get_height(lmeter) / 2 + lmeter->coords.y1;
+    int16_t angle_ofs = ext->angle_ofs + 90 + (360 - ext->scale_angle) / 2;
+    int16_t level =
+        (int32_t)((int32_t)(ext->cur_value - ext->min_value) * line_cnt) / (ext->max_value - ext->min_value);
+    uint8_t i;
 
-        for(i = 0; i < ext->line_cnt; i++) {
-            /*Calculate the position a scale label*/
-            int16_t angle = (i * ext->scale_angle) / (ext->line_cnt - 1) + angle_ofs;
+    style_tmp.line.color = style->body.main_color;
 
-            lv_coord_t y_out = (int32_t)((int32_t)lv_trigo_sin(angle) * r_out) >> (LV_TRIGO_SHIFT - 8);
-            lv_coord_t x_out = (int32_t)((int32_t)lv_trigo_sin(angle + 90) * r_out) >> (LV_TRIGO_SHIFT - 8);
-            lv_coord_t y_in  = (int32_t)((int32_t)lv_trigo_sin(angle) * r_in) >> (LV_TRIGO_SHIFT - 8);
-            lv_coord_t x_in  = (int32_t)((int32_t)lv_trigo_sin(angle + 90) * r_in) >> (LV_TRIGO_SHIFT - 8);
+    for(i = 0; i < line_cnt; i++) {
+        /*Calculate the position a scale label*/
+        int16_t angle = (i * ext->scale_angle) / (line_cnt - 1) + angle_ofs;
 
-            /*Rounding*/
-            if(x_out <= 0) x_out = (x_out + 127) >> 8;
-            else x_out = (x_out - 127) >> 8;
+        lv_coord_t y_out = (int32_t)((int32_t)lv_trigo_sin(angle) * r_out) >> (LV_TRIGO_SHIFT - 8);
+        lv_coord_t x_out = (int32_t)((int32_t)lv_trigo_sin(angle + 90) * r_out) >> (LV_TRIGO_SHIFT - 8);
+        lv_coord_t y_in  = (int32_t)((int32_t)lv_trigo_sin(angle) * r_in) >> (LV_TRIGO_SHIFT - 8);
+        lv_coord_t x_in  = (int32_t)((int32_t)lv_trigo_sin(angle + 90) * r_in) >> (LV_TRIGO_SHIFT - 8);
 
-            if(x_in <= 0) x_in = (x_in + 127) >> 8;
-            else x_in = (x_in - 127) >> 8;
+        /*Rounding*/
+        if(x_out <= 0) x_out = (x_out + 127) >> 8;
+        else x_out = (x_out - 127) >> 8;
 
-            if(y_out <= 0) y_out = (y_out + 127) >> 8;
-            else y_out = (y_out - 127) >> 8;
+        if(x_in <= 0) x_in = (x_in + 127) >> 8;
+        else x_in = (x_in - 127) >> 8;
 
-            if(y_in <= 0) y_in = (y_in + 127) >> 8;
-            else y_in = (y_in - 127) >> 8;
+        if(y_out <= 0) y_out = (y_out + 127) >> 8;
+        else y_out = (y_out - 127) >> 8;
 
-            lv_point_t p1;
-            lv_point_t p2;
+        if(y_in <= 0) y_in = (y_in + 127) >> 8;
+        else y_in = (y_in - 127) >> 8;
 
-            p2.x = x_in + x_ofs;
-            p2.y = y_in + y_ofs;
+        lv_point_t p1;
+        lv_point_t p2;
 
-            p1.x = x_out + x_ofs;
-            p1.y = y_out + y_ofs;
+        p2.x = x_in + x_ofs;
+        p2.y = y_in + y_ofs;
 
-            if(i >= level)
-                style_tmp.line.color = style->line.color;
-            else {
-                style_tmp.line.color =
-                    lv_color_mix(style->body.grad_color, style->body.main_color, (255 * i) / ext->line_cnt);
-            }
+        p1.x = x_out + x_ofs;
+        p1.y = y_out + y_ofs;
 
-            lv_draw_line(&p1, &p2, clip_area, &style_tmp, opa_scale);
+        if(i >= level)
+            style_tmp.line.color = style->line.color;
+        else {
+            style_tmp.line.color =
+                lv_color_mix(style->body.grad_color, style->body.main_color, (255 * i) / line_cnt);
         }
 
+        lv_draw_line(&p1, &p2, clip_area, &style_tmp, opa_scale);
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Handle the drawing related tasks of the line meters
+ * @param lmeter pointer to an object
+ * @param clip_area the object will be drawn only in this area
+ * @param mode LV_DESIGN_COVER_CHK: only check if the object fully covers the 'mask_p' area
+ *                                  (return 'true' if yes)
+ *             LV_DESIGN_DRAW: draw the object (always return 'true')
+ *             LV_DESIGN_DRAW_POST: drawing after every children are drawn
+ * @param return an element of `lv_design_res_t`
+ */
+static lv_design_res_t lv_lmeter_design(lv_obj_t * lmeter, const lv_area_t * clip_area, lv_design_mode_t mode)
+{
+    /*Return false if the object is not covers the mask_p area*/
+    if(mode == LV_DESIGN_COVER_CHK) {
+        return LV_DESIGN_RES_NOT_COVER;
+    }
+    /*Draw the object*/
+    else if(mode == LV_DESIGN_DRAW_MAIN) {
+        lv_lmeter_ext_t * ext = lv_obj_get_ext_attr(lmeter);
+        lv_lmeter_draw_scale(lmeter, clip_area, lv_obj_get_style(lmeter), ext->line_cnt);
     }
     /*Post draw when the children are drawn*/
     else if(mode == LV_DESIGN_DRAW_POST) {
@@ -162,6 +162,19 @@ static inline const lv_style_t * lv_lmeter_get_style(const lv_obj_t * lmeter, lv
     return lv_obj_get_style(lmeter);
 }
 
+/*=====================
+ * Other functions
+ *====================*/
+
+/**
+ * Draw the scale lines of a line meter
+ * @param lmeter pointer to a line meter object
+ * @param clip_area the lines will be drawn only in this area
+ * @param style style of the lines (the object's style is not used)
+ * @param line_cnt number of lines to draw
+ */
+void lv_lmeter_draw_scale(lv_obj_t * lmeter, const lv_area_t * clip_area, const lv_style_t * style, uint16_t line_cnt);
+
 /**********************
  *      MACROS
  **********************/
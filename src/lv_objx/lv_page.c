@@ -817,6 +817,10 @@ static lv_design_res_t lv_scrl_design(lv_obj_t * scrl, const lv_area_t * clisp_a
         lv_obj_t * page                   = lv_obj_get_parent(scrl);
         const lv_style_t * style_page     = lv_obj_get_style(page);
         lv_group_t * g                    = lv_obj_get_group(page);
+#if LV_USE_PARALLEL_DRAW
+        lv_style_t style_draw;
+        bool style_act = false;
+#endif
         if((style_page->body.opa == LV_OPA_TRANSP) &&
            style_page->body.border.width == 0) { /*Is the background visible?*/
             if(lv_group_get_focused(g) == page) {
@@ -829,14 +833,26 @@ static lv_design_res_t lv_scrl_design(lv_obj_t * scrl, const lv_area_t * clisp_a
                     style_mod                    = lv_group_mod_style(g, style_mod);
                 }
 
+#if LV_USE_PARALLEL_DRAW
+                /*The other drawing threads read `style_p` so set the style only for this thread.
+                 *Copy it because the children's `lv_obj_get_style` can overwrite `style_mod`.*/
+                lv_style_copy(&style_draw, style_mod);
+                lv_obj_set_draw_style(scrl, &style_draw);
+                style_act = true;
+#else
                 scrl->style_p = style_mod; /*Temporally change the style to the activated */
+#endif
             }
         }
 #endif
         ancestor_design(scrl, clisp_area, mode);
 
 #if LV_USE_GROUP
+#if LV_USE_PARALLEL_DRAW
+        if(style_act) lv_obj_set_draw_style(NULL, NULL); /*Revert the style*/
+#else
         scrl->style_p = style_scrl_ori; /*Revert the style*/
+#endif
 #endif
     } else if(mode == LV_DESIGN_DRAW_POST) {
         ancestor_design(scrl, clisp_area, mode);
@@ -0,0 +1,71 @@
+import os
+import sys
+
+lvgldirname = os.path.abspath('../..')
+lvgldirname = os.path.basename(lvgldirname)
+lvgldirname = '"' + lvgldirname + '"'
+
+warnings = '"-Wall"'
+base_defines = '"-DLV_CONF_PATH=' + lvgldirname +'/tests/lv_test_conf.h -DLV_BUILD_TEST"'
+optimization = '"-O3 -g0"'
+
+# Number of frames rendered per scene (can be set as the first argument)
+frame_cnt = sys.argv[1] if len(sys.argv) > 1 else "20"
+
+
+def bench(name, defines):
+  global warnings, base_defines, optimization
+
+  print("=============================")
+  print(name)
+  print("=============================")
+
+  d_all = base_defines[:-1] + " ";
+
+  for d in defines:
+    d_all += " -D" + d + "=" + str(defines[d])
+
+  d_all += '"'
+  cmd = "make -j8 BIN=bench.bin LVGL_DIR_NAME=" + lvgldirname + " DEFINES=" + d_all + " WARNINGS=" + warnings + " OPTIMIZATION=" + optimization
+
+  os.system("make clean LVGL_DIR_NAME=" + lvgldirname + " > /dev/null")
+  os.system("rm -f ./bench.bin")
+  ret = os.system(cmd + " > /dev/null")
+  if(ret != 0):
+    print("BUILD ERROR! (error code  " + str(ret) + ")")
+    exit(1)
+
+  ret = os.system("./bench.bin " + frame_cnt)
+  if(ret != 0):
+    print("RUN ERROR! (error code  " + str(ret) + ")")
+    exit(1)
+
+
+bench_features = {
+  "LV_DPI":100,
+  "LV_MEM_SIZE":256*1024,
+  "LV_MEM_CUSTOM":0,
+  "LV_HOR_RES_MAX":480,
+  "LV_VER_RES_MAX":320,
+  "LV_USE_GROUP":0,
+  "LV_USE_ANIMATION":1,
+  "LV_ANTIALAIS":1,
+  "LV_USE_FILESYSTEM":0,
+  "LV_USE_LOG":0,
+  "LV_USE_DEBUG":0,
+  "LV_FONT_ROBOTO_16":1,
+  "LV_FONT_DEFAULT":"\\\"&lv_font_roboto_16\\\"",
+  "LV_USE_ARC":1,
+  "LV_USE_BTN":1,
+  "LV_USE_CHART":1,
+  "LV_USE_CONT":1,
+  "LV_USE_IMG":1,
+  "LV_USE_LABEL":1,
+}
+
+for depth in [1, 8, 16, 32]:
+  bench_features["LV_COLOR_DEPTH"] = depth
+  bench("Color depth " + str(depth), bench_features)
+
+os.system("make clean LVGL_DIR_NAME=" + lvgldirname + " > /dev/null")
+os.system("rm -f ./bench.bin")
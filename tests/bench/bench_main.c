@@ -0,0 +1,460 @@
+/**
+ * @file bench_main.c
+ * Headless benchmark of the drawing engine.
+ * Renders canonical scenes into an in-memory display and reports the speed and memory usage.
+ * Run `python3 bench.py [frame count]` to build and run it with every color depth.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lvgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if LV_BUILD_TEST
+
+/*********************
+ *      DEFINES
+ *********************/
+#define BENCH_HOR_RES       LV_HOR_RES_MAX
+#define BENCH_VER_RES       LV_VER_RES_MAX
+#define BENCH_BUF_LINES     40      /*Height of the draw buffer*/
+#define BENCH_FRAME_CNT     20      /*Default number of frames per scene*/
+#define BENCH_FRAME_PERIOD  16      /*Simulated time between frames [ms]*/
+
+#define BENCH_IMG_SIZE      100
+#define BENCH_CHART_PT_CNT  10000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    const char * name;
+    void (*create_cb)(lv_obj_t * scr);
+} bench_scene_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void monitor_cb(lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px);
+static void mem_sample(void);
+static uint32_t rnd(void);
+static uint64_t time_ns(void);
+static uint32_t fb_checksum(void);
+static void bench_scene(const bench_scene_t * scene, uint32_t frame_cnt);
+
+static void scene_gradient(lv_obj_t * scr);
+static void scene_buttons(lv_obj_t * scr);
+static void scene_long_label(lv_obj_t * scr);
+static void scene_rotated_img(lv_obj_t * scr);
+static void scene_chart(lv_obj_t * scr);
+static void scene_shadows(lv_obj_t * scr);
+static void scene_arcs(lv_obj_t * scr);
+static void scene_polygons(lv_obj_t * scr);
+static lv_design_res_t polygons_design(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t fb[BENCH_HOR_RES * BENCH_VER_RES];
+static lv_color_t draw_buf[BENCH_HOR_RES * BENCH_BUF_LINES];
+static lv_disp_buf_t disp_buf;
+static lv_disp_t * disp;
+#if LV_USE_DRAW_BACKEND
+static lv_draw_backend_t draw_backend;
+#endif
+
+static uint32_t px_cnt;
+static uint32_t mem_max;
+static uint32_t rnd_seed;
+
+static lv_color_t img_map[BENCH_IMG_SIZE * BENCH_IMG_SIZE];
+static lv_img_dsc_t img_dsc;
+
+static lv_style_t style_grad;
+static lv_style_t style_shadow;
+static lv_style_t style_arc;
+static lv_style_t style_hexagon;
+static lv_style_t style_star;
+
+static const bench_scene_t scenes[] = {
+    {"gradient",    scene_gradient},
+    {"buttons",     scene_buttons},
+    {"long_label",  scene_long_label},
+    {"rotated_img", scene_rotated_img},
+    {"chart",       scene_chart},
+    {"shadows",     scene_shadows},
+    {"arcs",        scene_arcs},
+    {"polygons",    scene_polygons},
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t frame_cnt = BENCH_FRAME_CNT;
+    if(argc > 1) frame_cnt = atoi(argv[1]);
+    if(frame_cnt == 0) frame_cnt = 1;
+
+    lv_init();
+
+    lv_disp_buf_init(&disp_buf, draw_buf, NULL, BENCH_HOR_RES * BENCH_BUF_LINES);
+
+    lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res    = BENCH_HOR_RES;
+    disp_drv.ver_res    = BENCH_VER_RES;
+    disp_drv.buffer     = &disp_buf;
+    disp_drv.flush_cb   = flush_cb;
+    disp_drv.monitor_cb = monitor_cb;
+#if LV_USE_DRAW_BACKEND
+    /*Exercise the command queue with the CPU reference backend*/
+    lv_draw_backend_sw_init(&draw_backend);
+    disp_drv.draw_backend = &draw_backend;
+#endif
+    disp = lv_disp_drv_register(&disp_drv);
+
+    printf("Color depth: %d, resolution: %dx%d, frames per scene: %u\n",
+           LV_COLOR_DEPTH, BENCH_HOR_RES, BENCH_VER_RES, (unsigned int)frame_cnt);
+    printf("%-12s %5s %10s %10s %10s %10s\n", "scene", "depth", "fps", "ns/px", "heap max", "checksum");
+
+    uint32_t i;
+    for(i = 0; i < sizeof(scenes) / sizeof(scenes[0]); i++) {
+        bench_scene(&scenes[i], frame_cnt);
+    }
+
+    return 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Copy the rendered area to the in-memory frame buffer
+ */
+static void flush_cb(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    /*The temporal draw buffers are still allocated here*/
+    mem_sample();
+
+    uint32_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * BENCH_HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    lv_disp_flush_ready(disp_drv);
+}
+
+static void monitor_cb(lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px)
+{
+    (void)disp_drv;
+    (void)time;
+    px_cnt += px;
+}
+
+/**
+ * Save the largest heap usage seen so far
+ */
+static void mem_sample(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    uint32_t used = mon.total_size - mon.free_size;
+    if(used > mem_max) mem_max = used;
+}
+
+/**
+ * Deterministic pseudo random numbers to create the same scenes on every run
+ */
+static uint32_t rnd(void)
+{
+    rnd_seed = rnd_seed * 1103515245 + 12345;
+    return (rnd_seed >> 16) & 0x7FFF;
+}
+
+static uint64_t time_ns(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+
+/**
+ * FNV-1a hash of the frame buffer to notice if a scene is rendered differently
+ */
+static uint32_t fb_checksum(void)
+{
+    const uint8_t * p = (const uint8_t *)fb;
+    uint32_t h = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < sizeof(fb); i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * Create a scene on a new screen, refresh it `frame_cnt` times and print the results
+ * @param scene pointer to a scene descriptor
+ * @param frame_cnt number of frames to render
+ */
+static void bench_scene(const bench_scene_t * scene, uint32_t frame_cnt)
+{
+    lv_obj_t * scr_old = lv_disp_get_scr_act(disp);
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    lv_disp_load_scr(scr);
+    lv_obj_del(scr_old);
+
+    rnd_seed = 1;
+    mem_max  = 0;
+    scene->create_cb(scr);
+    mem_sample();
+
+    /*Render the first frame to do the one-time jobs (e.g. decoding, caching)*/
+    lv_refr_now(disp);
+
+    px_cnt = 0;
+    uint64_t t_start = time_ns();
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        lv_tick_inc(BENCH_FRAME_PERIOD);
+        lv_obj_invalidate(scr);
+        lv_refr_now(disp);
+    }
+    uint64_t t_elaps = time_ns() - t_start;
+    if(t_elaps == 0) t_elaps = 1;
+
+    double fps   = (double)frame_cnt * 1e9 / (double)t_elaps;
+    double ns_px = px_cnt ? (double)t_elaps / px_cnt : 0;
+    printf("%-12s %5d %10.1f %10.2f %10u   %08x\n", scene->name, LV_COLOR_DEPTH, fps, ns_px,
+           (unsigned int)mem_max, (unsigned int)fb_checksum());
+}
+
+/**
+ * A vertical gradient on the whole screen
+ */
+static void scene_gradient(lv_obj_t * scr)
+{
+    lv_style_copy(&style_grad, &lv_style_plain);
+    style_grad.body.main_color = LV_COLOR_MAKE(0x20, 0x40, 0xC0);
+    style_grad.body.grad_color = LV_COLOR_MAKE(0xE0, 0x80, 0x20);
+    style_grad.body.grad_dir   = LV_GRAD_DIR_VER;
+    lv_obj_set_style(scr, &style_grad);
+}
+
+/**
+ * 200 buttons with the default button style
+ */
+static void scene_buttons(lv_obj_t * scr)
+{
+    const uint32_t col_cnt = 20;
+    const uint32_t row_cnt = 10;
+    lv_coord_t w = BENCH_HOR_RES / col_cnt;
+    lv_coord_t h = BENCH_VER_RES / row_cnt;
+
+    uint32_t i;
+    for(i = 0; i < col_cnt * row_cnt; i++) {
+        lv_obj_t * btn = lv_btn_create(scr, NULL);
+        lv_obj_set_size(btn, w - 2, h - 2);
+        lv_obj_set_pos(btn, (i % col_cnt) * w + 1, (i / col_cnt) * h + 1);
+    }
+}
+
+/**
+ * A label with a long wrapped text
+ */
+static void scene_long_label(lv_obj_t * scr)
+{
+    static const char * words[] = {"Lorem", "ipsum", "dolor", "sit", "amet,", "consectetur", "adipiscing", "elit."};
+
+    char * txt = lv_mem_alloc(2048);
+    LV_ASSERT_MEM(txt);
+    if(txt == NULL) return;
+
+    uint32_t len = 0;
+    while(len < 2000) {
+        const char * w = words[rnd() % (sizeof(words) / sizeof(words[0]))];
+        uint32_t w_len = strlen(w);
+        memcpy(&txt[len], w, w_len);
+        len += w_len;
+        txt[len] = ' ';
+        len++;
+    }
+    txt[len] = '\0';
+
+    lv_obj_t * label = lv_label_create(scr, NULL);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_BREAK);
+    lv_obj_set_width(label, BENCH_HOR_RES - 20);
+    lv_obj_set_pos(label, 10, 10);
+    lv_label_set_text(label, txt);
+
+    lv_mem_free(txt);
+}
+
+/**
+ * A true color image rotated by 30 degrees
+ */
+static void scene_rotated_img(lv_obj_t * scr)
+{
+    uint32_t x;
+    uint32_t y;
+    for(y = 0; y < BENCH_IMG_SIZE; y++) {
+        for(x = 0; x < BENCH_IMG_SIZE; x++) {
+            img_map[y * BENCH_IMG_SIZE + x] = ((x / 10 + y / 10) & 1) ? LV_COLOR_MAKE(x * 2, y * 2, 0x80) : LV_COLOR_WHITE;
+        }
+    }
+
+    img_dsc.header.always_zero = 0;
+    img_dsc.header.cf          = LV_IMG_CF_TRUE_COLOR;
+    img_dsc.header.w           = BENCH_IMG_SIZE;
+    img_dsc.header.h           = BENCH_IMG_SIZE;
+    img_dsc.data_size          = sizeof(img_map);
+    img_dsc.data               = (const uint8_t *)img_map;
+
+    lv_obj_t * img = lv_img_create(scr, NULL);
+    lv_img_set_src(img, &img_dsc);
+    lv_img_set_angle(img, 30);
+    lv_obj_align(img, NULL, LV_ALIGN_CENTER, 0, 0);
+}
+
+/**
+ * A line chart with 10k points
+ */
+static void scene_chart(lv_obj_t * scr)
+{
+    lv_obj_t * chart = lv_chart_create(scr, NULL);
+    lv_obj_set_size(chart, BENCH_HOR_RES - 20, BENCH_VER_RES - 20);
+    lv_obj_align(chart, NULL, LV_ALIGN_CENTER, 0, 0);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_point_count(chart, BENCH_CHART_PT_CNT);
+
+    lv_chart_series_t * ser = lv_chart_add_series(chart, LV_COLOR_RED);
+    uint32_t i;
+    for(i = 0; i < BENCH_CHART_PT_CNT; i++) {
+        ser->points[i] = rnd() % 100;
+    }
+    lv_chart_refresh(chart);
+}
+
+/**
+ * Rounded rectangles with large shadows
+ */
+static void scene_shadows(lv_obj_t * scr)
+{
+    lv_style_copy(&style_shadow, &lv_style_pretty_color);
+    style_shadow.body.radius       = 10;
+    style_shadow.body.shadow.width = 24;
+    style_shadow.body.shadow.color = LV_COLOR_BLACK;
+    style_shadow.body.shadow.opa   = LV_OPA_50;
+    style_shadow.body.shadow.offset.x = 4;
+    style_shadow.body.shadow.offset.y = 6;
+
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * obj = lv_obj_create(scr, NULL);
+        lv_obj_set_style(obj, &style_shadow);
+        lv_obj_set_size(obj, BENCH_HOR_RES / 6, BENCH_VER_RES / 5);
+        lv_obj_set_pos(obj, (i % 4) * BENCH_HOR_RES / 4 + 20, (i / 4) * BENCH_VER_RES / 3 + 20);
+    }
+}
+
+/**
+ * Thick arcs with different angles
+ */
+static void scene_arcs(lv_obj_t * scr)
+{
+    lv_style_copy(&style_arc, &lv_style_plain);
+    style_arc.line.color   = LV_COLOR_MAKE(0x20, 0xA0, 0x40);
+    style_arc.line.width   = 10;
+    style_arc.line.rounded = 1;
+
+    lv_coord_t size = LV_MATH_MIN(BENCH_HOR_RES / 4, BENCH_VER_RES / 3) - 10;
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * arc = lv_arc_create(scr, NULL);
+        lv_arc_set_style(arc, LV_ARC_STYLE_MAIN, &style_arc);
+        lv_arc_set_angles(arc, i * 30, (i * 30 + 90 + i * 20) % 360);
+        lv_obj_set_size(arc, size, size);
+        lv_obj_set_pos(arc, (i % 4) * BENCH_HOR_RES / 4 + 5, (i / 4) * BENCH_VER_RES / 3 + 5);
+    }
+}
+
+/**
+ * Hexagons and self-intersecting stars drawn on every refresh
+ */
+static void scene_polygons(lv_obj_t * scr)
+{
+    /*Only the body is drawn so the hexagons are filled by the scanline rasterizer too*/
+    lv_style_copy(&style_hexagon, &lv_style_plain);
+    style_hexagon.body.main_color = LV_COLOR_MAKE(0x20, 0x60, 0xC0);
+    style_hexagon.body.grad_color = LV_COLOR_MAKE(0x80, 0xC0, 0xE0);
+    style_hexagon.body.grad_dir   = LV_GRAD_DIR_VER;
+
+    lv_style_copy(&style_star, &lv_style_plain);
+    style_star.body.main_color = LV_COLOR_MAKE(0xE0, 0x80, 0x20);
+    style_star.body.grad_color = LV_COLOR_MAKE(0xE0, 0x80, 0x20);
+    style_star.body.opa        = LV_OPA_70;
+
+    lv_obj_t * obj = lv_obj_create(scr, NULL);
+    lv_obj_set_size(obj, BENCH_HOR_RES, BENCH_VER_RES);
+    lv_obj_set_design_cb(obj, polygons_design);
+}
+
+/**
+ * Draw 12 hexagons with `lv_draw_polygon` and 12 stars with `lv_draw_polygon_fill_rule` on them
+ */
+static lv_design_res_t polygons_design(lv_obj_t * obj, const lv_area_t * clip_area, lv_design_mode_t mode)
+{
+    if(mode == LV_DESIGN_COVER_CHK) return LV_DESIGN_RES_NOT_COVER;
+    if(mode != LV_DESIGN_DRAW_MAIN) return LV_DESIGN_RES_OK;
+
+    lv_opa_t opa_scale = lv_obj_get_opa_scale(obj);
+    lv_coord_t cell_w = BENCH_HOR_RES / 4;
+    lv_coord_t cell_h = BENCH_VER_RES / 3;
+    lv_coord_t r = LV_MATH_MIN(cell_w, cell_h) / 2 - 5;
+
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_coord_t cx = obj->coords.x1 + (i % 4) * cell_w + cell_w / 2;
+        lv_coord_t cy = obj->coords.y1 + (i / 4) * cell_h + cell_h / 2;
+        int16_t rot = i * 7;
+
+        lv_point_t hexagon[6];
+        uint32_t k;
+        for(k = 0; k < 6; k++) {
+            int16_t angle = (rot + k * 60) % 360;
+            hexagon[k].x = cx + ((r * lv_trigo_sin((angle + 90) % 360)) >> LV_TRIGO_SHIFT);
+            hexagon[k].y = cy + ((r * lv_trigo_sin(angle)) >> LV_TRIGO_SHIFT);
+        }
+        lv_draw_polygon(hexagon, 6, clip_area, &style_hexagon, opa_scale);
+
+        /*A pentagram: its center is inside with the non-zero rule and outside with the even-odd rule*/
+        lv_point_t star[5];
+        for(k = 0; k < 5; k++) {
+            int16_t angle = (rot + 270 + k * 144) % 360;
+            star[k].x = cx + ((r * lv_trigo_sin((angle + 90) % 360)) >> LV_TRIGO_SHIFT);
+            star[k].y = cy + ((r * lv_trigo_sin(angle)) >> LV_TRIGO_SHIFT);
+        }
+        lv_draw_polygon_fill_rule(star, 5, clip_area, &style_star, opa_scale,
+                                  i & 0x1 ? LV_DRAW_FILL_RULE_EVEN_ODD : LV_DRAW_FILL_RULE_NON_ZERO);
+    }
+
+    return LV_DESIGN_RES_OK;
+}
+
+#endif
@@ -1,13 +1,214 @@
 #include "../lvgl.h"
+#include "../src/lv_misc/lv_region.h"
 #include <stdio.h>
+#include <string.h>
 
 #if LV_BUILD_TEST
 
+#define TEST_REGION_W   48
+#define TEST_REGION_H   32
+#define TEST_REGION_MAX 128
+
+/*A custom mask which doesn't set the bounds of its descriptor*/
+typedef struct {
+    lv_draw_mask_common_dsc_t dsc;
+    uint32_t call_cnt;
+} test_custom_mask_param_t;
+
+static lv_draw_mask_res_t test_custom_mask_cb(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
+                                              lv_coord_t len, void * p)
+{
+    (void)abs_x;
+    (void)abs_y;
+    (void)len;
+
+    test_custom_mask_param_t * param = p;
+    param->call_cnt++;
+    mask_buf[0] = LV_OPA_50;
+    return LV_DRAW_MASK_RES_CHANGED;
+}
+
+/**
+ * A zero initialized (not set) bounds shouldn't affect a mask: its callback needs to be called
+ * @return 0: on success; 1: on failure
+ */
+static int test_mask_custom_no_bounds(void)
+{
+    printf("Test a custom mask without bounds...\n");
+
+    test_custom_mask_param_t param;
+    memset(&param, 0, sizeof(param));
+    param.dsc.cb = test_custom_mask_cb;
+
+    int16_t id = lv_draw_mask_add(&param, NULL);
+
+    lv_opa_t buf[10];
+    memset(buf, LV_OPA_COVER, sizeof(buf));
+    lv_draw_mask_res_t res = lv_draw_mask_apply(buf, 100, 100, sizeof(buf));
+
+    lv_draw_mask_remove_id(id);
+
+    if(param.call_cnt != 1 || res != LV_DRAW_MASK_RES_CHANGED || buf[0] != LV_OPA_50 || buf[1] != LV_OPA_COVER) {
+        printf("The custom mask's callback was skipped\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+static uint32_t test_rand(uint32_t * seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return (*seed >> 16) & 0x7FFF;
+}
+
+static void test_region_rand_area(lv_area_t * area, uint32_t * seed)
+{
+    lv_coord_t w = test_rand(seed) % 16;
+    lv_coord_t h = test_rand(seed) % 12;
+    area->x1 = test_rand(seed) % TEST_REGION_W;
+    area->y1 = test_rand(seed) % TEST_REGION_H;
+    area->x2 = LV_MATH_MIN(area->x1 + w, TEST_REGION_W - 1);
+    area->y2 = LV_MATH_MIN(area->y1 + h, TEST_REGION_H - 1);
+}
+
+/**
+ * Set or clear the pixels of an area in a map
+ */
+static void test_region_map_area(uint8_t map[TEST_REGION_H][TEST_REGION_W], const lv_area_t * area, uint8_t v)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        for(x = area->x1; x <= area->x2; x++) map[y][x] = v;
+    }
+}
+
+/**
+ * Compare the pixels covered by a region with a map
+ * @param superset true: the region can cover more pixels than the map
+ * @return 0: the areas are disjoint and cover the pixels of the map; 1: else
+ */
+static int test_region_check(const lv_region_t * reg, uint8_t map[TEST_REGION_H][TEST_REGION_W], bool superset)
+{
+    static uint8_t cover[TEST_REGION_H][TEST_REGION_W];
+    memset(cover, 0, sizeof(cover));
+
+    uint16_t i;
+    for(i = 0; i < reg->cnt; i++) {
+        const lv_area_t * a = &reg->areas[i];
+        lv_coord_t x;
+        lv_coord_t y;
+        for(y = a->y1; y <= a->y2; y++) {
+            for(x = a->x1; x <= a->x2; x++) {
+                if(cover[y][x]) {
+                    printf("The areas of the region overlap\n");
+                    return 1;
+                }
+                cover[y][x] = 1;
+            }
+        }
+    }
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < TEST_REGION_H; y++) {
+        for(x = 0; x < TEST_REGION_W; x++) {
+            if(map[y][x] && !cover[y][x]) {
+                printf("A pixel is missing from the region\n");
+                return 1;
+            }
+            if(!superset && !map[y][x] && cover[y][x]) {
+                printf("The region has an extra pixel\n");
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Compare the result of the region operations with a pixel map
+ * @return 0: on success; 1: on failure
+ */
+static int test_region(void)
+{
+    printf("Test the region operations...\n");
+
+    static lv_area_t buf[TEST_REGION_MAX];
+    static uint8_t map[TEST_REGION_H][TEST_REGION_W];
+    uint32_t seed;
+    for(seed = 1; seed <= 50; seed++) {
+        uint32_t rnd = seed;
+        lv_region_t reg;
+        lv_region_init(&reg, buf, TEST_REGION_MAX);
+        memset(map, 0, sizeof(map));
+
+        lv_area_t a;
+        uint16_t i;
+        for(i = 0; i < 12; i++) {
+            test_region_rand_area(&a, &rnd);
+            if(lv_region_union(&reg, &a) == false) {
+                printf("lv_region_union failed with enough room\n");
+                return 1;
+            }
+            test_region_map_area(map, &a, 1);
+        }
+        if(test_region_check(&reg, map, false)) return 1;
+
+        for(i = 0; i < 4; i++) {
+            test_region_rand_area(&a, &rnd);
+            if(lv_region_subtract(&reg, &a) == false) {
+                printf("lv_region_subtract failed with enough room\n");
+                return 1;
+            }
+            test_region_map_area(map, &a, 0);
+        }
+        if(test_region_check(&reg, map, false)) return 1;
+
+        test_region_rand_area(&a, &rnd);
+        a.x2 = LV_MATH_MIN(a.x2 + 16, TEST_REGION_W - 1);
+        a.y2 = LV_MATH_MIN(a.y2 + 12, TEST_REGION_H - 1);
+        lv_region_intersect(&reg, &a);
+        lv_coord_t x;
+        lv_coord_t y;
+        for(y = 0; y < TEST_REGION_H; y++) {
+            for(x = 0; x < TEST_REGION_W; x++) {
+                if(x < a.x1 || x > a.x2 || y < a.y1 || y > a.y2) map[y][x] = 0;
+            }
+        }
+        if(test_region_check(&reg, map, false)) return 1;
+
+        /*Merging can only add pixels*/
+        lv_region_optimize(&reg, 3, NULL, NULL);
+        if(reg.cnt > 3) {
+            printf("lv_region_optimize left too many areas\n");
+            return 1;
+        }
+        if(test_region_check(&reg, map, true)) return 1;
+
+        /*With a small buffer the areas are joined to make room*/
+        lv_region_init(&reg, buf, 4);
+        memset(map, 0, sizeof(map));
+        for(i = 0; i < 12; i++) {
+            test_region_rand_area(&a, &rnd);
+            if(lv_region_union(&reg, &a)) test_region_map_area(map, &a, 1);
+            if(test_region_check(&reg, map, true)) return 1;
+        }
+    }
+
+    return 0;
+}
+
 int main(void)
 {
     printf("Call lv_init...\n");
     lv_init();
 
+    if(test_mask_custom_no_bounds()) return 1;
+    if(test_region()) return 1;
+
     printf("Exit with success!\n");
     return 0;
 }